@@ -5,6 +5,7 @@
 #define BOX_H
 
 #include "utils.h"
+#include <cmath>
 #include <complex>
 #include <sstream>
 #include <stdexcept>
@@ -317,15 +318,7 @@ public:
     /*! \param vecs Vectors to wrap, updated to the minimum image obeying the periodic settings
      *  \param Nvecs Number of vectors
      */
-    void wrap(vec3<float>* vecs, unsigned int Nvecs) const
-    {
-        util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                vecs[i] = wrap(vecs[i]);
-            }
-        });
-    }
+    void wrap(vec3<float>* vecs, unsigned int Nvecs) const;
 
     //! Unwrap given positions to their absolute location in place
     /*! \param vecs Vectors of coordinates to unwrap
@@ -519,6 +512,123 @@ private:
     bool m_2d;             //!< Specify whether box is 2D.
 };
 
+/*! \name Wrapping policies
+ *  Box::wrap handles every box through fractional coordinates, so each call
+ *  pays for the tilt factor corrections and for fmod. A wrapping policy is a
+ *  small functor built once from a Box whose operator() wraps a vector with
+ *  only the arithmetic needed by one kind of box. Kernels templated on a
+ *  policy are dispatched once per call with getWrapPolicy(), so that their
+ *  inner loops contain no branches on the box shape. Every policy returns
+ *  the same vector as Box::wrap (up to the sign of zero components).
+ */
+//@{
+
+//! Kinds of boxes with a specialized wrapping policy
+enum WrapPolicyType
+{
+    TriclinicWrapPolicy,     //! Any box, see TriclinicWrap.
+    OrthorhombicWrapPolicy,  //! 3D box without tilt, see OrthorhombicWrap.
+    Orthorhombic2DWrapPolicy //! 2D box without xy tilt, see Orthorhombic2DWrap.
+};
+
+//! Return the most specialized wrapping policy valid for a box
+inline WrapPolicyType getWrapPolicy(const Box& box)
+{
+    if (box.getTiltFactorXY() != 0 || box.getTiltFactorXZ() != 0 || box.getTiltFactorYZ() != 0)
+    {
+        return TriclinicWrapPolicy;
+    }
+    return box.is2D() ? Orthorhombic2DWrapPolicy : OrthorhombicWrapPolicy;
+}
+
+//! Wrap vectors into any box with Box::wrap
+class TriclinicWrap
+{
+public:
+    explicit TriclinicWrap(const Box& box) : m_box(box) {}
+
+    vec3<float> operator()(const vec3<float>& v) const
+    {
+        return m_box.wrap(v);
+    }
+
+private:
+    const Box m_box; //!< The box to wrap into.
+};
+
+//! Wrap vectors into a 3D box without tilt factors
+class OrthorhombicWrap
+{
+public:
+    explicit OrthorhombicWrap(const Box& box) : m_lo(box.getL() * -0.5f), m_L(box.getL()) {}
+
+    vec3<float> operator()(const vec3<float>& v) const
+    {
+        // Identical to the fractional coordinate round trip of Box::wrap
+        // once the tilt terms vanish; f - floor(f) is the fmod of Box::wrap
+        // including its correction of negative remainders.
+        vec3<float> f((v.x - m_lo.x) / m_L.x, (v.y - m_lo.y) / m_L.y, (v.z - m_lo.z) / m_L.z);
+        f.x -= std::floor(f.x);
+        f.y -= std::floor(f.y);
+        f.z -= std::floor(f.z);
+        return m_lo + f * m_L;
+    }
+
+private:
+    vec3<float> m_lo; //!< Minimum coordinates of the box.
+    vec3<float> m_L;  //!< Box lengths.
+};
+
+//! Wrap vectors into a 2D box without an xy tilt factor
+class Orthorhombic2DWrap
+{
+public:
+    explicit Orthorhombic2DWrap(const Box& box) : m_lo(box.getL() * -0.5f), m_L(box.getL()) {}
+
+    vec3<float> operator()(const vec3<float>& v) const
+    {
+        vec3<float> f((v.x - m_lo.x) / m_L.x, (v.y - m_lo.y) / m_L.y, 0);
+        f.x -= std::floor(f.x);
+        f.y -= std::floor(f.y);
+        return vec3<float>(m_lo.x + f.x * m_L.x, m_lo.y + f.y * m_L.y, 0);
+    }
+
+private:
+    vec3<float> m_lo; //!< Minimum coordinates of the box.
+    vec3<float> m_L;  //!< Box lengths.
+};
+
+//! Wrap vectors in place with a wrapping policy
+template<typename WrapPolicy> void wrapVectors(const WrapPolicy& wrap, vec3<float>* vecs, unsigned int Nvecs)
+{
+    util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            vecs[i] = wrap(vecs[i]);
+        }
+    });
+}
+
+//@}
+
+/*! The wrapping policy of the box is chosen once for all vectors, which gives
+ *  the same vectors as wrapping each one with Box::wrap.
+ */
+inline void Box::wrap(vec3<float>* vecs, unsigned int Nvecs) const
+{
+    switch (getWrapPolicy(*this))
+    {
+    case OrthorhombicWrapPolicy:
+        wrapVectors(OrthorhombicWrap(*this), vecs, Nvecs);
+        break;
+    case Orthorhombic2DWrapPolicy:
+        wrapVectors(Orthorhombic2DWrap(*this), vecs, Nvecs);
+        break;
+    default:
+        wrapVectors(TriclinicWrap(*this), vecs, Nvecs);
+    }
+}
+
 }; }; // end namespace freud::box
 
 #endif // BOX_H
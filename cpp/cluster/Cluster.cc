@@ -19,6 +19,12 @@ void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::loc
     m_cluster_idx.prepare(num_points);
     DisjointSets dj(num_points);
 
+    // Merging clusters is symmetric, so each pair only needs to be found once.
+    if (freud::locality::canQuerySymmetricHalf(nq, nlist, nq->getPoints(), num_points, qargs))
+    {
+        qargs.symmetric_half = true;
+    }
+
     freud::locality::loopOverNeighbors(
         nq, nq->getPoints(), num_points, qargs, nlist,
         [&dj](const freud::locality::NeighborBond& neighbor_bond) {
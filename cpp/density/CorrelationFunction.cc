@@ -1,6 +1,7 @@
 // Copyright (c) 2010-2019 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <atomic>
 #include <complex>
 #include <stdexcept>
 #include <tbb/tbb.h>
@@ -33,6 +34,7 @@ CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max) : Bo
     axes.push_back(std::make_shared<util::RegularAxis>(bins, 0, r_max));
     m_histogram = util::Histogram<unsigned int>(axes);
     m_local_histograms = util::Histogram<unsigned int>::ThreadLocalHistogram(m_histogram);
+    m_static_axes = util::StaticAxes<util::RegularAxis>(m_histogram);
 
     typename util::Histogram<T>::Axes axes_rdf;
     axes_rdf.push_back(std::make_shared<util::RegularAxis>(bins, 0, r_max));
@@ -44,16 +46,29 @@ CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max) : Bo
 //! helper function to reduce the thread specific arrays into one array
 template<typename T> void CorrelationFunction<T>::reduce()
 {
-    m_histogram.prepare(getAxisSizes()[0]);
-    m_correlation_function.prepare(getAxisSizes()[0]);
+    m_correlation.prepare(getAxisSizes()[0]);
 
     // Reduce the bin counts over all threads, then use them to normalize the
-    // RDF when computing.
-    m_histogram.reduceOverThreads(m_local_histograms);
-    m_correlation_function.reduceOverThreadsPerBin(m_local_correlation_function, [&](size_t i) {
+    // sums of products when computing. Both histograms keep the totals of all
+    // frames, so only the frames accumulated since the last reduction are
+    // folded in.
+    std::atomic<double>* shared_values = m_shared_modified ? m_shared_correlation_function.data() : NULL;
+    reduceHistogramPerBin([](size_t i) {});
+    m_correlation_function.foldOverThreadsPerBin(m_local_correlation_function, [&](size_t i) {
+        if (shared_values != NULL)
+        {
+            T shared_value;
+            double* parts = reinterpret_cast<double*>(&shared_value);
+            for (size_t part = 0; part < NUM_VALUE_PARTS; ++part)
+            {
+                parts[part] = shared_values[i * NUM_VALUE_PARTS + part].exchange(0, std::memory_order_relaxed);
+            }
+            m_correlation_function[i] += shared_value;
+        }
+        m_correlation[i] = m_correlation_function[i];
         if (m_histogram[i])
         {
-            m_correlation_function[i] /= m_histogram[i];
+            m_correlation[i] /= m_histogram[i];
         }
     });
 }
@@ -64,7 +79,32 @@ template<typename T> void CorrelationFunction<T>::reset()
 
     // Zero the correlation function in addition to the bin counts that are
     // reset by the parent.
+    m_correlation_function.reset();
     m_local_correlation_function.reset();
+    for (std::vector<std::atomic<double>>::iterator value = m_shared_correlation_function.begin();
+         value != m_shared_correlation_function.end(); ++value)
+    {
+        value->store(0, std::memory_order_relaxed);
+    }
+}
+
+template<typename T> std::atomic<double>* CorrelationFunction<T>::prepareSharedCorrelationFunction()
+{
+    if (prepareSharedHistogram() == NULL)
+    {
+        return NULL;
+    }
+    const size_t num_values = m_correlation_function.size() * NUM_VALUE_PARTS;
+    if (m_shared_correlation_function.size() != num_values)
+    {
+        m_shared_correlation_function = std::vector<std::atomic<double>>(num_values);
+        for (std::vector<std::atomic<double>>::iterator value = m_shared_correlation_function.begin();
+             value != m_shared_correlation_function.end(); ++value)
+        {
+            value->store(0, std::memory_order_relaxed);
+        }
+    }
+    return m_shared_correlation_function.data();
 }
 
 // Define an overloaded pair of product functions to deal with complex conjugation if necessary.
@@ -78,6 +118,14 @@ inline double product(double x, double y)
     return x * y;
 }
 
+//! Add to a double shared by all threads.
+inline void atomicAdd(std::atomic<double>& target, double value)
+{
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed))
+    {}
+}
+
 template<typename T>
 void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* neighbor_query, const T* values,
                                         const vec3<float>* query_points, const T* query_values,
@@ -85,17 +133,57 @@ void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* ne
                                         const freud::locality::NeighborList* nlist,
                                         freud::locality::QueryArgs qargs)
 {
-    accumulateGeneral(
+    // The sums of products follow the accumulation strategy of the bin counts:
+    // with the shared histogram, the parts of each product are added to the
+    // shared sums atomically.
+    std::atomic<double>* shared_values = prepareSharedCorrelationFunction();
+    std::atomic<unsigned int>* shared_counts = (shared_values != NULL) ? m_shared_bin_counts.data() : NULL;
+    accumulateGeneralBlocks(
         neighbor_query, query_points, n_query_points, nlist, qargs,
-        [=](const freud::locality::NeighborBond& neighbor_bond) {
-            size_t value_bin = m_histogram.bin({neighbor_bond.distance});
-            m_local_histograms.increment(value_bin);
-            m_local_correlation_function.increment(
-                value_bin,
-                product(values[neighbor_bond.point_idx], query_values[neighbor_bond.query_point_idx]));
+        [=](const freud::locality::NeighborBond* first, const freud::locality::NeighborBond* last) {
+            // Look up the histograms once for the whole block.
+            freud::locality::BondHistogramAccumulator histogram = getAccumulator(shared_counts);
+            util::Histogram<T>* local_correlation_function
+                = (shared_values == NULL) ? &m_local_correlation_function.local() : NULL;
+            for (const freud::locality::NeighborBond* neighbor_bond = first; neighbor_bond != last;
+                 ++neighbor_bond)
+            {
+                size_t value_bin = m_static_axes.bin(neighbor_bond->distance);
+                histogram.increment(value_bin);
+                const T value
+                    = product(values[neighbor_bond->point_idx], query_values[neighbor_bond->query_point_idx]);
+                if (local_correlation_function != NULL)
+                {
+                    local_correlation_function->increment(value_bin, value);
+                }
+                else if (value_bin != util::Axis::OVERFLOW_BIN)
+                {
+                    const double* parts = reinterpret_cast<const double*>(&value);
+                    for (size_t part = 0; part < NUM_VALUE_PARTS; ++part)
+                    {
+                        atomicAdd(shared_values[value_bin * NUM_VALUE_PARTS + part], parts[part]);
+                    }
+                }
+            }
         });
 }
 
+template<typename T>
+void CorrelationFunction<T>::accumulateFrames(const std::vector<Frame>& frames,
+                                              const std::vector<T*>& values,
+                                              const std::vector<T*>& query_values,
+                                              freud::locality::QueryArgs qargs)
+{
+    validateFrameData(frames, values, "values");
+    validateFrameData(frames, query_values, "query values");
+    accumulateFramesGeneral(frames, qargs,
+                            [&](size_t frame, const freud::locality::NeighborQuery* neighbor_query,
+                                const freud::locality::NeighborList* nlist) {
+                                accumulate(neighbor_query, values[frame], frames[frame].query_points,
+                                           query_values[frame], frames[frame].n_query_points, nlist, qargs);
+                            });
+}
+
 template class CorrelationFunction<std::complex<double>>;
 template class CorrelationFunction<double>;
 
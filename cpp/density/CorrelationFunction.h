@@ -4,6 +4,9 @@
 #ifndef CORRELATION_FUNCTION_H
 #define CORRELATION_FUNCTION_H
 
+#include <atomic>
+#include <vector>
+
 #include "BondHistogramCompute.h"
 #include "Box.h"
 #include "Histogram.h"
@@ -61,6 +64,13 @@ public:
                     const vec3<float>* query_points, const T* query_values, unsigned int n_query_points,
                     const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
 
+    //! accumulate the correlation function over a sequence of frames
+    /*! One array of values and query values is given per frame (see
+        BondHistogramCompute::accumulateFramesGeneral).
+    */
+    void accumulateFrames(const std::vector<Frame>& frames, const std::vector<T*>& values,
+                          const std::vector<T*>& query_values, freud::locality::QueryArgs qargs);
+
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
     virtual void reduce();
@@ -68,15 +78,28 @@ public:
     //! Get a reference to the last computed correlation function.
     const util::ManagedArray<T>& getCorrelation()
     {
-        return reduceAndReturn(m_correlation_function.getBinCounts());
+        return reduceAndReturn(m_correlation);
     }
 
 private:
     // Typedef thread local histogram type for use in code.
     typedef typename util::Histogram<T>::ThreadLocalHistogram CFThreadHistogram;
 
-    util::Histogram<T> m_correlation_function;      //!< The correlation function
+    //! Number of doubles making up a value of type T.
+    static const size_t NUM_VALUE_PARTS = sizeof(T) / sizeof(double);
+
+    //! Allocate the shared sums of products if the next accumulation counts into the shared histogram.
+    /*! \return The shared sums, or NULL if thread-local copies are used.
+     */
+    std::atomic<double>* prepareSharedCorrelationFunction();
+
+    util::Histogram<T> m_correlation_function;      //!< The sum of the products of values in each bin
     CFThreadHistogram m_local_correlation_function; //!< Thread local copy of the correlation function
+    std::vector<std::atomic<double>> m_shared_correlation_function; //!< Sums of products shared by all
+                                                                     //!< threads, NUM_VALUE_PARTS per bin
+                                                                     //!< (empty unless used).
+    util::ManagedArray<T> m_correlation;            //!< The correlation function
+    util::StaticAxes<util::RegularAxis> m_static_axes; //!< The axis of the histograms, for inlined binning
 };
 
 }; }; // end namespace freud::density
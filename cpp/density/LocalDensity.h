@@ -4,7 +4,10 @@
 #ifndef LOCAL_DENSITY_H
 #define LOCAL_DENSITY_H
 
+#include <memory>
+
 #include "Box.h"
+#include "CompressedNeighborList.h"
 #include "ManagedArray.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
@@ -51,6 +54,10 @@ public:
                  unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                  freud::locality::QueryArgs qargs);
 
+    //! Compute the local density from the bonds of a CompressedNeighborList
+    void compute(const freud::locality::NeighborQuery* neighbor_query, unsigned int n_query_points,
+                 const freud::locality::CompressedNeighborList* nlist);
+
     //! Get a reference to the last computed density
     const util::ManagedArray<float>& getDensity() const
     {
@@ -64,6 +71,9 @@ public:
     }
 
 private:
+    //! Compute the local density of one query point from the iterator over its bonds
+    void computePoint(size_t i, std::shared_ptr<freud::locality::NeighborPerPointIterator> ppiter);
+
     box::Box m_box;   //!< Simulation box where the particles belong
     float m_r_max;    //!< Maximum neighbor distance
     float m_diameter; //!< Diameter of the particles
@@ -1,7 +1,9 @@
 // Copyright (c) 2010-2019 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <atomic>
 #include <stdexcept>
+#include <vector>
 
 #include "RDF.h"
 
@@ -26,6 +28,7 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
     axes.push_back(std::make_shared<util::RegularAxis>(bins, r_min, r_max));
     m_histogram = BondHistogram(axes);
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_static_axes = util::StaticAxes<util::RegularAxis>(m_histogram);
 
     // Precompute the cell volumes to speed up later calculations.
     m_vol_array2D.prepare(bins);
@@ -45,7 +48,6 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
 void RDF::reduce()
 {
     m_pcf.prepare(getAxisSizes()[0]);
-    m_histogram.prepare(getAxisSizes()[0]);
     m_N_r.prepare(getAxisSizes()[0]);
 
     // Define prefactors with appropriate types to simplify and speed later code.
@@ -58,7 +60,7 @@ void RDF::reduce()
     float prefactor = float(1.0) / (np * number_density * m_frame_counter);
 
     util::ManagedArray<float> vol_array = m_box.is2D() ? m_vol_array2D : m_vol_array3D;
-    m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &vol_array](size_t i) {
+    reduceHistogramPerBin([this, &prefactor, &vol_array](size_t i) {
         m_pcf[i] = m_histogram[i] * prefactor / vol_array[i];
     });
 
@@ -76,10 +78,69 @@ void RDF::accumulate(const freud::locality::NeighborQuery* neighbor_query, const
                      unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                      freud::locality::QueryArgs qargs)
 {
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [=](const freud::locality::NeighborBond& neighbor_bond) {
-                          m_local_histograms(neighbor_bond.distance);
-                      });
+    // When computing the RDF of a set of points with itself, each pair only
+    // needs to be found once and can be counted for both of its points.
+    const bool symmetric_half
+        = freud::locality::canQuerySymmetricHalf(neighbor_query, nlist, query_points, n_query_points, qargs);
+    if (symmetric_half)
+    {
+        qargs.symmetric_half = true;
+    }
+
+    // The distances of each block of bonds are binned together and counted
+    // in the histogram selected by the accumulation strategy.
+    std::atomic<unsigned int>* shared_counts = prepareSharedHistogram();
+    accumulateGeneralBlocks(
+        neighbor_query, query_points, n_query_points, nlist, qargs,
+        [=](const freud::locality::NeighborBond* first, const freud::locality::NeighborBond* last) {
+            freud::locality::BondHistogramAccumulator histogram = getAccumulator(shared_counts);
+            accumulateBonds(first, last, symmetric_half, histogram);
+        });
+}
+
+void RDF::accumulate(const freud::locality::NeighborQuery* neighbor_query, unsigned int n_query_points,
+                     const freud::locality::CompressedNeighborList* nlist)
+{
+    std::atomic<unsigned int>* shared_counts = prepareSharedHistogram();
+    accumulateGeneralBlocks(
+        neighbor_query, n_query_points, nlist,
+        [=](const freud::locality::NeighborBond* first, const freud::locality::NeighborBond* last) {
+            freud::locality::BondHistogramAccumulator histogram = getAccumulator(shared_counts);
+            accumulateBonds(first, last, false, histogram);
+        });
+}
+
+void RDF::accumulateBonds(const freud::locality::NeighborBond* first,
+                          const freud::locality::NeighborBond* last, bool symmetric_half,
+                          freud::locality::BondHistogramAccumulator& histogram)
+{
+    std::vector<float> distances;
+    distances.reserve(last - first);
+    for (const freud::locality::NeighborBond* neighbor_bond = first; neighbor_bond != last; ++neighbor_bond)
+    {
+        // In a half query, the bond of a point with itself is only counted once.
+        if (symmetric_half && neighbor_bond->query_point_idx == neighbor_bond->point_idx)
+        {
+            histogram.increment(m_static_axes.bin(neighbor_bond->distance));
+        }
+        else
+        {
+            distances.push_back(neighbor_bond->distance);
+        }
+    }
+    std::vector<unsigned int> bins(distances.size());
+    m_static_axes.binBatch(distances.data(), distances.size(), bins.data());
+    histogram.incrementBatch(bins.data(), bins.size(), symmetric_half ? 2 : 1);
+}
+
+void RDF::accumulateFrames(const std::vector<Frame>& frames, freud::locality::QueryArgs qargs)
+{
+    accumulateFramesGeneral(frames, qargs,
+                            [&](size_t frame, const freud::locality::NeighborQuery* neighbor_query,
+                                const freud::locality::NeighborList* nlist) {
+                                accumulate(neighbor_query, frames[frame].query_points,
+                                           frames[frame].n_query_points, nlist, qargs);
+                            });
 }
 
 }; }; // end namespace freud::density
@@ -31,6 +31,21 @@ public:
                     unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                     freud::locality::QueryArgs qargs);
 
+    //! Compute the RDF from the bonds of a CompressedNeighborList
+    /*! \param neighbor_query NeighborQuery holding the points of the bonds.
+     *  \param n_query_points Number of query points of the bonds.
+     *  \param nlist The CompressedNeighborList holding the bonds.
+     */
+    void accumulate(const freud::locality::NeighborQuery* neighbor_query, unsigned int n_query_points,
+                    const freud::locality::CompressedNeighborList* nlist);
+
+    //! Compute the RDF over a sequence of frames
+    /*! Each frame is accumulated as by accumulate, finding the neighbors of
+     * the next frame while the current frame is binned (see
+     * BondHistogramCompute::accumulateFramesGeneral).
+     */
+    void accumulateFrames(const std::vector<Frame>& frames, freud::locality::QueryArgs qargs);
+
     //! Reduce thread-local arrays onto the primary data arrays.
     virtual void reduce();
 
@@ -51,6 +66,15 @@ public:
     }
 
 private:
+    //! Count the distances of a block of bonds in a histogram.
+    /*! \param symmetric_half Whether the bonds are the symmetric half of a
+     *  query, in which case each bond is counted for both of its points.
+     *  \param histogram The histogram to count into (see getAccumulator).
+     */
+    void accumulateBonds(const freud::locality::NeighborBond* first, const freud::locality::NeighborBond* last,
+                         bool symmetric_half, freud::locality::BondHistogramAccumulator& histogram);
+
+    util::StaticAxes<util::RegularAxis> m_static_axes; //!< The axes of the histogram, for inlined binning
     bool m_normalize;                //!< Whether to enforce that the RDF should tend to 1 (instead of
                                      //!< num_query_points/num_points).
     util::ManagedArray<float> m_pcf; //!< The computed pair correlation function.
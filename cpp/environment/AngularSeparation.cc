@@ -63,7 +63,8 @@ void AngularSeparationNeighbor::compute(const locality::NeighborQuery* nq, const
                                         unsigned int n_equiv_orientations,
                                         const freud::locality::NeighborList* nlist, locality::QueryArgs qargs)
 {
-    // This function requires a NeighborList object, so we always make one and store it locally.
+    // This function requires a NeighborList object, so we always make one and store it locally. The
+    // angles are indexed by its bonds, so the neighbors cannot be streamed.
     m_nlist = locality::makeDefaultNlist(nq, nlist, query_points, n_query_points, qargs);
 
     const size_t tot_num_neigh = m_nlist.getNumBonds();
@@ -45,6 +45,14 @@ public:
                     vec3<float>* query_points, quat<float>* query_orientations, unsigned int n_query_points,
                     const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
 
+    //! Accumulate the bond order over a sequence of frames
+    /*! One array of orientations and query orientations is given per frame
+     * (see BondHistogramCompute::accumulateFramesGeneral).
+     */
+    void accumulateFrames(const std::vector<Frame>& frames, const std::vector<quat<float>*>& orientations,
+                          const std::vector<quat<float>*>& query_orientations,
+                          freud::locality::QueryArgs qargs);
+
     virtual void reduce();
 
     //! Get a reference to the last computed bond order
@@ -56,6 +64,8 @@ public:
     }
 
 private:
+    util::StaticAxes<util::RegularAxis, util::RegularAxis>
+        m_static_axes; //!< The axes of the histogram, for inlined binning
     util::ManagedArray<float> m_bo_array; //!< bond order array computed
     util::ManagedArray<float> m_sa_array; //!< surface area array computed
     BondOrderMode m_mode;                 //!< The mode to calculate with.
@@ -58,7 +58,8 @@ void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<
                                   const quat<float>* equiv_orientations, unsigned int n_equiv_orientations,
                                   const freud::locality::NeighborList* nlist, locality::QueryArgs qargs)
 {
-    // This function requires a NeighborList object, so we always make one and store it locally.
+    // This function requires a NeighborList object, so we always make one and store it locally. The
+    // projections are indexed by its bonds, so the neighbors cannot be streamed.
     m_nlist = locality::makeDefaultNlist(nq, nlist, query_points, n_query_points, qargs);
 
     // Get the maximum total number of bonds in the neighbor list
@@ -67,6 +68,9 @@ void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<
     m_local_bond_proj.prepare({tot_num_neigh, n_proj});
     m_local_bond_proj_norm.prepare({tot_num_neigh, n_proj});
 
+    // Use the bond vectors stored in the neighbor list, if any.
+    const vec3<float>* bond_vectors = m_nlist.hasVectors() ? m_nlist.getVectors().get() : NULL;
+
     // compute the order parameter
     util::forLoopWrapper(0, n_query_points, [=](size_t begin, size_t end) {
         size_t bond(m_nlist.find_first_index(begin));
@@ -77,7 +81,9 @@ void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<
                 const size_t j(m_nlist.getNeighbors()(bond, 1));
 
                 // compute bond vector between the two particles
-                vec3<float> local_bond(bondVector(locality::NeighborBond(i, j), nq, query_points));
+                vec3<float> local_bond((bond_vectors != NULL) ?
+                                           bond_vectors[bond] :
+                                           bondVector(locality::NeighborBond(i, j), nq, query_points));
                 // rotate bond vector into the local frame of particle p
                 local_bond = rotate(conj(orientations[j]), local_bond);
                 // store the length of this local bond
@@ -22,8 +22,10 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
                                unsigned int n_query_points, const quat<float>* orientations,
                                const freud::locality::NeighborList* nlist, locality::QueryArgs qargs)
 {
-    // This function requires a NeighborList object, so we always make one and store it locally.
-    m_nlist = locality::makeDefaultNlist(nq, nlist, query_points, n_query_points, qargs);
+    // This function requires a NeighborList object, so we always make one and store it locally. Each bond
+    // vector may be needed twice, so the vectors are computed once and stored in the list. The list is kept
+    // rather than streamed because the rows of the sph array are indexed by its bonds.
+    m_nlist = locality::makeDefaultNlist(nq, nlist, query_points, n_query_points, qargs, true);
 
     m_sphArray.prepare({m_nlist.getNumBonds(), getSphWidth()});
 
@@ -44,8 +46,7 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
                      bond_copy < m_nlist.getNumBonds() && m_nlist.getNeighbors()(bond_copy, 0) == i;
                      ++bond_copy)
                 {
-                    const size_t j(m_nlist.getNeighbors()(bond_copy, 1));
-                    const vec3<float> r_ij(bondVector(locality::NeighborBond(i, j), nq, query_points));
+                    const vec3<float> r_ij(m_nlist.getVectors()[bond_copy]);
                     const float r_sq(dot(r_ij, r_ij));
 
                     for (size_t ii(0); ii < 3; ++ii)
@@ -94,8 +95,7 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
             for (; bond < m_nlist.getNumBonds() && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
             {
                 const unsigned int sphCount(bond * getSphWidth());
-                const size_t j(m_nlist.getNeighbors()(bond, 1));
-                const vec3<float> r_ij(bondVector(locality::NeighborBond(i, j), nq, query_points));
+                const vec3<float> r_ij(m_nlist.getVectors()[bond]);
                 const float r_sq(dot(r_ij, r_ij));
                 const vec3<float> bond_ij(dot(rotation_0, r_ij), dot(rotation_1, r_ij),
                                           dot(rotation_2, r_ij));
@@ -499,20 +499,19 @@ MatchEnv::~MatchEnv() {}
 EnvironmentCluster::~EnvironmentCluster() {}
 
 Environment MatchEnv::buildEnv(const freud::locality::NeighborQuery* nq,
-                               const freud::locality::NeighborList* nlist, size_t num_bonds, size_t& bond,
-                               unsigned int i, unsigned int env_ind)
+                               const freud::locality::NeighborBond* first,
+                               const freud::locality::NeighborBond* last, unsigned int env_ind)
 {
     Environment ei = Environment();
     // set the environment index equal to the particle index
     ei.env_ind = env_ind;
 
-    for (; bond < num_bonds && nlist->getNeighbors()(bond, 0) == i; ++bond)
+    for (const locality::NeighborBond* nb = first; nb != last; ++nb)
     {
         // compute vec{r} between the two particles
-        const size_t j(nlist->getNeighbors()(bond, 1));
-        if (i != j)
+        if (nb->query_point_idx != nb->point_idx)
         {
-            vec3<float> delta(bondVector(locality::NeighborBond(i, j), nq, nq->getPoints()));
+            vec3<float> delta(bondVector(*nb, nq, nq->getPoints()));
             ei.addVec(delta);
         }
     }
@@ -526,20 +525,15 @@ void EnvironmentCluster::compute(const freud::locality::NeighborQuery* nq,
                                  locality::QueryArgs env_qargs, float threshold, bool registration,
                                  bool global)
 {
-    const locality::NeighborList nlist
-        = locality::makeDefaultNlist(nq, nlist_arg, nq->getPoints(), nq->getNPoints(), qargs);
-    const locality::NeighborList env_nlist
-        = locality::makeDefaultNlist(nq, env_nlist_arg, nq->getPoints(), nq->getNPoints(), env_qargs);
-
     unsigned int Np = nq->getNPoints();
     m_env_index.prepare(Np);
 
     float m_threshold_sq = threshold * threshold;
 
-    nlist.validate(Np, Np);
-    env_nlist.validate(Np, Np);
-    size_t env_bond(0);
-    const size_t env_num_bonds(env_nlist.getNumBonds());
+    if (nlist_arg != NULL)
+    {
+        nlist_arg->validate(Np, Np);
+    }
 
     // create a disjoint set where all particles belong in their own cluster
     EnvDisjointSet dj(Np);
@@ -548,45 +542,58 @@ void EnvironmentCluster::compute(const freud::locality::NeighborQuery* nq,
     // take care, here: set things up s.t. the env_ind of every environment
     // matches its location in the disjoint set.
     // if you don't do this, things will get screwy.
-    for (unsigned int i = 0; i < Np; i++)
-    {
-        Environment ei = buildEnv(nq, &env_nlist, env_num_bonds, env_bond, i, i);
-        dj.s.push_back(ei);
-        dj.m_max_num_neigh = std::max(dj.m_max_num_neigh, ei.num_vecs);
-        ;
-    }
+    // The neighbors are streamed in order, so only one chunk of bonds is
+    // held in memory at a time.
+    locality::streamNeighborChunks(
+        nq, nq->getPoints(), Np, env_qargs, env_nlist_arg,
+        [&](const locality::NeighborChunk& chunk) {
+            for (unsigned int i = chunk.getFirstQueryPoint(); i < chunk.getLastQueryPoint(); i++)
+            {
+                Environment ei = buildEnv(nq, chunk.begin(i), chunk.end(i), i);
+                dj.s.push_back(ei);
+                dj.m_max_num_neigh = std::max(dj.m_max_num_neigh, ei.num_vecs);
+            }
+        },
+        false);
 
     // reallocate the m_point_environments array
     m_point_environments.prepare({Np, dj.m_max_num_neigh});
 
-    size_t bond(0);
-    // loop through points
-    for (unsigned int i = 0; i < Np; i++)
+    if (global == false)
     {
-        if (global == false)
-        {
-            // loop over the neighbors
-            for (; bond < nlist.getNumBonds() && nlist.getNeighbors()(bond, 0) == i; ++bond)
-            {
-                const size_t j(nlist.getNeighbors()(bond, 1));
-                std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-                    = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
-                rotmat3<float> rotation = mapping.first;
-                BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-                // if the mapping between the vectors of the environments
-                // is NOT empty, then the environments are similar, so
-                // merge them.
-                if (!vec_map.empty())
+        // loop through points and their neighbors
+        locality::streamNeighborChunks(
+            nq, nq->getPoints(), Np, qargs, nlist_arg,
+            [&](const locality::NeighborChunk& chunk) {
+                for (unsigned int i = chunk.getFirstQueryPoint(); i < chunk.getLastQueryPoint(); i++)
                 {
-                    // merge the two sets using the disjoint set
-                    unsigned int a = dj.find(i);
-                    unsigned int b = dj.find(j);
-                    if (a != b)
-                        dj.merge(i, j, vec_map, rotation);
+                    for (const locality::NeighborBond* nb = chunk.begin(i); nb != chunk.end(i); ++nb)
+                    {
+                        const size_t j(nb->point_idx);
+                        std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
+                            = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
+                        rotmat3<float> rotation = mapping.first;
+                        BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+                        // if the mapping between the vectors of the environments
+                        // is NOT empty, then the environments are similar, so
+                        // merge them.
+                        if (!vec_map.empty())
+                        {
+                            // merge the two sets using the disjoint set
+                            unsigned int a = dj.find(i);
+                            unsigned int b = dj.find(j);
+                            if (a != b)
+                                dj.merge(i, j, vec_map, rotation);
+                        }
+                    }
                 }
-            }
-        }
-        else
+            },
+            false);
+    }
+    else
+    {
+        // loop through points
+        for (unsigned int i = 0; i < Np; i++)
         {
             // loop over all other particles
             for (unsigned int j = i + 1; j < Np; j++)
@@ -677,14 +684,9 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
                                     const vec3<float>* motif, unsigned int motif_size, float threshold,
                                     bool registration)
 {
-    const locality::NeighborList nlist
-        = locality::makeDefaultNlist(nq, nlist_arg, nq->getPoints(), nq->getNPoints(), qargs);
-
     unsigned int Np = nq->getNPoints();
     float m_threshold_sq = threshold * threshold;
 
-    nlist.validate(Np, Np);
-
     // create a disjoint set where all particles belong in their own cluster.
     // this has to have ONE MORE environment than there are actual particles,
     // because we're inserting the motif into it.
@@ -712,41 +714,43 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
     // add this environment to the set
     dj.s.push_back(e0);
 
-    size_t bond(0);
-    const size_t num_bonds(nlist.getNumBonds());
-
     m_matches.prepare(Np);
 
     // loop through the particles and add their environments to the set
     // take care, here: set things up s.t. the env_ind of every environment
     // matches its location in the disjoint set.
     // if you don't do this, things will get screwy.
-    for (unsigned int i = 0; i < Np; i++)
-    {
-        unsigned int dummy = i + 1;
-        Environment ei = buildEnv(nq, &nlist, num_bonds, bond, i, dummy);
-        dj.s.push_back(ei);
-
-        // if the environment matches e0, merge it into the e0 environment set
-        std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-            = isSimilar(dj.s[0], dj.s[dummy], m_threshold_sq, registration);
-        rotmat3<float> rotation = mapping.first;
-        BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-        // if the mapping between the vectors of the environments is NOT empty,
-        // then the environments are similar.
-        if (!vec_map.empty())
-        {
-            dj.merge(0, dummy, vec_map, rotation);
-            m_matches[i] = true;
-        }
-        // grab the set of vectors that define this individual environment
-        std::vector<vec3<float>> part_vecs = dj.getIndividualEnv(dummy);
+    locality::streamNeighborChunks(
+        nq, nq->getPoints(), Np, qargs, nlist_arg,
+        [&](const locality::NeighborChunk& chunk) {
+            for (unsigned int i = chunk.getFirstQueryPoint(); i < chunk.getLastQueryPoint(); i++)
+            {
+                unsigned int dummy = i + 1;
+                Environment ei = buildEnv(nq, chunk.begin(i), chunk.end(i), dummy);
+                dj.s.push_back(ei);
 
-        for (unsigned int m = 0; m < part_vecs.size(); m++)
-        {
-            m_point_environments(i, m) = part_vecs[m];
-        }
-    }
+                // if the environment matches e0, merge it into the e0 environment set
+                std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
+                    = isSimilar(dj.s[0], dj.s[dummy], m_threshold_sq, registration);
+                rotmat3<float> rotation = mapping.first;
+                BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+                // if the mapping between the vectors of the environments is NOT empty,
+                // then the environments are similar.
+                if (!vec_map.empty())
+                {
+                    dj.merge(0, dummy, vec_map, rotation);
+                    m_matches[i] = true;
+                }
+                // grab the set of vectors that define this individual environment
+                std::vector<vec3<float>> part_vecs = dj.getIndividualEnv(dummy);
+
+                for (unsigned int m = 0; m < part_vecs.size(); m++)
+                {
+                    m_point_environments(i, m) = part_vecs[m];
+                }
+            }
+        },
+        false);
 }
 
 /****************************
@@ -757,9 +761,6 @@ void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
                                        locality::QueryArgs qargs, const vec3<float>* motif,
                                        unsigned int motif_size, bool registration)
 {
-    const locality::NeighborList nlist
-        = locality::makeDefaultNlist(nq, nlist_arg, nq->getPoints(), nq->getNPoints(), qargs);
-
     unsigned int Np = nq->getNPoints();
 
     // create a disjoint set where all particles belong in their own cluster.
@@ -789,47 +790,49 @@ void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
     // add this environment to the set
     dj.s.push_back(e0);
 
-    size_t bond(0);
-    const size_t num_bonds(nlist.getNumBonds());
-
     m_rmsds.prepare(Np);
 
     // loop through the particles and add their environments to the set
     // take care, here: set things up s.t. the env_ind of every environment
     // matches its location in the disjoint set.
     // if you don't do this, things will get screwy.
-    for (unsigned int i = 0; i < Np; i++)
-    {
-        unsigned int dummy = i + 1;
-        Environment ei = buildEnv(nq, &nlist, num_bonds, bond, i, dummy);
-        dj.s.push_back(ei);
-
-        // if the environment matches e0, merge it into the e0 environment set
-        float min_rmsd = -1.0;
-        std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-            = minimizeRMSD(dj.s[0], dj.s[dummy], min_rmsd, registration);
-        rotmat3<float> rotation = mapping.first;
-        BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-        // populate the min_rmsd vector
-        m_rmsds[i] = min_rmsd;
-
-        // if the mapping between the vectors of the environments is NOT
-        // empty, then the environments are similar.
-        // minimizeRMSD should always return a non-empty vec_map, except if
-        // e0 and e1 have different numbers of vectors.
-        if (!vec_map.empty())
-        {
-            dj.merge(0, dummy, vec_map, rotation);
-        }
+    locality::streamNeighborChunks(
+        nq, nq->getPoints(), Np, qargs, nlist_arg,
+        [&](const locality::NeighborChunk& chunk) {
+            for (unsigned int i = chunk.getFirstQueryPoint(); i < chunk.getLastQueryPoint(); i++)
+            {
+                unsigned int dummy = i + 1;
+                Environment ei = buildEnv(nq, chunk.begin(i), chunk.end(i), dummy);
+                dj.s.push_back(ei);
 
-        // grab the set of vectors that define this individual environment
-        std::vector<vec3<float>> part_vecs = dj.getIndividualEnv(dummy);
+                // if the environment matches e0, merge it into the e0 environment set
+                float min_rmsd = -1.0;
+                std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
+                    = minimizeRMSD(dj.s[0], dj.s[dummy], min_rmsd, registration);
+                rotmat3<float> rotation = mapping.first;
+                BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+                // populate the min_rmsd vector
+                m_rmsds[i] = min_rmsd;
 
-        for (unsigned int m = 0; m < part_vecs.size(); m++)
-        {
-            m_point_environments(i, m) = part_vecs[m];
-        }
-    }
+                // if the mapping between the vectors of the environments is NOT
+                // empty, then the environments are similar.
+                // minimizeRMSD should always return a non-empty vec_map, except if
+                // e0 and e1 have different numbers of vectors.
+                if (!vec_map.empty())
+                {
+                    dj.merge(0, dummy, vec_map, rotation);
+                }
+
+                // grab the set of vectors that define this individual environment
+                std::vector<vec3<float>> part_vecs = dj.getIndividualEnv(dummy);
+
+                for (unsigned int m = 0; m < part_vecs.size(); m++)
+                {
+                    m_point_environments(i, m) = part_vecs[m];
+                }
+            }
+        },
+        false);
 }
 
 }; }; // end namespace freud::environment
@@ -204,10 +204,10 @@ public:
 
     ~MatchEnv();
 
-    //! Construct and return a local environment surrounding the particle indexed by i. Set the environment
-    //! index to env_ind.
-    Environment buildEnv(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist,
-                         size_t num_bonds, size_t& bond, unsigned int i, unsigned int env_ind);
+    //! Construct and return the local environment given by the bonds [first, last) of a particle. Set the
+    //! environment index to env_ind.
+    Environment buildEnv(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborBond* first,
+                         const freud::locality::NeighborBond* last, unsigned int env_ind);
 
     //! Returns the entire Np by m_num_neighbors by 3 matrix of all environments for all particles
     const util::ManagedArray<vec3<float>>& getPointEnvironments()
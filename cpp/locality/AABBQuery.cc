@@ -2,14 +2,56 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <limits>
+#include <queue>
 #include <stdexcept>
 
 #include "AABBQuery.h"
+#include "utils.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace freud { namespace locality {
 
-AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points)
-    : NeighborQuery(box, points, n_points)
+namespace {
+
+//! Squared distance from a point to the nearest point of an AABB (zero if the point is inside it)
+inline float distanceSqToAABB(const vec3<float>& p, const AABB& aabb)
+{
+    const vec3<float> lower = aabb.getLower();
+    const vec3<float> upper = aabb.getUpper();
+    const float dx = std::max(std::max(lower.x - p.x, p.x - upper.x), float(0));
+    const float dy = std::max(std::max(lower.y - p.y, p.y - upper.y), float(0));
+    const float dz = std::max(std::max(lower.z - p.z, p.z - upper.z), float(0));
+    return dx * dx + dy * dy + dz * dz;
+}
+
+//! A node of the tree in one periodic image, queued for a best-first search
+struct QueuedNode
+{
+    QueuedNode(float _r_sq, unsigned int _node_idx, unsigned int _image)
+        : r_sq(_r_sq), node_idx(_node_idx), image(_image)
+    {}
+
+    //! Order nodes so that the nearest is at the top of a std::priority_queue
+    bool operator<(const QueuedNode& other) const
+    {
+        return r_sq > other.r_sq;
+    }
+
+    float r_sq;            //!< Squared distance from the query point image to the node AABB
+    unsigned int node_idx; //!< Index of the node
+    unsigned int image;    //!< Index of the periodic image of the query point
+};
+
+}; // end anonymous namespace
+
+const float AABBQuery::DEFAULT_REBUILD_THRESHOLD(1.5);
+
+AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points, bool lbvh)
+    : NeighborQuery(box, points, n_points), m_lbvh(lbvh), m_build_surface_area(0)
 {
     // Allocate memory and create image vectors
     setupTree(m_n_points);
@@ -32,8 +74,7 @@ AABBQuery::querySingle(const vec3<float> query_point, unsigned int query_point_i
     else if (args.mode == QueryArgs::nearest)
     {
         return std::make_shared<AABBQueryIterator>(this, query_point, query_point_idx, args.num_neighbors,
-                                                   args.r_guess, args.r_max, args.r_min, args.scale,
-                                                   args.exclude_ii);
+                                                   args.r_max, args.r_min, args.exclude_ii);
     }
     else
     {
@@ -46,28 +87,270 @@ void AABBQuery::setupTree(unsigned int Np)
     m_aabbs.resize(Np);
 }
 
-void AABBQuery::buildTree(const vec3<float>* points, unsigned int Np)
+void AABBQuery::updateAABBs()
 {
     // Construct a point AABB for each point
-    for (unsigned int i = 0; i < Np; ++i)
+    util::forLoopWrapper(0, m_tree_points.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_aabbs[i] = AABB(m_tree_points[i], static_cast<unsigned int>(i));
+        }
+    });
+}
+
+void AABBQuery::buildTree(const vec3<float>* points, unsigned int Np)
+{
+    m_tree_points.resize(Np);
+    util::forLoopWrapper(0, Np, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            vec3<float> my_pos(points[i]);
+            if (m_box.is2D())
+                my_pos.z = 0;
+            m_tree_points[i] = my_pos;
+        }
+    });
+    updateAABBs();
+
+    // Call the tree build routine, one tree per type
+    if (m_lbvh)
+    {
+        m_aabb_tree.buildTreeLBVH(m_aabbs.data(), Np);
+    }
+    else
     {
-        // Make a point AABB
-        vec3<float> my_pos(points[i]);
-        if (m_box.is2D())
-            my_pos.z = 0;
-        m_aabbs[i] = AABB(my_pos, i);
+        m_aabb_tree.buildTree(m_aabbs.data(), Np);
     }
+    m_build_surface_area = m_aabb_tree.getSurfaceArea();
 
-    // Call the tree build routine, one tree per type
-    m_aabb_tree.buildTree(m_aabbs.data(), Np);
+    updateNodeMaxTags();
+    updateLeafSlots();
+    updateLeafPositions();
+}
+
+bool AABBQuery::updatePoints(const vec3<float>* points, unsigned int n_points, float rebuild_threshold)
+{
+    if (n_points != m_n_points)
+    {
+        throw std::invalid_argument("The number of points cannot change when updating an AABBQuery.");
+    }
+    if (m_box.is2D())
+    {
+        for (unsigned int i(0); i < n_points; i++)
+        {
+            if (std::abs(points[i].z) > 1e-6)
+            {
+                throw std::invalid_argument("A point with z != 0 was provided in a 2D box.");
+            }
+        }
+    }
+    m_points = points;
+    updateVersion();
+
+    // Move each point in the tree by its minimum image displacement rather
+    // than to its new position, so that points crossing a periodic boundary
+    // do not stretch their leaves across the box. Since all image vectors
+    // within one box length are queried, this is valid as long as the points
+    // in the tree stay within a quarter of a box length of the box.
+    const vec3<bool> periodic = m_box.getPeriodic();
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            vec3<float> my_pos(points[i]);
+            if (m_box.is2D())
+                my_pos.z = 0;
+            const vec3<float> tree_pos = m_tree_points[i] + m_box.wrap(my_pos - m_tree_points[i]);
+            const vec3<float> frac = m_box.makeFractional(tree_pos);
+            if ((periodic.x && (frac.x < float(-0.25) || frac.x >= float(1.25)))
+                || (periodic.y && (frac.y < float(-0.25) || frac.y >= float(1.25)))
+                || (!m_box.is2D() && periodic.z && (frac.z < float(-0.25) || frac.z >= float(1.25))))
+            {
+                m_tree_points[i] = my_pos;
+            }
+            else
+            {
+                m_tree_points[i] = tree_pos;
+            }
+        }
+    });
+
+    // The particle tags are unchanged by refitting, so m_node_max_tags
+    // remains valid.
+    updateAABBs();
+    const float surface_area = m_aabb_tree.refit(m_aabbs.data());
+    if (surface_area > rebuild_threshold * m_build_surface_area)
+    {
+        buildTree(m_points, m_n_points);
+        return true;
+    }
+    updateLeafPositions();
+    return false;
+}
+
+void AABBQuery::updateLeafSlots()
+{
+    const unsigned int num_nodes = m_aabb_tree.getNumNodes();
+    m_leaf_slots.assign(num_nodes, 0);
+    unsigned int num_leaves = 0;
+    for (unsigned int node_idx = 0; node_idx < num_nodes; ++node_idx)
+    {
+        if (m_aabb_tree.isNodeLeaf(node_idx))
+        {
+            m_leaf_slots[node_idx] = num_leaves++;
+        }
+    }
+
+    // Unused slots are padded with infinite coordinates so they are never
+    // within range of any point.
+    const float inf = std::numeric_limits<float>::infinity();
+    m_leaf_x.assign(num_leaves * NODE_CAPACITY, inf);
+    m_leaf_y.assign(num_leaves * NODE_CAPACITY, inf);
+    m_leaf_z.assign(num_leaves * NODE_CAPACITY, inf);
+}
+
+void AABBQuery::updateLeafPositions()
+{
+    util::forLoopWrapper(0, m_aabb_tree.getNumNodes(), [&](size_t begin, size_t end) {
+        for (size_t node_idx = begin; node_idx < end; ++node_idx)
+        {
+            const AABBNode& node = m_aabb_tree.getNode(node_idx);
+            if (node.left != INVALID_NODE)
+            {
+                continue;
+            }
+            const unsigned int offset = m_leaf_slots[node_idx] * NODE_CAPACITY;
+            for (unsigned int k = 0; k < node.num_particles; ++k)
+            {
+                const vec3<float>& pos = m_tree_points[node.particle_tags[k]];
+                m_leaf_x[offset + k] = pos.x;
+                m_leaf_y[offset + k] = pos.y;
+                m_leaf_z[offset + k] = pos.z;
+            }
+        }
+    });
+}
+
+unsigned int AABBQuery::findLeafNeighbors(unsigned int node_idx, const vec3<float>& position, float r_max_sq,
+                                          float r_min_sq, unsigned int* hit_slots, float* hit_r_sq) const
+{
+    const unsigned int offset = m_leaf_slots[node_idx] * NODE_CAPACITY;
+    const float* x = m_leaf_x.data() + offset;
+    const float* y = m_leaf_y.data() + offset;
+    const float* z = m_leaf_z.data() + offset;
+    unsigned int num_hits = 0;
+
+    // The squared distances are accumulated in the same order as dot() so
+    // that all code paths give identical results.
+#if defined(__AVX512F__)
+    static_assert(NODE_CAPACITY % 16 == 0, "NODE_CAPACITY must be a multiple of the AVX-512 width.");
+    const __m512 px = _mm512_set1_ps(position.x);
+    const __m512 py = _mm512_set1_ps(position.y);
+    const __m512 pz = _mm512_set1_ps(position.z);
+    const __m512 max_sq = _mm512_set1_ps(r_max_sq);
+    const __m512 min_sq = _mm512_set1_ps(r_min_sq);
+    const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    for (unsigned int k = 0; k < NODE_CAPACITY; k += 16)
+    {
+        const __m512 dx = _mm512_sub_ps(_mm512_loadu_ps(x + k), px);
+        const __m512 dy = _mm512_sub_ps(_mm512_loadu_ps(y + k), py);
+        const __m512 dz = _mm512_sub_ps(_mm512_loadu_ps(z + k), pz);
+        const __m512 r_sq = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)),
+                                          _mm512_mul_ps(dz, dz));
+        const __mmask16 mask = _mm512_mask_cmp_ps_mask(_mm512_cmp_ps_mask(r_sq, max_sq, _CMP_LT_OQ), r_sq,
+                                                       min_sq, _CMP_GE_OQ);
+        _mm512_mask_compressstoreu_ps(hit_r_sq + num_hits, mask, r_sq);
+        _mm512_mask_compressstoreu_epi32(hit_slots + num_hits, mask,
+                                         _mm512_add_epi32(lanes, _mm512_set1_epi32(k)));
+        num_hits += _mm_popcnt_u32(mask);
+    }
+#elif defined(__AVX2__)
+    static_assert(NODE_CAPACITY % 8 == 0, "NODE_CAPACITY must be a multiple of the AVX2 width.");
+    const __m256 px = _mm256_set1_ps(position.x);
+    const __m256 py = _mm256_set1_ps(position.y);
+    const __m256 pz = _mm256_set1_ps(position.z);
+    const __m256 max_sq = _mm256_set1_ps(r_max_sq);
+    const __m256 min_sq = _mm256_set1_ps(r_min_sq);
+    float r_sq_lanes[8];
+    for (unsigned int k = 0; k < NODE_CAPACITY; k += 8)
+    {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + k), px);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + k), py);
+        const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + k), pz);
+        const __m256 r_sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                          _mm256_mul_ps(dz, dz));
+        unsigned int mask = _mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(r_sq, max_sq, _CMP_LT_OQ),
+                                                             _mm256_cmp_ps(r_sq, min_sq, _CMP_GE_OQ)));
+        if (mask == 0)
+        {
+            continue;
+        }
+        _mm256_storeu_ps(r_sq_lanes, r_sq);
+        for (unsigned int lane = 0; mask != 0; ++lane, mask >>= 1)
+        {
+            if (mask & 1)
+            {
+                hit_slots[num_hits] = k + lane;
+                hit_r_sq[num_hits] = r_sq_lanes[lane];
+                ++num_hits;
+            }
+        }
+    }
+#else
+    const unsigned int num_particles = m_aabb_tree.getNodeNumParticles(node_idx);
+    for (unsigned int k = 0; k < num_particles; ++k)
+    {
+        const float dx = x[k] - position.x;
+        const float dy = y[k] - position.y;
+        const float dz = z[k] - position.z;
+        const float r_sq = dx * dx + dy * dy + dz * dz;
+        if (r_sq < r_max_sq && r_sq >= r_min_sq)
+        {
+            hit_slots[num_hits] = k;
+            hit_r_sq[num_hits] = r_sq;
+            ++num_hits;
+        }
+    }
+#endif
+    return num_hits;
+}
+
+void AABBQuery::updateNodeMaxTags()
+{
+    // Children are always stored after their parents, so a reverse pass over
+    // the nodes visits all children before their parents.
+    const unsigned int num_nodes = m_aabb_tree.getNumNodes();
+    m_node_max_tags.resize(num_nodes);
+    for (unsigned int node_idx = num_nodes; node_idx-- > 0;)
+    {
+        const AABBNode& node = m_aabb_tree.getNode(node_idx);
+        unsigned int max_tag = 0;
+        if (node.left == INVALID_NODE)
+        {
+            for (unsigned int p = 0; p < node.num_particles; ++p)
+            {
+                max_tag = std::max(max_tag, node.particle_tags[p]);
+            }
+        }
+        else
+        {
+            max_tag = std::max(m_node_max_tags[node.left], m_node_max_tags[node.right]);
+        }
+        m_node_max_tags[node_idx] = max_tag;
+    }
 }
 
 void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
 {
-    box::Box box = m_neighbor_query->getBox();
+    m_n_images = m_aabb_query->getImageVectors(r_max, _check_r_max, m_image_list);
+}
+
+unsigned int AABBQuery::getImageVectors(float r_max, bool check_r_max,
+                                        std::vector<vec3<float>>& image_list) const
+{
+    const box::Box& box = m_box;
     vec3<float> nearest_plane_distance = box.getNearestPlaneDistance();
     vec3<bool> periodic = box.getPeriodic();
-    if (_check_r_max)
+    if (check_r_max)
     {
         if ((periodic.x && nearest_plane_distance.x <= r_max * 2.0)
             || (periodic.y && nearest_plane_distance.y <= r_max * 2.0)
@@ -80,16 +363,16 @@ void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
     // Now compute the image vectors
     // Each dimension increases by one power of 3
     unsigned int n_dim_periodic = (unsigned int) (periodic.x + periodic.y + (!box.is2D()) * periodic.z);
-    m_n_images = 1;
+    unsigned int total_images = 1;
     for (unsigned int dim = 0; dim < n_dim_periodic; ++dim)
     {
-        m_n_images *= 3;
+        total_images *= 3;
     }
 
     // Reallocate memory if necessary
-    if (m_n_images > m_image_list.size())
+    if (total_images > image_list.size())
     {
-        m_image_list.resize(m_n_images);
+        image_list.resize(total_images);
     }
 
     vec3<float> latt_a = vec3<float>(box.getLatticeVector(0));
@@ -101,15 +384,15 @@ void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
     }
 
     // There is always at least 1 image, which we put as our first thing to look at
-    m_image_list[0] = vec3<float>(0.0, 0.0, 0.0);
+    image_list[0] = vec3<float>(0.0, 0.0, 0.0);
 
     // Iterate over all other combinations of images
     unsigned int n_images = 1;
-    for (int i = -1; i <= 1 && n_images < m_n_images; ++i)
+    for (int i = -1; i <= 1 && n_images < total_images; ++i)
     {
-        for (int j = -1; j <= 1 && n_images < m_n_images; ++j)
+        for (int j = -1; j <= 1 && n_images < total_images; ++j)
         {
-            for (int k = -1; k <= 1 && n_images < m_n_images; ++k)
+            for (int k = -1; k <= 1 && n_images < total_images; ++k)
             {
                 if (!(i == 0 && j == 0 && k == 0))
                 {
@@ -121,12 +404,81 @@ void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
                     if (k != 0 && (box.is2D() || !periodic.z))
                         continue;
 
-                    m_image_list[n_images] = float(i) * latt_a + float(j) * latt_b + float(k) * latt_c;
+                    image_list[n_images] = float(i) * latt_a + float(j) * latt_b + float(k) * latt_c;
                     ++n_images;
                 }
             }
         }
     }
+    return total_images;
+}
+
+void AABBQuery::queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                          QueryArgs args, std::vector<NeighborBond>& bonds) const
+{
+    this->validateQueryArgs(args);
+    if (args.mode != QueryArgs::ball)
+    {
+        NeighborQuery::queryBulk(query_points, begin, end, args, bonds);
+        return;
+    }
+
+    const float r_max_sq = args.r_max * args.r_max;
+    const float r_min_sq = args.r_min * args.r_min;
+    const bool is2D = m_box.is2D();
+    const unsigned int num_nodes = m_aabb_tree.getNumNodes();
+
+    // The image vectors only depend on the cutoff, so they are shared by all
+    // query points in the range.
+    std::vector<vec3<float>> image_list;
+    const unsigned int n_images = getImageVectors(args.r_max, true, image_list);
+    unsigned int hit_slots[NODE_CAPACITY];
+    float hit_r_sq[NODE_CAPACITY];
+
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        vec3<float> pos_i(query_points[i]);
+        if (is2D)
+        {
+            pos_i.z = 0;
+        }
+
+        for (unsigned int cur_image = 0; cur_image < n_images; ++cur_image)
+        {
+            const vec3<float> pos_i_image = pos_i + image_list[cur_image];
+            const AABBSphere asphere(pos_i_image, args.r_max);
+
+            // Stackless traversal of the tree
+            for (unsigned int cur_node_idx = 0; cur_node_idx < num_nodes; ++cur_node_idx)
+            {
+                const AABBNode& node = m_aabb_tree.getNode(cur_node_idx);
+                // For half queries, subtrees only containing particles with
+                // j < i can be skipped entirely.
+                if (!overlap(node.aabb, asphere)
+                    || (args.symmetric_half && m_node_max_tags[cur_node_idx] < i))
+                {
+                    cur_node_idx += node.skip;
+                    continue;
+                }
+                if (node.left != INVALID_NODE)
+                {
+                    continue;
+                }
+
+                const unsigned int num_hits
+                    = findLeafNeighbors(cur_node_idx, pos_i_image, r_max_sq, r_min_sq, hit_slots, hit_r_sq);
+                for (unsigned int hit = 0; hit < num_hits; ++hit)
+                {
+                    const unsigned int j = node.particle_tags[hit_slots[hit]];
+                    if ((args.exclude_ii && i == j) || (args.symmetric_half && j < i))
+                    {
+                        continue;
+                    }
+                    bonds.emplace_back(i, j, std::sqrt(hit_r_sq[hit]));
+                }
+            }
+        }
+    }
 }
 
 NeighborBond AABBQueryBallIterator::next()
@@ -151,50 +503,45 @@ NeighborBond AABBQueryBallIterator::next()
         // Stackless traversal of the tree
         while (cur_node_idx < m_aabb_query->m_aabb_tree.getNumNodes())
         {
-            if (overlap(m_aabb_query->m_aabb_tree.getNodeAABB(cur_node_idx), asphere))
+            if (!m_leaf_searched)
             {
-                if (m_aabb_query->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                if (!overlap(m_aabb_query->m_aabb_tree.getNodeAABB(cur_node_idx), asphere))
                 {
-                    while (cur_ref_p < m_aabb_query->m_aabb_tree.getNodeNumParticles(cur_node_idx))
-                    {
-                        // Neighbor j
-                        const unsigned int j
-                            = m_aabb_query->m_aabb_tree.getNodeParticleTag(cur_node_idx, cur_ref_p);
-                        // Increment before possible return.
-                        cur_ref_p++;
-
-                        // Skip ii matches immediately if requested.
-                        if (m_exclude_ii && m_query_point_idx == j)
-                        {
-                            continue;
-                        }
-
-                        // Read in the position of j
-                        vec3<float> pos_j((*m_neighbor_query)[j]);
-                        if (m_neighbor_query->getBox().is2D())
-                        {
-                            pos_j.z = 0;
-                        }
-
-                        // Compute distance
-                        const vec3<float> r_ij = pos_j - pos_i_image;
-                        const float r_sq = dot(r_ij, r_ij);
-
-                        // Check ii exclusion before including the pair.
-                        if (r_sq < r_max_sq && r_sq >= r_min_sq)
-                        {
-                            return NeighborBond(m_query_point_idx, j, sqrt(r_sq));
-                        }
-                    }
+                    // Skip ahead
+                    cur_node_idx += m_aabb_query->m_aabb_tree.getNodeSkip(cur_node_idx) + 1;
+                    continue;
                 }
+                if (!m_aabb_query->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                {
+                    cur_node_idx++;
+                    continue;
+                }
+
+                // Find all neighbors in this leaf at once, then return them
+                // one at a time.
+                m_num_leaf_hits = m_aabb_query->findLeafNeighbors(
+                    cur_node_idx, pos_i_image, r_max_sq, r_min_sq, m_leaf_hit_slots, m_leaf_hit_r_sq);
+                m_leaf_searched = true;
+                cur_ref_p = 0;
             }
-            else
+
+            while (cur_ref_p < m_num_leaf_hits)
             {
-                // Skip ahead
-                cur_node_idx += m_aabb_query->m_aabb_tree.getNodeSkip(cur_node_idx);
+                // Neighbor j
+                const unsigned int j = m_aabb_query->m_aabb_tree.getNode(cur_node_idx)
+                                           .particle_tags[m_leaf_hit_slots[cur_ref_p]];
+                const float r_sq = m_leaf_hit_r_sq[cur_ref_p];
+                // Increment before possible return.
+                cur_ref_p++;
+
+                // Skip ii matches if requested.
+                if (!(m_exclude_ii && m_query_point_idx == j))
+                {
+                    return NeighborBond(m_query_point_idx, j, sqrt(r_sq));
+                }
             }
+            m_leaf_searched = false;
             cur_node_idx++;
-            cur_ref_p = 0;
         } // end stackless search
         cur_image++;
         cur_node_idx = 0;
@@ -204,122 +551,102 @@ NeighborBond AABBQueryBallIterator::next()
     return NeighborQueryIterator::ITERATOR_TERMINATOR;
 }
 
-NeighborBond AABBQueryIterator::next()
+void AABBQueryIterator::findNeighbors()
 {
-    vec3<float> plane_distance = m_neighbor_query->getBox().getNearestPlaneDistance();
-    float min_plane_distance = std::min(plane_distance.x, plane_distance.y);
-    float max_plane_distance = std::max(plane_distance.x, plane_distance.y);
-    if (!m_neighbor_query->getBox().is2D())
+    const AABBTree& tree = m_aabb_query->m_aabb_tree;
+    if (m_num_neighbors == 0 || tree.getNumNodes() == 0)
     {
-        min_plane_distance = std::min(min_plane_distance, plane_distance.z);
-        max_plane_distance = std::max(max_plane_distance, plane_distance.z);
+        return;
     }
 
-    // This iterator is not truly lazy; because it needs to get possible
-    // neighbors and sort them to find the actual ones, it computes and caches
-    // them and then returns them one-by-one. This check ensures that we only
-    // search for new neighbors the first time next is called.
-    if (!m_current_neighbors.size())
+    const box::Box& box = m_neighbor_query->getBox();
+    vec3<float> pos_i(m_query_point);
+    if (box.is2D())
     {
-        // Continually perform ball queries until the termination conditions are met.
-        while (true)
-        {
-            // Perform a ball query to get neighbors. To ensure that we allow
-            // ball queries to exceed their normal boundaries, we pass false as
-            // the _check_r_max. We also can't depend on the ball query for
-            // r_min filtering because we're querying beyond the normally safe
-            // bounds, so we have to do it in this class.
-            m_current_neighbors.clear();
-            m_all_distances.clear();
-            m_query_points_below_r_min.clear();
-            std::shared_ptr<NeighborQueryPerPointIterator> ball_it = std::make_shared<AABBQueryBallIterator>(
-                static_cast<const AABBQuery*>(m_neighbor_query), m_query_point, m_query_point_idx,
-                std::min(m_r_cur, m_r_max), 0, m_exclude_ii, false);
-            while (!ball_it->end())
-            {
-                NeighborBond nb = ball_it->next();
-                if (nb == NeighborQueryIterator::ITERATOR_TERMINATOR)
-                    continue;
+        pos_i.z = 0;
+    }
 
-                if (!m_exclude_ii || m_query_point_idx != nb.point_idx)
-                {
-                    nb.query_point_idx = m_query_point_idx;
-                    // If we've expanded our search radius beyond safe
-                    // distance, use the map instead of the vector.
-                    if (m_search_extended)
-                    {
-                        if (!m_all_distances.count(nb.point_idx)
-                            || m_all_distances[nb.point_idx] > nb.distance)
-                        {
-                            m_all_distances[nb.point_idx] = nb.distance;
-                            if (nb.distance < m_r_min)
-                            {
-                                m_query_points_below_r_min.insert(nb.point_idx);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if (nb.distance >= m_r_min)
-                            m_current_neighbors.emplace_back(nb);
-                    }
-                }
-            }
+    // Candidates closer than half of the smallest periodic plane distance
+    // are always the minimum image of their point (see NearestNeighborHeap).
+    const vec3<float> plane_distance = box.getNearestPlaneDistance();
+    const vec3<bool> periodic = box.getPeriodic();
+    float min_plane_distance = std::numeric_limits<float>::infinity();
+    if (periodic.x)
+        min_plane_distance = std::min(min_plane_distance, plane_distance.x);
+    if (periodic.y)
+        min_plane_distance = std::min(min_plane_distance, plane_distance.y);
+    if (!box.is2D() && periodic.z)
+        min_plane_distance = std::min(min_plane_distance, plane_distance.z);
+    NearestNeighborHeap heap(m_query_point_idx, m_num_neighbors, m_r_min,
+                             min_plane_distance * min_plane_distance / float(4.0));
+    const float r_max_sq = m_r_max * m_r_max;
 
-            // Break if there are enough neighbors, or if we are querying beyond the limits of
-            // the periodic box.
-            m_r_cur *= m_scale;
+    std::priority_queue<QueuedNode> queue;
+    for (unsigned int image = 0; image < m_n_images; ++image)
+    {
+        const float r_sq = distanceSqToAABB(pos_i + m_image_list[image], tree.getNodeAABB(0));
+        if (r_sq < r_max_sq)
+        {
+            queue.push(QueuedNode(r_sq, 0, image));
+        }
+    }
 
-            if (m_current_neighbors.size() >= m_num_neighbors)
-            {
-                std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
-                break;
-            }
-            else if ((m_r_cur >= m_r_max) || (m_r_cur >= max_plane_distance)
-                     || ((m_all_distances.size() - m_query_points_below_r_min.size()) >= m_num_neighbors))
+    unsigned int hit_slots[NODE_CAPACITY];
+    float hit_r_sq[NODE_CAPACITY];
+    while (!queue.empty())
+    {
+        const QueuedNode cur = queue.top();
+        // Stop once no unvisited node can contain a closer candidate.
+        if (heap.full() && cur.r_sq > heap.getMaxDistanceSq())
+        {
+            break;
+        }
+        queue.pop();
+
+        const vec3<float> pos_i_image = pos_i + m_image_list[cur.image];
+        const AABBNode& node = tree.getNode(cur.node_idx);
+        if (node.left != INVALID_NODE)
+        {
+            const unsigned int children[2] = {node.left, node.right};
+            for (unsigned int c = 0; c < 2; ++c)
             {
-                // Once this condition is reached, either we found enough
-                // neighbors beyond the normal min_plane_distance
-                // condition or we conclude that there are not enough
-                // neighbors left in the system.
-                for (std::map<unsigned int, float>::const_iterator it(m_all_distances.begin());
-                     it != m_all_distances.end(); it++)
+                const float r_sq = distanceSqToAABB(pos_i_image, tree.getNodeAABB(children[c]));
+                if (r_sq < r_max_sq)
                 {
-                    if (it->second >= m_r_min)
-                    {
-                        m_current_neighbors.emplace_back(m_query_point_idx, it->first, it->second);
-                    }
+                    queue.push(QueuedNode(r_sq, children[c], cur.image));
                 }
-                std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
-                break;
             }
-            else if (m_r_cur > min_plane_distance / 2)
+            continue;
+        }
+
+        const unsigned int num_hits
+            = m_aabb_query->findLeafNeighbors(cur.node_idx, pos_i_image, r_max_sq, 0, hit_slots, hit_r_sq);
+        for (unsigned int hit = 0; hit < num_hits; ++hit)
+        {
+            const unsigned int j = node.particle_tags[hit_slots[hit]];
+            if (!(m_exclude_ii && m_query_point_idx == j))
             {
-                // If we have to go beyond the cutoff radius, we need to
-                // start tracking what particles are already in the set so
-                // that we can make sure that we find the closest image
-                // because we now run the risk of finding duplicates.
-                //
-                // We could make this marginally more efficient by checking
-                // whether we've exactly hit the limit, or if there's a
-                // rescaling that would let us try the exact limit once
-                // before going beyond the min plane distance.
-                m_search_extended = true;
+                heap.add(j, hit_r_sq[hit]);
             }
         }
     }
 
-    // Now we return all the points found for the current point, stopping when
-    // any are beyond the maximum distance allowed.
-    while ((m_count < m_num_neighbors) && (m_count < m_current_neighbors.size()))
+    heap.finish(m_current_neighbors);
+}
+
+NeighborBond AABBQueryIterator::next()
+{
+    // This iterator is not truly lazy; the nearest neighbors are found and
+    // sorted the first time next is called, then returned one-by-one.
+    if (!m_searched)
     {
-        m_count++;
-        if (m_current_neighbors[m_count - 1].distance > m_r_max)
-        {
-            m_finished = true;
-            return NeighborQueryIterator::ITERATOR_TERMINATOR;
-        }
-        return m_current_neighbors[m_count - 1];
+        findNeighbors();
+        m_searched = true;
+    }
+
+    if (m_count < m_current_neighbors.size())
+    {
+        return m_current_neighbors[m_count++];
     }
 
     m_finished = true;
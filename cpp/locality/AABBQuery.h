@@ -5,13 +5,12 @@
 #define AABBQUERY_H
 
 #include <cmath>
-#include <map>
 #include <memory>
-#include <unordered_set>
 #include <vector>
 
 #include "AABBTree.h"
 #include "Box.h"
+#include "NearestNeighborHeap.h"
 #include "NeighborQuery.h"
 
 /*! \file AABBQuery.h
@@ -39,7 +38,14 @@ public:
     AABBQuery();
 
     //! New-style constructor.
-    AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points);
+    /*! \param box The simulation box.
+     *  \param points The points to build the tree from.
+     *  \param n_points The number of points.
+     *  \param lbvh If true, build the tree as a linear bounding volume
+     *         hierarchy (see AABBTree::buildTreeLBVH), which is much faster
+     *         to build in parallel for large numbers of points.
+     */
+    AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points, bool lbvh = false);
 
     //! Destructor
     ~AABBQuery();
@@ -52,6 +58,79 @@ public:
     virtual std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const;
 
+    //! Implementation of bulk query for AABBQuery (see NeighborQuery.h for documentation).
+    /*! Ball queries traverse the tree directly without creating per-point
+     *  iterators. Other query modes use the per-point iterators.
+     */
+    virtual void queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                           QueryArgs args, std::vector<NeighborBond>& bonds) const;
+
+    //! Computes the periodic image vectors to query for a given cutoff.
+    /*! \param r_max The query cutoff distance.
+     *  \param check_r_max If true, throw an error if r_max is too large for the box.
+     *  \param image_list The vector to store the image vectors in (resized as needed).
+     *
+     *  \return The number of image vectors to check.
+     */
+    unsigned int getImageVectors(float r_max, bool check_r_max, std::vector<vec3<float>>& image_list) const;
+
+    //! Update the positions of the points, refitting the existing tree if possible.
+    /*! The node AABBs of the existing tree are refit to the new positions
+     *  without changing its topology, which is much cheaper than building a
+     *  new tree when the points have only moved slightly. If the total
+     *  surface area of the refit nodes exceeds rebuild_threshold times the
+     *  surface area of the tree when it was last built (e.g. because points
+     *  have diffused far from the rest of their leaves or wrapped across a
+     *  periodic boundary), a new tree is built instead. The box cannot change.
+     *
+     *  \param points The new point positions, which must remain valid while this object is used.
+     *  \param n_points The number of points, which must not change.
+     *  \param rebuild_threshold The relative increase of the surface area that triggers a rebuild.
+     *
+     *  \return True if the tree was rebuilt, false if it was refit.
+     */
+    bool updatePoints(const vec3<float>* points, unsigned int n_points,
+                      float rebuild_threshold = DEFAULT_REBUILD_THRESHOLD);
+
+    static const float DEFAULT_REBUILD_THRESHOLD; //!< Default relative surface area increase to rebuild.
+
+    //! Find the points in a leaf node within a range of distances of a position.
+    /*! The positions of the points in each leaf are stored contiguously for
+     *  each coordinate (padded to NODE_CAPACITY points), so that all points
+     *  in a leaf can be checked at once with SIMD instructions where
+     *  available (AVX-512 or AVX2, with a scalar fallback). The slots of the
+     *  points found within the leaf are written in increasing order, so the
+     *  results are the same as checking the points one by one.
+     *
+     *  \param node_idx The index of the leaf node.
+     *  \param position The position to find neighbors of.
+     *  \param r_max_sq The squared maximum distance (exclusive).
+     *  \param r_min_sq The squared minimum distance (inclusive).
+     *  \param hit_slots Output array of at least NODE_CAPACITY indices into the leaf's particles.
+     *  \param hit_r_sq Output array of at least NODE_CAPACITY squared distances.
+     *
+     *  \return The number of points found.
+     */
+    unsigned int findLeafNeighbors(unsigned int node_idx, const vec3<float>& position, float r_max_sq,
+                                   float r_min_sq, unsigned int* hit_slots, float* hit_r_sq) const;
+
+    //! Get whether the tree is built as a linear bounding volume hierarchy
+    bool getLBVH() const
+    {
+        return m_lbvh;
+    }
+
+    //! Get the positions of the points in the tree.
+    /*! These are the positions of the points, except that each point may be
+     *  shifted by a lattice vector after updatePoints (with z = 0 in 2D).
+     *  Distances between query points and points must be computed with these
+     *  positions, since the query point images are chosen to match them.
+     */
+    const vec3<float>* getTreePoints() const
+    {
+        return m_tree_points.data();
+    }
+
     AABBTree m_aabb_tree; //!< AABB tree of points
 
 protected:
@@ -62,41 +141,12 @@ protected:
     virtual void validateQueryArgs(QueryArgs& args) const
     {
         NeighborQuery::validateQueryArgs(args);
-        if (args.mode == QueryArgs::nearest)
+        // The scale is not needed by the best-first nearest neighbor search,
+        // but it is still validated for consistency with earlier versions.
+        if (args.mode == QueryArgs::nearest && args.scale != QueryArgs::DEFAULT_SCALE
+            && args.scale <= float(1.0))
         {
-            if (args.scale == QueryArgs::DEFAULT_SCALE)
-            {
-                args.scale = float(1.1);
-            }
-            else if (args.scale <= float(1.0))
-            {
-                throw std::runtime_error("The scale query argument must be greater than 1.");
-            }
-
-            if (args.r_guess == QueryArgs::DEFAULT_R_GUESS)
-            {
-                // By default, we assume a homogeneous system density and use
-                // that to estimate the distance we need to query. This
-                // calculation assumes a constant density of N/V, where N is
-                // the number of particles and V is the box volume, and it
-                // calculates the radius of a sphere that will contain the
-                // desired number of neighbors.
-                float r_guess = std::cbrtf((3.0 * static_cast<float>(args.num_neighbors) * m_box.getVolume())
-                                           / (4.0 * PI * static_cast<float>(getNPoints())));
-
-                // The upper bound is set by the minimum nearest plane distances.
-                vec3<float> nearest_plane_distance = m_box.getNearestPlaneDistance();
-                float min_plane_distance = std::min(nearest_plane_distance.x, nearest_plane_distance.y);
-                if (!m_box.is2D())
-                    min_plane_distance = std::min(min_plane_distance, nearest_plane_distance.z);
-
-                args.r_guess = std::min(r_guess, min_plane_distance / float(2.0));
-            }
-            if (args.r_guess > args.r_max)
-            {
-                // No need to search past the requested bounds even if requested.
-                args.r_guess = args.r_max;
-            }
+            throw std::runtime_error("The scale query argument must be greater than 1.");
         }
     }
 
@@ -110,7 +160,28 @@ private:
     //! Driver to build AABB trees
     void buildTree(const vec3<float>* points, unsigned int N);
 
-    std::vector<AABB> m_aabbs; //!< Flat array of AABBs of all types
+    //! Compute the largest particle index contained in each subtree
+    void updateNodeMaxTags();
+
+    //! Set the point AABBs from the positions of the points in the tree
+    void updateAABBs();
+
+    //! Assign each leaf node a slot in the leaf position arrays
+    void updateLeafSlots();
+
+    //! Copy the positions of the points in the tree into the leaf position arrays
+    void updateLeafPositions();
+
+    bool m_lbvh;                                       //!< Whether to build the tree as an LBVH
+    std::vector<AABB, AlignedAllocator<AABB>> m_aabbs; //!< Flat array of AABBs of all types
+    std::vector<vec3<float>> m_tree_points;            //!< Positions of the points in the tree
+    std::vector<unsigned int> m_leaf_slots;            //!< Slot of each leaf node in the leaf position arrays
+    std::vector<float> m_leaf_x;                       //!< x coordinates of the points in each leaf slot
+    std::vector<float> m_leaf_y;                       //!< y coordinates of the points in each leaf slot
+    std::vector<float> m_leaf_z;                       //!< z coordinates of the points in each leaf slot
+    float m_build_surface_area; //!< Total surface area of the tree nodes when the tree was built
+    std::vector<unsigned int>
+        m_node_max_tags; //!< Largest particle index in each subtree, used to prune half queries.
 };
 
 //! Parent class of AABB iterators that knows how to traverse general AABB tree structures.
@@ -138,16 +209,24 @@ protected:
 };
 
 //! Iterator that gets a specified number of nearest neighbors from AABB tree structures.
+/*! The nearest neighbors are found in a single best-first traversal of the
+ *  tree. Nodes are visited in order of their distance from the query point
+ *  (over all periodic images) using a priority queue, and the nearest
+ *  candidates found so far are kept in a max-heap of num_neighbors bonds.
+ *  The traversal ends when the nearest unvisited node is farther away than
+ *  the farthest candidate. Only the minimum image distance to each point is
+ *  kept, so the search is exact even when the neighbors are farther away
+ *  than half of the box.
+ */
 class AABBQueryIterator : public AABBIterator
 {
 public:
     //! Constructor
     AABBQueryIterator(const AABBQuery* neighbor_query, const vec3<float> query_point,
-                      unsigned int query_point_idx, unsigned int num_neighbors, float r_guess, float r_max,
-                      float r_min, float scale, bool exclude_ii)
+                      unsigned int query_point_idx, unsigned int num_neighbors, float r_max, float r_min,
+                      bool exclude_ii)
         : AABBIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii), m_count(0),
-          m_num_neighbors(num_neighbors), m_search_extended(false), m_r_cur(r_guess), m_scale(scale),
-          m_all_distances(), m_query_points_below_r_min()
+          m_num_neighbors(num_neighbors), m_searched(false)
     {
         updateImageVectors(0);
     }
@@ -159,18 +238,13 @@ public:
     virtual NeighborBond next();
 
 protected:
+    //! Find the nearest neighbors of the query point, sorted by distance.
+    void findNeighbors();
+
     unsigned int m_count;                          //!< Number of neighbors returned for the current point.
     unsigned int m_num_neighbors;                  //!< Number of nearest neighbors to find
-    std::vector<NeighborBond> m_current_neighbors; //!< The current set of found neighbors.
-    float m_search_extended; //!< Flag to see whether we've gone past the safe cutoff distance and have to be
-                             //!< worried about finding duplicates.
-    float
-        m_r_cur; //!< Current search ball cutoff distance in use for the current particle (expands as needed).
-    float m_scale; //!< The amount to scale m_r by when the current ball is too small.
-    std::map<unsigned int, float> m_all_distances; //!< Hash map of minimum distances found for a given point,
-                                                   //!< used when searching beyond maximum safe AABB distance.
-    std::unordered_set<unsigned int> m_query_points_below_r_min; //!< The set of query_points that were too
-                                                                 //!< close based on the r_min threshold.
+    bool m_searched;                               //!< Whether the nearest neighbors have been found.
+    std::vector<NeighborBond> m_current_neighbors; //!< The nearest neighbors, sorted by distance.
 };
 
 //! Iterator that gets neighbors in a ball of size r_max using AABB tree structures.
@@ -182,7 +256,7 @@ public:
                           unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
                           bool _check_r_max = true)
         : AABBIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii), cur_image(0),
-          cur_node_idx(0), cur_ref_p(0)
+          cur_node_idx(0), cur_ref_p(0), m_leaf_searched(false), m_num_leaf_hits(0)
     {
         updateImageVectors(m_r_max, _check_r_max);
     }
@@ -194,10 +268,13 @@ public:
     virtual NeighborBond next();
 
 private:
-    unsigned int cur_image;    //!< The current node in the tree.
-    unsigned int cur_node_idx; //!< The current node in the tree.
-    unsigned int
-        cur_ref_p; //!< The current index into the reference particles in the current node of the tree.
+    unsigned int cur_image;                       //!< The current node in the tree.
+    unsigned int cur_node_idx;                    //!< The current node in the tree.
+    unsigned int cur_ref_p;                       //!< The current index into the neighbors found in the leaf.
+    bool m_leaf_searched;                         //!< Whether the current leaf has been searched.
+    unsigned int m_num_leaf_hits;                 //!< The number of neighbors found in the current leaf.
+    unsigned int m_leaf_hit_slots[NODE_CAPACITY]; //!< The leaf slots of the neighbors found.
+    float m_leaf_hit_r_sq[NODE_CAPACITY];         //!< The squared distances of the neighbors found.
 };
 }; }; // end namespace freud::locality
 
@@ -4,11 +4,17 @@
 #ifndef AABB_TREE_H
 #define AABB_TREE_H
 
+#include <atomic>
+#include <cstdlib>
 #include <cstring>
+#include <new>
 #include <stack>
+#include <tbb/tbb.h>
 #include <vector>
 
 #include "AABB.h"
+#include "MortonCode.h"
+#include "RadixSort.h"
 #include "VectorMath.h"
 
 /*! \file AABBTree.h
@@ -28,6 +34,49 @@ namespace freud { namespace locality {
 
 const unsigned int NODE_CAPACITY = 16;        //!< Maximum number of particles in a node
 const unsigned int INVALID_NODE = 0xffffffff; //!< Invalid node index sentinel
+const unsigned int REFIT_SERIAL_NODES = 512;  //!< Subtrees with fewer nodes are refit serially
+const unsigned int LBVH_SERIAL_PARTICLES = 4096; //!< LBVH subtrees with fewer particles are built serially
+
+//! Allocator for std::vector that honors the alignment of over-aligned types such as AABB
+/*! Before C++17, operator new only guarantees the alignment of fundamental
+ *  types. Compilers load and store 32-byte aligned types such as AABB with
+ *  aligned vector instructions when AVX is enabled, so containers of them must
+ *  be allocated with the alignment of the type.
+ */
+template<typename T> struct AlignedAllocator
+{
+    typedef T value_type;
+
+    AlignedAllocator() {}
+
+    template<typename U> AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t n)
+    {
+        void* ptr = NULL;
+        const size_t alignment = alignof(T) > sizeof(void*) ? alignof(T) : sizeof(void*);
+        if (posix_memalign(&ptr, alignment, n * sizeof(T)) != 0)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t)
+    {
+        posix_memalign_free(ptr);
+    }
+
+    template<typename U> bool operator==(const AlignedAllocator<U>&) const
+    {
+        return true;
+    }
+
+    template<typename U> bool operator!=(const AlignedAllocator<U>&) const
+    {
+        return false;
+    }
+};
 
 //! Node in an AABBTree
 /*! Stores data for a node in the AABB tree
@@ -64,7 +113,15 @@ struct CACHE_ALIGN AABBNode
    tree topology is left unchanged. Runs in O(log N) time. AABBs are not saved for all particles, so an update
    will only increase the volume of nodes. The tree should be rebuilt periodically instead of continually
    updated.
+    - Refit : Recompute the AABBs of all nodes from a complete set of new particle AABBs, keeping the tree
+   topology. Runs in O(N) time (in parallel). Unlike update, nodes may shrink. The total surface area of the
+   nodes, which refit returns, measures how well the topology still fits the particles.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
+    - buildTreeLBVH : build a linear bounding volume hierarchy (LBVH) given a complete set of AABBs, one for
+   each particle. The particles are sorted by the Morton codes of their positions and the tree is built by
+   recursively splitting the sorted particles at the highest bit in which their codes differ. All steps run in
+   parallel, so this is much faster than buildTree for large numbers of particles, although the resulting
+   tree is usually somewhat less efficient to query.
 
     **Implementation details**
 
@@ -146,12 +203,21 @@ public:
     //! Build a tree smartly from a list of AABBs
     inline void buildTree(AABB* aabbs, unsigned int N);
 
+    //! Build a linear bounding volume hierarchy in parallel from a list of AABBs
+    inline void buildTreeLBVH(const AABB* aabbs, unsigned int N);
+
     //! Find all particles that overlap with the query AABB
     inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
 
     //! Update the AABB of a particle
     inline void update(unsigned int idx, const AABB& aabb);
 
+    //! Refit the AABBs of all nodes to new particle AABBs without changing the topology
+    inline float refit(const AABB* aabbs);
+
+    //! Get the total surface area of all node AABBs
+    inline float getSurfaceArea() const;
+
     //! Get the height of a given particle's leaf node
     inline unsigned int height(unsigned int idx);
 
@@ -245,6 +311,36 @@ private:
 
     //! Update the skip value for a node
     inline unsigned int updateSkip(unsigned int idx);
+
+    //! Refit the AABBs of a node and all of its children
+    inline float refitNode(const AABB* aabbs, unsigned int idx);
+
+    //! Node of an LBVH before it is placed in the tree, covering a range of sorted particles
+    struct LBVHNode
+    {
+        unsigned int first;     //!< Index of the first sorted particle in the node
+        unsigned int last;      //!< One past the index of the last sorted particle in the node
+        unsigned int left;      //!< Index of the left child LBVHNode
+        unsigned int right;     //!< Index of the right child LBVHNode
+        unsigned int num_nodes; //!< Number of nodes in the subtree rooted at this node
+    };
+
+    //! Recursively split a range of sorted particles into LBVH nodes
+    inline unsigned int buildLBVHNode(const std::vector<uint64_t>& codes, unsigned int first, unsigned int last,
+                                      std::vector<LBVHNode>& lbvh_nodes,
+                                      std::atomic<unsigned int>& num_lbvh_nodes);
+
+    //! Recursively write LBVH nodes into the tree in preorder
+    inline void placeLBVHNode(const AABB* aabbs, const std::vector<unsigned int>& sorted_idx,
+                              const std::vector<LBVHNode>& lbvh_nodes, unsigned int lbvh_idx,
+                              unsigned int node_idx, unsigned int parent);
+
+    //! Compute the surface area of an AABB
+    static inline float surfaceArea(const AABB& aabb)
+    {
+        const vec3<float> extent = aabb.getUpper() - aabb.getLower();
+        return float(2) * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
 };
 
 /*! \param N Number of particles to allocate space for
@@ -333,6 +429,76 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
     }
 }
 
+/*! \param aabbs List of AABBs for each particle, indexed in the same way as in buildTree
+    \returns The total surface area of all node AABBs after refitting
+
+    Recompute the AABB of every leaf node from the AABBs of its particles, and of every internal node from its
+   children. refit() does not change the tree topology, so the tree quality degrades as particles move away
+   from the other particles in their leaves. This can be detected by comparing the returned surface area to
+   the surface area of a freshly built tree.
+*/
+inline float AABBTree::refit(const AABB* aabbs)
+{
+    if (m_num_nodes == 0)
+    {
+        return 0;
+    }
+    return refitNode(aabbs, m_root);
+}
+
+/*! \param aabbs List of AABBs for each particle
+    \param idx Index of the subtree's root node
+    \returns The total surface area of all node AABBs in the subtree
+
+    Nodes are stored in preorder, so the subtree rooted at node idx occupies the indices [idx, idx + skip] and
+   all children are stored after their parents. Small subtrees are refit with a reverse pass over their
+   indices; larger subtrees refit their children in parallel.
+*/
+inline float AABBTree::refitNode(const AABB* aabbs, unsigned int idx)
+{
+    AABBNode& node = m_nodes[idx];
+    if (node.skip < REFIT_SERIAL_NODES)
+    {
+        float surface_area = 0;
+        for (unsigned int node_idx = idx + node.skip + 1; node_idx-- > idx;)
+        {
+            AABBNode& current_node = m_nodes[node_idx];
+            if (current_node.left == INVALID_NODE)
+            {
+                AABB my_aabb = aabbs[current_node.particles[0]];
+                for (unsigned int i = 1; i < current_node.num_particles; i++)
+                {
+                    my_aabb = merge(my_aabb, aabbs[current_node.particles[i]]);
+                }
+                current_node.aabb = my_aabb;
+            }
+            else
+            {
+                current_node.aabb
+                    = merge(m_nodes[current_node.left].aabb, m_nodes[current_node.right].aabb);
+            }
+            surface_area += surfaceArea(current_node.aabb);
+        }
+        return surface_area;
+    }
+
+    float left_area(0), right_area(0);
+    tbb::parallel_invoke([&] { left_area = refitNode(aabbs, node.left); },
+                         [&] { right_area = refitNode(aabbs, node.right); });
+    node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+    return left_area + right_area + surfaceArea(node.aabb);
+}
+
+inline float AABBTree::getSurfaceArea() const
+{
+    float surface_area = 0;
+    for (unsigned int i = 0; i < m_num_nodes; i++)
+    {
+        surface_area += surfaceArea(m_nodes[i].aabb);
+    }
+    return surface_area;
+}
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -376,6 +542,221 @@ inline void AABBTree::buildTree(AABB* aabbs, unsigned int N)
     updateSkip(m_root);
 }
 
+/*! \param aabbs List of AABBs for each particle
+    \param N Number of AABBs in the list
+
+    Builds a linear bounding volume hierarchy from a given list of AABBs for each particle. Unlike buildTree,
+   the AABBs are not modified. The particles are sorted by the Morton codes of the centers of their AABBs
+   (relative to the bounds of all AABBs) with a parallel radix sort. The sorted particles are then split
+   recursively (and in parallel) at the highest bit in which the codes in a range differ until each range fits
+   in a leaf. Finally, the nodes are written into the tree in the same order as buildTree produces, with the
+   same skip values, and the node AABBs are computed by refitting.
+*/
+inline void AABBTree::buildTreeLBVH(const AABB* aabbs, unsigned int N)
+{
+    init(N);
+    if (N == 0)
+    {
+        return;
+    }
+
+    // Find the bounds of all AABB centers.
+    typedef std::pair<vec3<float>, vec3<float>> Bounds;
+    const vec3<float> first_position = aabbs[0].getPosition();
+    const Bounds bounds = tbb::parallel_reduce(
+        tbb::blocked_range<unsigned int>(0, N), Bounds(first_position, first_position),
+        [&](const tbb::blocked_range<unsigned int>& r, Bounds local_bounds) {
+            for (unsigned int i = r.begin(); i < r.end(); ++i)
+            {
+                const vec3<float> position = aabbs[i].getPosition();
+                local_bounds.first.x = std::min(local_bounds.first.x, position.x);
+                local_bounds.first.y = std::min(local_bounds.first.y, position.y);
+                local_bounds.first.z = std::min(local_bounds.first.z, position.z);
+                local_bounds.second.x = std::max(local_bounds.second.x, position.x);
+                local_bounds.second.y = std::max(local_bounds.second.y, position.y);
+                local_bounds.second.z = std::max(local_bounds.second.z, position.z);
+            }
+            return local_bounds;
+        },
+        [](const Bounds& a, const Bounds& b) {
+            return Bounds(vec3<float>(std::min(a.first.x, b.first.x), std::min(a.first.y, b.first.y),
+                                      std::min(a.first.z, b.first.z)),
+                          vec3<float>(std::max(a.second.x, b.second.x), std::max(a.second.y, b.second.y),
+                                      std::max(a.second.z, b.second.z)));
+        });
+    const vec3<float> extent = bounds.second - bounds.first;
+    const vec3<float> inv_extent(extent.x > 0 ? 1 / extent.x : 0, extent.y > 0 ? 1 / extent.y : 0,
+                                 extent.z > 0 ? 1 / extent.z : 0);
+
+    // Sort the particles by their Morton codes.
+    std::vector<uint64_t> codes(N);
+    std::vector<unsigned int> sorted_idx(N);
+    util::forLoopWrapper(0, N, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const vec3<float> frac = aabbs[i].getPosition() - bounds.first;
+            codes[i] = util::mortonCode(
+                vec3<float>(frac.x * inv_extent.x, frac.y * inv_extent.y, frac.z * inv_extent.z));
+            sorted_idx[i] = static_cast<unsigned int>(i);
+        }
+    });
+    util::radixSortPairs(codes, sorted_idx, 3 * util::MORTON_BITS_PER_DIM);
+
+    // Build the hierarchy. A binary tree with at least one particle per leaf
+    // has fewer than 2N nodes.
+    std::vector<LBVHNode> lbvh_nodes(2 * N);
+    std::atomic<unsigned int> num_lbvh_nodes(0);
+    const unsigned int lbvh_root = buildLBVHNode(codes, 0, N, lbvh_nodes, num_lbvh_nodes);
+    const unsigned int num_nodes = lbvh_nodes[lbvh_root].num_nodes;
+
+    // Allocate the nodes and place them in preorder.
+    if (num_nodes > m_node_capacity)
+    {
+        if (m_nodes)
+        {
+            posix_memalign_free(m_nodes);
+            m_nodes = NULL;
+        }
+        int retval = posix_memalign((void**) &m_nodes, 32, num_nodes * sizeof(AABBNode));
+        if (retval != 0)
+        {
+            throw std::runtime_error("Error allocating AABBTree memory");
+        }
+        m_node_capacity = num_nodes;
+    }
+    m_num_nodes = num_nodes;
+    m_root = 0;
+    placeLBVHNode(aabbs, sorted_idx, lbvh_nodes, lbvh_root, m_root, INVALID_NODE);
+
+    refit(aabbs);
+}
+
+/*! \param codes Sorted Morton codes of the particles
+    \param first Index of the first sorted particle in the node
+    \param last One past the index of the last sorted particle in the node
+    \param lbvh_nodes Storage for the LBVH nodes
+    \param num_lbvh_nodes Number of LBVH nodes allocated so far
+    \returns The index of the new LBVH node
+*/
+inline unsigned int AABBTree::buildLBVHNode(const std::vector<uint64_t>& codes, unsigned int first,
+                                            unsigned int last, std::vector<LBVHNode>& lbvh_nodes,
+                                            std::atomic<unsigned int>& num_lbvh_nodes)
+{
+    const unsigned int lbvh_idx = num_lbvh_nodes.fetch_add(1, std::memory_order_relaxed);
+    LBVHNode& node = lbvh_nodes[lbvh_idx];
+    node.first = first;
+    node.last = last;
+
+    if (last - first <= NODE_CAPACITY)
+    {
+        node.left = node.right = INVALID_NODE;
+        node.num_nodes = 1;
+        return lbvh_idx;
+    }
+
+    // Split at the highest bit that differs within the range, i.e. after the
+    // last particle whose code shares a longer prefix with the first code than
+    // the last code does. If all codes are identical, split in the middle.
+    unsigned int split = first + (last - first) / 2;
+    const uint64_t first_code = codes[first];
+    const uint64_t range_xor = first_code ^ codes[last - 1];
+    if (range_xor != 0)
+    {
+        uint64_t highest_bit = range_xor;
+        highest_bit |= highest_bit >> 1;
+        highest_bit |= highest_bit >> 2;
+        highest_bit |= highest_bit >> 4;
+        highest_bit |= highest_bit >> 8;
+        highest_bit |= highest_bit >> 16;
+        highest_bit |= highest_bit >> 32;
+        highest_bit ^= highest_bit >> 1;
+
+        // Binary search for the first code with the highest bit set.
+        unsigned int lo = first + 1;
+        unsigned int hi = last - 1;
+        while (lo < hi)
+        {
+            const unsigned int mid = lo + (hi - lo) / 2;
+            if ((codes[mid] ^ first_code) & highest_bit)
+            {
+                hi = mid;
+            }
+            else
+            {
+                lo = mid + 1;
+            }
+        }
+        split = lo;
+    }
+
+    unsigned int left, right;
+    if (last - first < LBVH_SERIAL_PARTICLES)
+    {
+        left = buildLBVHNode(codes, first, split, lbvh_nodes, num_lbvh_nodes);
+        right = buildLBVHNode(codes, split, last, lbvh_nodes, num_lbvh_nodes);
+    }
+    else
+    {
+        tbb::parallel_invoke(
+            [&] { left = buildLBVHNode(codes, first, split, lbvh_nodes, num_lbvh_nodes); },
+            [&] { right = buildLBVHNode(codes, split, last, lbvh_nodes, num_lbvh_nodes); });
+    }
+    node.left = left;
+    node.right = right;
+    node.num_nodes = 1 + lbvh_nodes[left].num_nodes + lbvh_nodes[right].num_nodes;
+    return lbvh_idx;
+}
+
+/*! \param aabbs List of AABBs for each particle
+    \param sorted_idx Particle indices sorted by their Morton codes
+    \param lbvh_nodes The LBVH nodes
+    \param lbvh_idx Index of the LBVH node to place
+    \param node_idx Index of the tree node to write
+    \param parent Index of the parent tree node
+
+    In preorder, the left child of a node immediately follows it and the right child follows the entire left
+   subtree, so the index of every node is known from the subtree sizes and subtrees can be written in parallel.
+*/
+inline void AABBTree::placeLBVHNode(const AABB* aabbs, const std::vector<unsigned int>& sorted_idx,
+                                    const std::vector<LBVHNode>& lbvh_nodes, unsigned int lbvh_idx,
+                                    unsigned int node_idx, unsigned int parent)
+{
+    const LBVHNode& lbvh_node = lbvh_nodes[lbvh_idx];
+    AABBNode& node = m_nodes[node_idx];
+    node = AABBNode();
+    node.parent = parent;
+    node.skip = lbvh_node.num_nodes - 1;
+
+    if (lbvh_node.left == INVALID_NODE)
+    {
+        node.num_particles = lbvh_node.last - lbvh_node.first;
+        for (unsigned int i = 0; i < node.num_particles; i++)
+        {
+            const unsigned int particle = sorted_idx[lbvh_node.first + i];
+            node.particles[i] = particle;
+            node.particle_tags[i] = aabbs[particle].tag;
+            m_mapping[particle] = node_idx;
+        }
+        return;
+    }
+
+    const unsigned int left_idx = node_idx + 1;
+    const unsigned int right_idx = left_idx + lbvh_nodes[lbvh_node.left].num_nodes;
+    node.left = left_idx;
+    node.right = right_idx;
+    if (lbvh_node.last - lbvh_node.first < LBVH_SERIAL_PARTICLES)
+    {
+        placeLBVHNode(aabbs, sorted_idx, lbvh_nodes, lbvh_node.left, left_idx, node_idx);
+        placeLBVHNode(aabbs, sorted_idx, lbvh_nodes, lbvh_node.right, right_idx, node_idx);
+    }
+    else
+    {
+        tbb::parallel_invoke(
+            [&] { placeLBVHNode(aabbs, sorted_idx, lbvh_nodes, lbvh_node.left, left_idx, node_idx); },
+            [&] { placeLBVHNode(aabbs, sorted_idx, lbvh_nodes, lbvh_node.right, right_idx, node_idx); });
+    }
+}
+
 /*! \param aabbs List of AABBs
     \param idx List of indices
     \param start Start point in aabbs and idx to examine
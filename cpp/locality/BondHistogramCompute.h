@@ -1,13 +1,105 @@
 #ifndef HISTOGRAM_COMPUTE_H
 #define HISTOGRAM_COMPUTE_H
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tbb/flow_graph.h>
+#include <vector>
+
 #include "Box.h"
 #include "Histogram.h"
 #include "NeighborComputeFunctional.h"
 #include "NeighborQuery.h"
+#include "RawPoints.h"
 
 namespace freud { namespace locality {
 
+//! Memory above which the thread-local copies of a bond histogram are replaced by a shared histogram.
+const size_t MAX_LOCAL_HISTOGRAMS_BYTES = size_t(256) * 1024 * 1024;
+
+//! Number of frames of a multi-frame accumulation processed at the same time.
+/*! The neighbors of the next frames are found while the current frame is
+ * binned (see BondHistogramCompute::accumulateFramesGeneral). Each frame in
+ * flight holds its NeighborQuery and NeighborList.
+ */
+const unsigned int MAX_FRAMES_IN_FLIGHT = 2;
+
+//! The histogram that a block of bonds is counted into.
+/*! Depending on the accumulation strategy of a BondHistogramCompute, the
+ * bins of the bonds are either counted in the thread-local copy of the
+ * histogram of the running thread or added atomically to a histogram shared
+ * by all threads (see BondHistogramCompute::AccumulationStrategy).
+ */
+class BondHistogramAccumulator
+{
+public:
+    //! Count into a thread-local histogram.
+    explicit BondHistogramAccumulator(util::Histogram<unsigned int>& local_histogram)
+        : m_local_histogram(&local_histogram), m_shared_counts(NULL)
+    {}
+
+    //! Count atomically into a shared histogram.
+    explicit BondHistogramAccumulator(std::atomic<unsigned int>* shared_counts)
+        : m_local_histogram(NULL), m_shared_counts(shared_counts)
+    {}
+
+    //! Return whether the bins are counted into the shared histogram.
+    bool isShared() const
+    {
+        return m_shared_counts != NULL;
+    }
+
+    //! Increment the specified linear bin (with a specified weight if desired).
+    void increment(size_t value_bin, unsigned int weight = 1)
+    {
+        // Check for sentinel to avoid overflow.
+        if (value_bin == util::Axis::OVERFLOW_BIN)
+        {
+            return;
+        }
+        if (m_shared_counts != NULL)
+        {
+            m_shared_counts[value_bin].fetch_add(weight, std::memory_order_relaxed);
+        }
+        else
+        {
+            m_local_histogram->increment(value_bin, weight);
+        }
+    }
+
+    //! Increment the linear bins of a batch of values, all with the same weight.
+    /*! A thread-local histogram counts the batch in its interleaved
+     * sub-histograms (see util::Histogram::incrementBatch).
+     *
+     * \param bins The linear bins of the values (entries equal to Axis::OVERFLOW_BIN are skipped).
+     * \param num_values The number of values.
+     * \param weight The weight of each value.
+     */
+    void incrementBatch(const unsigned int* bins, size_t num_values, unsigned int weight = 1)
+    {
+        if (m_shared_counts == NULL)
+        {
+            m_local_histogram->incrementBatch(bins, num_values, weight);
+            return;
+        }
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            if (bins[i] != util::Axis::OVERFLOW_BIN)
+            {
+                m_shared_counts[bins[i]].fetch_add(weight, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    util::Histogram<unsigned int>* m_local_histogram; //!< The thread-local histogram, if used.
+    std::atomic<unsigned int>* m_shared_counts;       //!< Counts of the shared histogram, if used.
+};
+
 //! Perform parallel histogram computations.
 /*! The BondHistogramCompute class serves as a parent class for freud computes
  * that compute histograms of neighbor bonds. It encapsulates a Histogram
@@ -19,10 +111,40 @@ namespace freud { namespace locality {
 class BondHistogramCompute
 {
 public:
+    //! Strategies for accumulating the histogram in parallel.
+    /*! Counting into a separate copy of the histogram on each thread avoids
+     * any synchronization, but the copies take the size of the histogram
+     * times the number of threads, which is prohibitive for large
+     * multi-dimensional histograms on many threads. A single histogram shared
+     * by all threads with atomic increments bounds the memory independently
+     * of the number of threads.
+     */
+    enum AccumulationStrategy
+    {
+        automatic,    //! Use shared_atomic if the local copies would exceed MAX_LOCAL_HISTOGRAMS_BYTES.
+        local_copies, //! Count into thread-local copies of the histogram.
+        shared_atomic //! Count into one histogram shared by all threads with atomic increments.
+    };
+
+    //! A frame of a multi-frame accumulation (see accumulateFramesGeneral).
+    /*! The arrays are owned by the caller and must remain valid until the
+     * accumulation returns. To compute the histogram of a set of points with
+     * itself, pass the points as query points as well (and set exclude_ii in
+     * the query arguments).
+     */
+    struct Frame
+    {
+        box::Box box;                //!< The simulation box.
+        vec3<float>* points;         //!< The points to build a NeighborQuery from.
+        unsigned int n_points;       //!< The number of points.
+        vec3<float>* query_points;   //!< The points to find neighbors of.
+        unsigned int n_query_points; //!< The number of query points.
+    };
+
     //! Default constructor
     BondHistogramCompute()
         : m_box(box::Box()), m_frame_counter(0), m_n_points(0), m_n_query_points(0), m_reduce(true),
-          m_histogram(), m_local_histograms()
+          m_histogram(), m_local_histograms(), m_strategy(automatic), m_shared_modified(false)
     {}
 
     //! Destructor
@@ -31,11 +153,47 @@ public:
     //! Reset the RDF array to all zeros
     virtual void reset()
     {
+        // The bin counts may have been returned, so they are reallocated
+        // rather than zeroed if they are still referenced.
+        m_histogram.prepare(m_histogram.shape());
         m_local_histograms.reset();
+        for (std::vector<std::atomic<unsigned int>>::iterator count = m_shared_bin_counts.begin();
+             count != m_shared_bin_counts.end(); ++count)
+        {
+            count->store(0, std::memory_order_relaxed);
+        }
+        m_shared_modified = false;
         m_frame_counter = 0;
         m_reduce = true;
     }
 
+    //! Get the strategy used to accumulate the histogram in parallel
+    AccumulationStrategy getAccumulationStrategy() const
+    {
+        return m_strategy;
+    }
+
+    //! Set the strategy used to accumulate the histogram in parallel
+    /*! The strategy applies to accumulations through accumulateGeneral and
+     * accumulateGeneralVectors. It may be changed between accumulations, the
+     * counts accumulated with either strategy are combined when reducing.
+     */
+    void setAccumulationStrategy(AccumulationStrategy strategy)
+    {
+        m_strategy = strategy;
+    }
+
+    //! Return whether the next accumulation counts into the shared histogram
+    bool usesSharedHistogram() const
+    {
+        if (m_strategy == automatic)
+        {
+            const size_t num_threads = tbb::this_task_arena::max_concurrency();
+            return m_histogram.size() * sizeof(unsigned int) * num_threads > MAX_LOCAL_HISTOGRAMS_BYTES;
+        }
+        return m_strategy == shared_atomic;
+    }
+
     //! Reduce thread-local arrays onto the primary data arrays.
     virtual void reduce() = 0;
 
@@ -91,22 +249,110 @@ public:
     }
 
     //! \internal
-    // Wrapper to do accumulation.
+    // Wrapper to do accumulation over blocks of bonds.
     /*! \param neighbor_query NeighborQuery object to iterate over
         \param query_points Points
         \param n_query_points Number of query_points
         \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query
            appropriately with given qargs.
         \param qargs Query arguments
-        \param cf An object with operator(NeighborBond) as input.
+        \param cf An object with operator(const NeighborBond* first, const NeighborBond* last) as input
+           (see loopOverNeighborBlocks).
+    */
+    template<typename Func>
+    void accumulateGeneralBlocks(const locality::NeighborQuery* neighbor_query,
+                                 const vec3<float>* query_points, unsigned int n_query_points,
+                                 const locality::NeighborList* nlist, locality::QueryArgs qargs, Func cf)
+    {
+        m_box = neighbor_query->getBox();
+        locality::loopOverNeighborBlocks(neighbor_query, query_points, n_query_points, qargs, nlist, cf);
+        m_frame_counter++;
+        m_n_points = neighbor_query->getNPoints();
+        m_n_query_points = n_query_points;
+        // flag to reduce
+        m_reduce = true;
+    }
+
+    //! \internal
+    // Wrapper to do accumulation over blocks of the bonds of a CompressedNeighborList.
+    /*! \param neighbor_query NeighborQuery object holding the points of the bonds
+        \param n_query_points Number of query_points
+        \param nlist The CompressedNeighborList to loop over.
+        \param cf An object with operator(const NeighborBond* first, const NeighborBond* last) as input
+           (see loopOverNeighborBlocks).
+    */
+    template<typename Func>
+    void accumulateGeneralBlocks(const locality::NeighborQuery* neighbor_query, unsigned int n_query_points,
+                                 const locality::CompressedNeighborList* nlist, Func cf)
+    {
+        nlist->validate(n_query_points, neighbor_query->getNPoints());
+        m_box = neighbor_query->getBox();
+        locality::loopOverNeighborBlocks(nlist, cf);
+        m_frame_counter++;
+        m_n_points = neighbor_query->getNPoints();
+        m_n_query_points = n_query_points;
+        // flag to reduce
+        m_reduce = true;
+    }
+
+    //! \internal
+    // Wrapper to do accumulation.
+    /*! The histogram to count into (see getAccumulator) is looked up once per
+        block of bonds and passed to the compute function along with each bond.
+
+        \param neighbor_query NeighborQuery object to iterate over
+        \param query_points Points
+        \param n_query_points Number of query_points
+        \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query
+           appropriately with given qargs.
+        \param qargs Query arguments
+        \param cf An object with operator(NeighborBond, BondHistogramAccumulator&) as input.
     */
     template<typename Func>
     void accumulateGeneral(const locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                            unsigned int n_query_points, const locality::NeighborList* nlist,
                            locality::QueryArgs qargs, Func cf)
+    {
+        std::atomic<unsigned int>* shared_counts = prepareSharedHistogram();
+        accumulateGeneralBlocks(neighbor_query, query_points, n_query_points, nlist, qargs,
+                                [&](const NeighborBond* first, const NeighborBond* last) {
+                                    BondHistogramAccumulator histogram = getAccumulator(shared_counts);
+                                    for (const NeighborBond* nb = first; nb != last; ++nb)
+                                    {
+                                        cf(*nb, histogram);
+                                    }
+                                });
+    }
+
+    //! \internal
+    // Wrapper to do accumulation over bonds and their bond vectors.
+    /*! The histogram to count into (see getAccumulator) is looked up once per
+        block of bonds and passed to the compute function along with each bond.
+
+        \param neighbor_query NeighborQuery object to iterate over
+        \param query_points Points
+        \param n_query_points Number of query_points
+        \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query
+           appropriately with given qargs. Bond vectors stored in the list are used directly.
+        \param qargs Query arguments
+        \param cf An object with operator(NeighborBond, vec3<float>, BondHistogramAccumulator&) as input.
+    */
+    template<typename Func>
+    void accumulateGeneralVectors(const locality::NeighborQuery* neighbor_query,
+                                  const vec3<float>* query_points, unsigned int n_query_points,
+                                  const locality::NeighborList* nlist, locality::QueryArgs qargs, Func cf)
     {
         m_box = neighbor_query->getBox();
-        locality::loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, nlist, cf);
+        std::atomic<unsigned int>* shared_counts = prepareSharedHistogram();
+        locality::loopOverNeighborVectorBlocks(
+            neighbor_query, query_points, n_query_points, qargs, nlist,
+            [&](const NeighborBond* first, const NeighborBond* last, const vec3<float>* vectors) {
+                BondHistogramAccumulator histogram = getAccumulator(shared_counts);
+                for (const NeighborBond* nb = first; nb != last; ++nb, ++vectors)
+                {
+                    cf(*nb, *vectors, histogram);
+                }
+            });
         m_frame_counter++;
         m_n_points = neighbor_query->getNPoints();
         m_n_query_points = n_query_points;
@@ -115,6 +361,163 @@ public:
     }
 
 protected:
+    //! \internal
+    // Accumulate a sequence of frames, finding the neighbors of later frames while earlier ones are binned.
+    /*! Accumulating frames one at a time alternates between building the
+        neighbor query and list of a frame and binning its bonds, each of which
+        waits for all threads to finish. Here the two stages form a TBB flow
+        graph: the neighbors of up to MAX_FRAMES_IN_FLIGHT frames are found
+        concurrently, while a serial stage bins the frames in order, so that
+        finding the neighbors of frame k + 1 overlaps with binning frame k.
+        Since the frames are binned in order, the box and the numbers of points
+        used to normalize the histogram are those of the last frame, as when
+        accumulating the frames one at a time. The neighbors of each frame are
+        found with a RawPoints, which selects the data structure for the frame
+        like computes given a box and points do. If a frame throws, the
+        exception is rethrown once the frames before it have been accumulated.
+        An exception from finding the neighbors of a frame is therefore held
+        back until the frame is reached by the binning stage, rather than
+        cancelling the graph while an earlier frame is being binned.
+
+        \param frames The frames to accumulate.
+        \param qargs Query arguments used to find the neighbors of every frame.
+        \param cf An object with operator(size_t frame, const NeighborQuery* neighbor_query,
+           const NeighborList* nlist) as input, which accumulates the frame with the given index.
+    */
+    template<typename Func>
+    void accumulateFramesGeneral(const std::vector<Frame>& frames, locality::QueryArgs qargs, Func cf)
+    {
+        // The neighbors of a frame, passed from the first to the second stage.
+        struct FrameNeighbors
+        {
+            size_t frame;
+            std::shared_ptr<locality::NeighborQuery> neighbor_query;
+            std::shared_ptr<locality::NeighborList> nlist;
+            std::exception_ptr error; //!< The exception thrown while finding the neighbors, if any.
+        };
+
+        tbb::flow::graph graph;
+        tbb::flow::function_node<size_t, FrameNeighbors> find_neighbors(
+            graph, tbb::flow::unlimited, [&](size_t frame) {
+                FrameNeighbors neighbors;
+                neighbors.frame = frame;
+                try
+                {
+                    neighbors.neighbor_query = std::make_shared<locality::RawPoints>(
+                        frames[frame].box, frames[frame].points, frames[frame].n_points);
+                    neighbors.nlist = std::shared_ptr<locality::NeighborList>(
+                        neighbors.neighbor_query
+                            ->query(frames[frame].query_points, frames[frame].n_query_points, qargs)
+                            ->toNeighborList());
+                }
+                catch (...)
+                {
+                    neighbors.error = std::current_exception();
+                }
+                return neighbors;
+            });
+        tbb::flow::sequencer_node<FrameNeighbors> in_order(
+            graph, [](const FrameNeighbors& neighbors) { return neighbors.frame; });
+        tbb::flow::function_node<FrameNeighbors, tbb::flow::continue_msg> bin(
+            graph, tbb::flow::serial, [&](const FrameNeighbors& neighbors) {
+                if (neighbors.error)
+                {
+                    std::rethrow_exception(neighbors.error);
+                }
+                cf(neighbors.frame, neighbors.neighbor_query.get(), neighbors.nlist.get());
+                // Keep MAX_FRAMES_IN_FLIGHT frames in flight, bounding the
+                // number of neighbor lists held at the same time.
+                const size_t next_frame = neighbors.frame + MAX_FRAMES_IN_FLIGHT;
+                if (next_frame < frames.size())
+                {
+                    find_neighbors.try_put(next_frame);
+                }
+                return tbb::flow::continue_msg();
+            });
+        tbb::flow::make_edge(find_neighbors, in_order);
+        tbb::flow::make_edge(in_order, bin);
+
+        const size_t num_started = std::min(frames.size(), size_t(MAX_FRAMES_IN_FLIGHT));
+        for (size_t frame = 0; frame < num_started; ++frame)
+        {
+            find_neighbors.try_put(frame);
+        }
+        graph.wait_for_all();
+    }
+
+    //! Throw an exception unless an array of per-frame data has an entry for every frame.
+    /*! \param frames The frames of a multi-frame accumulation.
+     *  \param frame_data The per-frame data.
+     *  \param name The name of the data, for the error message.
+     */
+    template<typename U>
+    static void validateFrameData(const std::vector<Frame>& frames, const std::vector<U>& frame_data,
+                                  const std::string& name)
+    {
+        if (frame_data.size() != frames.size())
+        {
+            throw std::invalid_argument("The number of arrays of " + name
+                                        + " must match the number of frames.");
+        }
+    }
+
+    //! Allocate the shared histogram if the next accumulation uses it.
+    /*! \return The shared counts, or NULL if thread-local copies are used.
+     */
+    std::atomic<unsigned int>* prepareSharedHistogram()
+    {
+        if (!usesSharedHistogram())
+        {
+            return NULL;
+        }
+        m_shared_modified = true;
+        if (m_shared_bin_counts.size() != m_histogram.size())
+        {
+            m_shared_bin_counts = std::vector<std::atomic<unsigned int>>(m_histogram.size());
+            for (std::vector<std::atomic<unsigned int>>::iterator count = m_shared_bin_counts.begin();
+                 count != m_shared_bin_counts.end(); ++count)
+            {
+                count->store(0, std::memory_order_relaxed);
+            }
+        }
+        return m_shared_bin_counts.data();
+    }
+
+    //! Return the histogram the current thread counts into.
+    /*! \param shared_counts The result of prepareSharedHistogram.
+     */
+    BondHistogramAccumulator getAccumulator(std::atomic<unsigned int>* shared_counts)
+    {
+        if (shared_counts != NULL)
+        {
+            return BondHistogramAccumulator(shared_counts);
+        }
+        return BondHistogramAccumulator(m_local_histograms.local());
+    }
+
+    //! Reduce the thread-local and shared counts into m_histogram and apply a function to each bin.
+    /*! m_histogram holds the counts of all frames accumulated since the last
+     * reset. The counts accumulated since the previous reduction are moved
+     * into it, only from the thread-local histograms that were used and from
+     * the shared histogram if it was used (see
+     * util::Histogram::foldOverThreadsPerBin), so reducing after every frame
+     * is cheap.
+     *
+     * \param cf The function to apply to each bin after it is reduced, must have signature (size_t i).
+     */
+    template<typename ComputeFunction> void reduceHistogramPerBin(const ComputeFunction& cf)
+    {
+        std::atomic<unsigned int>* shared_counts = m_shared_modified ? m_shared_bin_counts.data() : NULL;
+        m_shared_modified = false;
+        m_histogram.foldOverThreadsPerBin(m_local_histograms, [&](size_t i) {
+            if (shared_counts != NULL)
+            {
+                m_histogram[i] += shared_counts[i].exchange(0, std::memory_order_relaxed);
+            }
+            cf(i);
+        });
+    }
+
     box::Box m_box;
     unsigned int m_frame_counter;  //!< Number of frames calculated.
     unsigned int m_n_points;       //!< The number of points.
@@ -124,6 +527,10 @@ protected:
     util::Histogram<unsigned int> m_histogram; //!< Histogram of interparticle distances (bond lengths).
     util::Histogram<unsigned int>::ThreadLocalHistogram
         m_local_histograms; //!< Thread local bin counts for TBB parallelism
+    AccumulationStrategy m_strategy; //!< How the histogram is accumulated in parallel.
+    std::vector<std::atomic<unsigned int>>
+        m_shared_bin_counts; //!< Bin counts shared by all threads (empty unless used).
+    bool m_shared_modified;  //!< Whether the shared bin counts were used since the last reduction.
 
     typedef util::Histogram<unsigned int> BondHistogram;
     typedef typename BondHistogram::Axes BHAxes;
@@ -0,0 +1,268 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "CompressedNeighborList.h"
+#include "utils.h"
+
+/*! \file CompressedNeighborList.cc
+    \brief Compact storage of the bonds of a NeighborList.
+*/
+
+namespace freud { namespace locality {
+
+namespace {
+
+//! Append the zigzag-encoded difference between two point indices as a variable-length integer.
+/*! \return The number of bytes written.
+ */
+inline unsigned int encodeDelta(unsigned int previous, unsigned int current, std::vector<uint8_t>& bytes)
+{
+    const int64_t delta = int64_t(current) - int64_t(previous);
+    uint64_t value = (uint64_t(delta) << 1) ^ uint64_t(delta >> 63);
+    unsigned int num_bytes = 1;
+    while (value >= 0x80)
+    {
+        bytes.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+        ++num_bytes;
+    }
+    bytes.push_back(uint8_t(value));
+    return num_bytes;
+}
+
+//! Read a zigzag-encoded variable-length difference and apply it to a point index.
+inline unsigned int decodeDelta(unsigned int previous, const uint8_t*& bytes)
+{
+    uint64_t value = 0;
+    unsigned int shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = *bytes++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    const int64_t delta = int64_t(value >> 1) ^ -int64_t(value & 1);
+    return static_cast<unsigned int>(int64_t(previous) + delta);
+}
+
+//! The bonds of a block of query points, compressed independently of other blocks.
+struct CompressedBlock
+{
+    std::vector<unsigned int> counts;         //!< Number of bonds of each query point.
+    std::vector<size_t> encoded_counts;       //!< Number of encoded bytes of each query point.
+    std::vector<unsigned int> point_indices;  //!< Point indices (if not delta-encoded).
+    std::vector<uint8_t> encoded;             //!< Delta-encoded point indices (if delta-encoded).
+    std::vector<float> distances;             //!< Distance of each bond.
+    std::vector<float> weights;               //!< Weight of each bond.
+    bool unit_weights;                        //!< Whether all weights are 1.
+};
+
+}; // end anonymous namespace
+
+CompressedNeighborList::CompressedNeighborList()
+    : m_num_query_points(0), m_num_points(0), m_delta_encoded(true), m_segments(1, 0),
+      m_encoded_segments(1, 0)
+{}
+
+CompressedNeighborList::CompressedNeighborList(const NeighborList& nlist, bool delta_encode)
+    : m_num_query_points(nlist.getNumQueryPoints()), m_num_points(nlist.getNumPoints()),
+      m_delta_encoded(delta_encode)
+{
+    // The bonds of a NeighborList are sorted by query point, so the bonds of
+    // a range of query points are found by bisection.
+    const util::ManagedArray<unsigned int>& neighbors = nlist.getNeighbors();
+
+    build([&](unsigned int begin, unsigned int end, std::vector<NeighborBond>& bonds) {
+        const unsigned int last_bond = nlist.find_first_index(end);
+        for (unsigned int bond = nlist.find_first_index(begin); bond < last_bond; ++bond)
+        {
+            bonds.emplace_back(neighbors(bond, 0), neighbors(bond, 1), nlist.getDistances()[bond],
+                               nlist.getWeights()[bond]);
+        }
+    });
+}
+
+CompressedNeighborList::CompressedNeighborList(const NeighborQuery* nq, const vec3<float>* query_points,
+                                               unsigned int num_query_points, QueryArgs qargs,
+                                               bool delta_encode)
+    : m_num_query_points(num_query_points), m_num_points(nq->getNPoints()), m_delta_encoded(delta_encode)
+{
+    std::shared_ptr<NeighborQueryIterator> iter = nq->query(query_points, num_query_points, qargs);
+
+    // Bonds are sorted in the same order as in NeighborQueryIterator::toNeighborList.
+    build([&](unsigned int begin, unsigned int end, std::vector<NeighborBond>& bonds) {
+        iter->queryBulk(begin, end, bonds);
+        sortBondsByQueryPoint(bonds);
+    });
+}
+
+void CompressedNeighborList::build(const BondSource& source)
+{
+    // Pass 1: compress the bonds of each block of query points separately.
+    const size_t num_blocks
+        = (size_t(m_num_query_points) + NEIGHBOR_LIST_BLOCK_SIZE - 1) / NEIGHBOR_LIST_BLOCK_SIZE;
+    std::vector<CompressedBlock> blocks(num_blocks);
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        std::vector<NeighborBond> bonds;
+        for (size_t block_idx = begin; block_idx < end; ++block_idx)
+        {
+            CompressedBlock& block = blocks[block_idx];
+            const unsigned int first = block_idx * NEIGHBOR_LIST_BLOCK_SIZE;
+            const unsigned int last = std::min(m_num_query_points, first + NEIGHBOR_LIST_BLOCK_SIZE);
+            bonds.clear();
+            source(first, last, bonds);
+
+            block.counts.assign(last - first, 0);
+            block.encoded_counts.assign(m_delta_encoded ? last - first : 0, 0);
+            block.distances.reserve(bonds.size());
+            block.weights.reserve(bonds.size());
+            block.unit_weights = true;
+            unsigned int previous_point_idx = 0;
+            for (size_t bond = 0; bond < bonds.size(); ++bond)
+            {
+                const NeighborBond& nb = bonds[bond];
+                const unsigned int local_idx = nb.query_point_idx - first;
+                if (bond == 0 || nb.query_point_idx != bonds[bond - 1].query_point_idx)
+                {
+                    previous_point_idx = 0;
+                }
+                ++block.counts[local_idx];
+                if (m_delta_encoded)
+                {
+                    block.encoded_counts[local_idx]
+                        += encodeDelta(previous_point_idx, nb.point_idx, block.encoded);
+                    previous_point_idx = nb.point_idx;
+                }
+                else
+                {
+                    block.point_indices.push_back(nb.point_idx);
+                }
+                block.distances.push_back(nb.distance);
+                block.weights.push_back(nb.weight);
+                block.unit_weights = block.unit_weights && nb.weight == float(1.0);
+            }
+        }
+    });
+
+    // The exclusive prefix sums of the counts give the segments.
+    m_segments.assign(m_num_query_points + 1, 0);
+    m_encoded_segments.assign(m_delta_encoded ? m_num_query_points + 1 : 1, 0);
+    bool unit_weights = true;
+    for (size_t block_idx = 0; block_idx < num_blocks; ++block_idx)
+    {
+        const CompressedBlock& block = blocks[block_idx];
+        const unsigned int first = block_idx * NEIGHBOR_LIST_BLOCK_SIZE;
+        for (unsigned int i = 0; i < block.counts.size(); ++i)
+        {
+            m_segments[first + i + 1] = m_segments[first + i] + block.counts[i];
+            if (m_delta_encoded)
+            {
+                m_encoded_segments[first + i + 1] = m_encoded_segments[first + i] + block.encoded_counts[i];
+            }
+        }
+        unit_weights = unit_weights && block.unit_weights;
+    }
+
+    const unsigned int num_bonds = m_segments.back();
+    m_point_indices.resize(m_delta_encoded ? 0 : num_bonds);
+    m_encoded_point_indices.resize(m_encoded_segments.back());
+    m_distances.resize(num_bonds);
+    m_weights.resize(unit_weights ? 0 : num_bonds);
+
+    // Pass 2: copy each block into its range, releasing blocks as they are
+    // copied.
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (size_t block_idx = begin; block_idx < end; ++block_idx)
+        {
+            CompressedBlock& block = blocks[block_idx];
+            const unsigned int first = block_idx * NEIGHBOR_LIST_BLOCK_SIZE;
+            const unsigned int bond_offset = m_segments[first];
+            std::copy(block.distances.begin(), block.distances.end(), m_distances.begin() + bond_offset);
+            if (!unit_weights)
+            {
+                std::copy(block.weights.begin(), block.weights.end(), m_weights.begin() + bond_offset);
+            }
+            if (m_delta_encoded)
+            {
+                std::copy(block.encoded.begin(), block.encoded.end(),
+                          m_encoded_point_indices.begin() + m_encoded_segments[first]);
+            }
+            else
+            {
+                std::copy(block.point_indices.begin(), block.point_indices.end(),
+                          m_point_indices.begin() + bond_offset);
+            }
+            block = CompressedBlock();
+        }
+    });
+}
+
+size_t CompressedNeighborList::getMemoryUsage() const
+{
+    return m_segments.size() * sizeof(unsigned int) + m_point_indices.size() * sizeof(unsigned int)
+        + m_encoded_segments.size() * sizeof(size_t) + m_encoded_point_indices.size() * sizeof(uint8_t)
+        + m_distances.size() * sizeof(float) + m_weights.size() * sizeof(float);
+}
+
+NeighborList* CompressedNeighborList::toNeighborList() const
+{
+    NeighborList* nl = new NeighborList();
+    nl->setNumBonds(getNumBonds(), m_num_query_points, m_num_points);
+    unsigned int* neighbors = nl->getNeighbors().get();
+    float* distances = nl->getDistances().get();
+    float* weights = nl->getWeights().get();
+    util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            unsigned int bond = m_segments[i];
+            for (Cursor cursor(this, i); !cursor.done(); ++bond)
+            {
+                const NeighborBond nb = cursor.next();
+                neighbors[2 * bond] = nb.query_point_idx;
+                neighbors[2 * bond + 1] = nb.point_idx;
+                distances[bond] = nb.distance;
+                weights[bond] = nb.weight;
+            }
+        }
+    });
+    return nl;
+}
+
+void CompressedNeighborList::validate(unsigned int num_query_points, unsigned int num_points) const
+{
+    if (num_query_points != m_num_query_points)
+        throw std::runtime_error("CompressedNeighborList found inconsistent array sizes.");
+    if (num_points != m_num_points)
+        throw std::runtime_error("CompressedNeighborList found inconsistent array sizes.");
+}
+
+CompressedNeighborList::Cursor::Cursor(const CompressedNeighborList* nlist, unsigned int query_point_idx)
+    : m_nlist(nlist), m_query_point_idx(query_point_idx), m_bond(nlist->m_segments[query_point_idx]),
+      m_end(nlist->m_segments[query_point_idx + 1]),
+      m_encoded(nlist->m_delta_encoded ? nlist->m_encoded_point_indices.data()
+                                             + nlist->m_encoded_segments[query_point_idx] :
+                                         NULL),
+      m_point_idx(0)
+{}
+
+NeighborBond CompressedNeighborList::Cursor::next()
+{
+    if (m_nlist->m_delta_encoded)
+    {
+        m_point_idx = decodeDelta(m_point_idx, m_encoded);
+    }
+    else
+    {
+        m_point_idx = m_nlist->m_point_indices[m_bond];
+    }
+    const float weight = m_nlist->m_weights.empty() ? float(1.0) : m_nlist->m_weights[m_bond];
+    const NeighborBond nb(m_query_point_idx, m_point_idx, m_nlist->m_distances[m_bond], weight);
+    ++m_bond;
+    return nb;
+}
+
+}; }; // end namespace freud::locality
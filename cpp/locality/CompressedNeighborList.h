@@ -0,0 +1,196 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef COMPRESSED_NEIGHBOR_LIST_H
+#define COMPRESSED_NEIGHBOR_LIST_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "NeighborBond.h"
+#include "NeighborList.h"
+#include "NeighborPerPointIterator.h"
+#include "NeighborQuery.h"
+
+/*! \file CompressedNeighborList.h
+    \brief Compact storage of the bonds of a NeighborList.
+*/
+
+namespace freud { namespace locality {
+
+//! Store near-neighbor bonds compactly for very large systems
+/*! A CompressedNeighborList holds the same bonds as a NeighborList in much
+    less memory, at the cost of only allowing the bonds of each query point
+    to be read in order.
+
+    <b>Data structures:</b>
+
+    Instead of storing the query point index of every bond, the bonds of each
+    query point are stored contiguously and the first bond of each query
+    point is stored in a CSR-style segments array of length
+    num_query_points + 1. The point indices are either stored as plain
+    unsigned integers, or delta-encoded: each point index is stored as the
+    zigzag-encoded difference to the previous point index of the same query
+    point, written as a variable-length integer (7 bits per byte). Since the
+    bonds of each query point are sorted by point index, the differences are
+    small and most point indices take one to three bytes instead of four. A
+    second segments array then gives the first byte of each query point.
+    Distances are stored as floats, and the weights are only stored if any of
+    them differs from 1.
+
+    For a list of 50 neighbors per point, this takes 6 to 8 bytes per bond
+    instead of the 16 bytes of a NeighborList.
+ */
+class CompressedNeighborList
+{
+public:
+    //! Default constructor
+    CompressedNeighborList();
+
+    //! Compress the bonds of a NeighborList
+    /*! \param nlist The NeighborList to compress.
+     *  \param delta_encode Whether to delta-encode the point indices.
+     */
+    CompressedNeighborList(const NeighborList& nlist, bool delta_encode = true);
+
+    //! Find the bonds of a set of query points and store them compressed
+    /*! The bonds are found in blocks of query points and compressed block by
+     *  block, so the uncompressed bonds of all query points are never held
+     *  in memory at once.
+     *
+     *  \param nq The NeighborQuery to find neighbors with.
+     *  \param query_points The points to find neighbors for.
+     *  \param num_query_points The number of query points.
+     *  \param qargs The query arguments that should be used to find neighbors.
+     *  \param delta_encode Whether to delta-encode the point indices.
+     */
+    CompressedNeighborList(const NeighborQuery* nq, const vec3<float>* query_points,
+                           unsigned int num_query_points, QueryArgs qargs, bool delta_encode = true);
+
+    //! Return the number of bonds stored in this CompressedNeighborList
+    unsigned int getNumBonds() const
+    {
+        return m_segments.empty() ? 0 : m_segments.back();
+    }
+    //! Return the number of query points this CompressedNeighborList was built with
+    unsigned int getNumQueryPoints() const
+    {
+        return m_num_query_points;
+    }
+    //! Return the number of points this CompressedNeighborList was built with
+    unsigned int getNumPoints() const
+    {
+        return m_num_points;
+    }
+    //! Return whether the point indices are delta-encoded
+    bool getDeltaEncoded() const
+    {
+        return m_delta_encoded;
+    }
+    //! Return whether weights are stored (false if all weights are 1)
+    bool hasWeights() const
+    {
+        return !m_weights.empty();
+    }
+
+    //! Return the index of the first bond of a query point
+    unsigned int getSegment(unsigned int query_point_idx) const
+    {
+        return m_segments[query_point_idx];
+    }
+    //! Return the number of bonds of a query point
+    unsigned int getCount(unsigned int query_point_idx) const
+    {
+        return m_segments[query_point_idx + 1] - m_segments[query_point_idx];
+    }
+
+    //! Return the number of bytes used to store the bonds
+    size_t getMemoryUsage() const;
+
+    //! Decompress the bonds into a new NeighborList (the caller is responsible for deleting it)
+    NeighborList* toNeighborList() const;
+
+    //! Throw a runtime_error if num_query_points and num_points do not match the stored values
+    void validate(unsigned int num_query_points, unsigned int num_points) const;
+
+    //! Sequentially decodes the bonds of one query point
+    class Cursor
+    {
+    public:
+        //! Constructor
+        Cursor(const CompressedNeighborList* nlist, unsigned int query_point_idx);
+
+        //! Whether all bonds of the query point have been read
+        bool done() const
+        {
+            return m_bond == m_end;
+        }
+
+        //! Read the next bond (only valid if not done)
+        NeighborBond next();
+
+    private:
+        const CompressedNeighborList* m_nlist; //!< The list being read.
+        unsigned int m_query_point_idx;        //!< The query point whose bonds are read.
+        unsigned int m_bond;                   //!< Index of the next bond.
+        unsigned int m_end;                    //!< One past the index of the last bond of the query point.
+        const uint8_t* m_encoded;              //!< Next byte of the delta-encoded point indices.
+        unsigned int m_point_idx;              //!< The last point index read.
+    };
+
+private:
+    //! Function filling a vector with the bonds of a range of query points, sorted by query point.
+    typedef std::function<void(unsigned int, unsigned int, std::vector<NeighborBond>&)> BondSource;
+
+    //! Compress the bonds of all query points, obtained block by block from a bond source.
+    void build(const BondSource& source);
+
+    unsigned int m_num_query_points;              //!< Number of query points.
+    unsigned int m_num_points;                    //!< Number of points.
+    bool m_delta_encoded;                         //!< Whether the point indices are delta-encoded.
+    std::vector<unsigned int> m_segments;         //!< First bond of each query point, then the bond count.
+    std::vector<unsigned int> m_point_indices;    //!< Point index of each bond (if not delta-encoded).
+    std::vector<size_t> m_encoded_segments;       //!< First byte of each query point (if delta-encoded).
+    std::vector<uint8_t> m_encoded_point_indices; //!< Delta-encoded point indices (if delta-encoded).
+    std::vector<float> m_distances;               //!< Distance of each bond.
+    std::vector<float> m_weights;                 //!< Weight of each bond (empty if all weights are 1).
+};
+
+//! Implementation of per-point finding logic for CompressedNeighborList objects.
+/*! This class reads the bonds of a query point from a CompressedNeighborList
+ *  through the NeighborPerPointIterator interface, so computes can loop over
+ *  compressed lists in the same way as over a NeighborList.
+ */
+class CompressedNeighborListPerPointIterator : public NeighborPerPointIterator
+{
+public:
+    CompressedNeighborListPerPointIterator(const CompressedNeighborList* nlist, size_t point_index)
+        : NeighborPerPointIterator(point_index), m_cursor(nlist, point_index), m_finished(false)
+    {}
+
+    ~CompressedNeighborListPerPointIterator() {}
+
+    virtual NeighborBond next()
+    {
+        if (m_cursor.done())
+        {
+            m_finished = true;
+            return ITERATOR_TERMINATOR;
+        }
+        return m_cursor.next();
+    }
+
+    virtual bool end()
+    {
+        return m_finished;
+    }
+
+private:
+    CompressedNeighborList::Cursor m_cursor; //!< Decodes the bonds of the query point.
+    bool m_finished;                         //!< Whether the terminator has been returned.
+};
+
+}; }; // end namespace freud::locality
+
+#endif // COMPRESSED_NEIGHBOR_LIST_H
@@ -0,0 +1,481 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+#include "KDTree.h"
+#include "NearestNeighborHeap.h"
+#include "utils.h"
+
+/*! \file KDTree.cc
+    \brief Build and query an implicit k-d tree.
+*/
+
+namespace freud { namespace locality {
+
+namespace {
+
+//! Maximum number of pending nodes in a depth-first traversal of a KDTree
+/*! Each level of the tree adds at most one node to the stack, and the tree
+ *  of 2^32 points is 28 levels deep.
+ */
+const unsigned int KDTREE_STACK_SIZE = 64;
+
+//! A node of the tree and its range of points
+struct NodeRange
+{
+    unsigned int node;  //!< Index of the node
+    unsigned int begin; //!< Index of the first point of the node in tree order
+    unsigned int end;   //!< One past the index of the last point of the node in tree order
+};
+
+//! A node of the tree in one periodic image, queued for a best-first search
+struct QueuedNode
+{
+    QueuedNode(float _r_sq, unsigned int _node, unsigned int _begin, unsigned int _end, unsigned int _image)
+        : r_sq(_r_sq), node(_node), begin(_begin), end(_end), image(_image)
+    {}
+
+    //! Order nodes so that the nearest is at the top of a std::priority_queue
+    bool operator<(const QueuedNode& other) const
+    {
+        return r_sq > other.r_sq;
+    }
+
+    float r_sq;         //!< Squared distance from the query point image to the node bounds
+    unsigned int node;  //!< Index of the node
+    unsigned int begin; //!< Index of the first point of the node in tree order
+    unsigned int end;   //!< One past the index of the last point of the node in tree order
+    unsigned int image; //!< Index of the periodic image of the query point
+};
+
+//! Get one component of a vector.
+inline float component(const vec3<float>& v, unsigned int dim)
+{
+    return dim == 0 ? v.x : (dim == 1 ? v.y : v.z);
+}
+
+//! Get the index of the first point of the right child of a node.
+inline unsigned int splitPoint(unsigned int begin, unsigned int end)
+{
+    return begin + (end - begin) / 2;
+}
+
+}; // end anonymous namespace
+
+KDTree::KDTree(const box::Box& box, const vec3<float>* points, unsigned int n_points)
+    : NeighborQuery(box, points, n_points), m_depth(0)
+{
+    // All leaves are at the same depth, which is the smallest depth at which
+    // no leaf holds more than KDTREE_LEAF_SIZE points.
+    while ((static_cast<unsigned long long>(m_n_points) + (1ull << m_depth) - 1) >> m_depth
+           > KDTREE_LEAF_SIZE)
+    {
+        ++m_depth;
+    }
+    const unsigned int num_nodes = (2u << m_depth) - 1;
+    m_node_lower.resize(num_nodes);
+    m_node_upper.resize(num_nodes);
+    m_node_max_index.resize(num_nodes);
+
+    std::vector<vec3<float>> positions(m_n_points);
+    std::vector<vec3<float>> frac(m_n_points);
+    m_point_indices.resize(m_n_points);
+    util::forLoopWrapper(0, m_n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            positions[i] = wrapPeriodic(m_points[i]);
+            frac[i] = m_box.makeFractional(positions[i]);
+            m_point_indices[i] = static_cast<unsigned int>(i);
+        }
+    });
+
+    buildNode(0, 0, m_n_points, 0, frac, positions);
+
+    m_x.resize(m_n_points);
+    m_y.resize(m_n_points);
+    m_z.resize(m_n_points);
+    util::forLoopWrapper(0, m_n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const vec3<float>& position = positions[m_point_indices[i]];
+            m_x[i] = position.x;
+            m_y[i] = position.y;
+            m_z[i] = position.z;
+        }
+    });
+}
+
+void KDTree::buildNode(unsigned int node, unsigned int begin, unsigned int end, unsigned int depth,
+                       const std::vector<vec3<float>>& frac, const std::vector<vec3<float>>& positions)
+{
+    if (depth == m_depth)
+    {
+        const float inf = std::numeric_limits<float>::infinity();
+        vec3<float> lower(inf, inf, inf);
+        vec3<float> upper(-inf, -inf, -inf);
+        unsigned int max_index = 0;
+        for (unsigned int i = begin; i < end; ++i)
+        {
+            max_index = std::max(max_index, m_point_indices[i]);
+            const vec3<float>& position = positions[m_point_indices[i]];
+            lower.x = std::min(lower.x, position.x);
+            lower.y = std::min(lower.y, position.y);
+            lower.z = std::min(lower.z, position.z);
+            upper.x = std::max(upper.x, position.x);
+            upper.y = std::max(upper.y, position.y);
+            upper.z = std::max(upper.z, position.z);
+        }
+        m_node_lower[node] = lower;
+        m_node_upper[node] = upper;
+        m_node_max_index[node] = max_index;
+        return;
+    }
+
+    // Split along the fractional coordinate with the largest extent, measured
+    // as a distance between lattice planes so that the choice does not
+    // depend on the tilt of the box.
+    unsigned int split_dim = 0;
+    if (end > begin)
+    {
+        vec3<float> frac_min(frac[m_point_indices[begin]]);
+        vec3<float> frac_max(frac_min);
+        for (unsigned int i = begin + 1; i < end; ++i)
+        {
+            const vec3<float>& f = frac[m_point_indices[i]];
+            frac_min.x = std::min(frac_min.x, f.x);
+            frac_min.y = std::min(frac_min.y, f.y);
+            frac_min.z = std::min(frac_min.z, f.z);
+            frac_max.x = std::max(frac_max.x, f.x);
+            frac_max.y = std::max(frac_max.y, f.y);
+            frac_max.z = std::max(frac_max.z, f.z);
+        }
+        const vec3<float> extent = (frac_max - frac_min) * m_box.getNearestPlaneDistance();
+        if (extent.y > extent.x)
+        {
+            split_dim = 1;
+        }
+        if (!m_box.is2D() && extent.z > std::max(extent.x, extent.y))
+        {
+            split_dim = 2;
+        }
+    }
+
+    // Partition the points around the median, breaking ties by index so that
+    // the tree does not depend on the order of the input.
+    const unsigned int mid = splitPoint(begin, end);
+    std::nth_element(m_point_indices.begin() + begin, m_point_indices.begin() + mid,
+                     m_point_indices.begin() + end, [&](unsigned int a, unsigned int b) {
+                         const float fa = component(frac[a], split_dim);
+                         const float fb = component(frac[b], split_dim);
+                         return fa < fb || (fa == fb && a < b);
+                     });
+
+    const unsigned int left = 2 * node + 1;
+    const unsigned int right = 2 * node + 2;
+    if (end - begin > KDTREE_SERIAL_POINTS)
+    {
+        tbb::parallel_invoke([&] { buildNode(left, begin, mid, depth + 1, frac, positions); },
+                             [&] { buildNode(right, mid, end, depth + 1, frac, positions); });
+    }
+    else
+    {
+        buildNode(left, begin, mid, depth + 1, frac, positions);
+        buildNode(right, mid, end, depth + 1, frac, positions);
+    }
+
+    const vec3<float>& left_lower = m_node_lower[left];
+    const vec3<float>& left_upper = m_node_upper[left];
+    const vec3<float>& right_lower = m_node_lower[right];
+    const vec3<float>& right_upper = m_node_upper[right];
+    m_node_lower[node] = vec3<float>(std::min(left_lower.x, right_lower.x),
+                                     std::min(left_lower.y, right_lower.y),
+                                     std::min(left_lower.z, right_lower.z));
+    m_node_upper[node] = vec3<float>(std::max(left_upper.x, right_upper.x),
+                                     std::max(left_upper.y, right_upper.y),
+                                     std::max(left_upper.z, right_upper.z));
+    m_node_max_index[node] = std::max(m_node_max_index[left], m_node_max_index[right]);
+}
+
+vec3<float> KDTree::wrapPeriodic(const vec3<float>& position) const
+{
+    const vec3<bool> periodic = m_box.getPeriodic();
+    vec3<float> f = m_box.makeFractional(position);
+    const vec3<float> shift(periodic.x ? std::floor(f.x) : 0, periodic.y ? std::floor(f.y) : 0,
+                            periodic.z ? std::floor(f.z) : 0);
+    vec3<float> wrapped(position);
+    if (shift.x != 0 || shift.y != 0 || (!m_box.is2D() && shift.z != 0))
+    {
+        wrapped = m_box.makeAbsolute(f - shift);
+    }
+    if (m_box.is2D())
+    {
+        wrapped.z = 0;
+    }
+    return wrapped;
+}
+
+void KDTree::getImageVectors(float r_max, bool check_r_max, std::vector<vec3<float>>& image_list) const
+{
+    const vec3<float> nearest_plane_distance = m_box.getNearestPlaneDistance();
+    const vec3<bool> periodic = m_box.getPeriodic();
+    const bool is2D = m_box.is2D();
+    if (check_r_max)
+    {
+        if ((periodic.x && nearest_plane_distance.x <= r_max * 2.0)
+            || (periodic.y && nearest_plane_distance.y <= r_max * 2.0)
+            || (!is2D && periodic.z && nearest_plane_distance.z <= r_max * 2.0))
+        {
+            throw std::runtime_error("The KDTree r_max is too large for this box.");
+        }
+    }
+
+    const vec3<float> latt_a(m_box.getLatticeVector(0));
+    const vec3<float> latt_b(m_box.getLatticeVector(1));
+    const vec3<float> latt_c = is2D ? vec3<float>(0, 0, 0) : vec3<float>(m_box.getLatticeVector(2));
+
+    // The original image always comes first.
+    image_list.clear();
+    image_list.push_back(vec3<float>(0, 0, 0));
+    for (int i = -1; i <= 1; ++i)
+    {
+        for (int j = -1; j <= 1; ++j)
+        {
+            for (int k = -1; k <= 1; ++k)
+            {
+                if ((i == 0 && j == 0 && k == 0) || (i != 0 && !periodic.x) || (j != 0 && !periodic.y)
+                    || (k != 0 && (is2D || !periodic.z)))
+                {
+                    continue;
+                }
+                image_list.push_back(float(i) * latt_a + float(j) * latt_b + float(k) * latt_c);
+            }
+        }
+    }
+}
+
+float KDTree::nodeDistanceSq(unsigned int node, const vec3<float>& position) const
+{
+    const vec3<float>& lower = m_node_lower[node];
+    const vec3<float>& upper = m_node_upper[node];
+    const float dx = std::max(std::max(lower.x - position.x, position.x - upper.x), float(0));
+    const float dy = std::max(std::max(lower.y - position.y, position.y - upper.y), float(0));
+    const float dz = std::max(std::max(lower.z - position.z, position.z - upper.z), float(0));
+    return dx * dx + dy * dy + dz * dz;
+}
+
+std::shared_ptr<NeighborQueryPerPointIterator>
+KDTree::querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const
+{
+    this->validateQueryArgs(args);
+    if (args.mode != QueryArgs::ball && args.mode != QueryArgs::nearest)
+    {
+        throw std::runtime_error("Invalid query mode provided to query function in KDTree.");
+    }
+    // Per-point iterators do not apply the symmetric_half query argument.
+    args.symmetric_half = false;
+    return std::make_shared<KDTreeIterator>(this, query_point, query_point_idx, args);
+}
+
+void KDTree::queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                       QueryArgs args, std::vector<NeighborBond>& bonds) const
+{
+    this->validateQueryArgs(args);
+    if (args.mode != QueryArgs::ball && args.mode != QueryArgs::nearest)
+    {
+        throw std::runtime_error("Invalid query mode provided to query function in KDTree.");
+    }
+
+    // The image vectors only depend on the cutoff, so they are shared by all
+    // query points in the range.
+    std::vector<vec3<float>> image_list;
+    getImageVectors(args.r_max, args.mode == QueryArgs::ball, image_list);
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        if (args.mode == QueryArgs::ball)
+        {
+            findBallNeighbors(query_points[i], i, args, image_list, bonds);
+        }
+        else
+        {
+            findNearestNeighbors(query_points[i], i, args, image_list, bonds);
+        }
+    }
+}
+
+void KDTree::findNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                           const QueryArgs& args, std::vector<NeighborBond>& bonds) const
+{
+    std::vector<vec3<float>> image_list;
+    getImageVectors(args.r_max, args.mode == QueryArgs::ball, image_list);
+    if (args.mode == QueryArgs::ball)
+    {
+        findBallNeighbors(query_point, query_point_idx, args, image_list, bonds);
+    }
+    else
+    {
+        findNearestNeighbors(query_point, query_point_idx, args, image_list, bonds);
+    }
+}
+
+void KDTree::findBallNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                               const QueryArgs& args, const std::vector<vec3<float>>& image_list,
+                               std::vector<NeighborBond>& bonds) const
+{
+    const float r_max_sq = args.r_max * args.r_max;
+    const float r_min_sq = args.r_min * args.r_min;
+    const unsigned int first_leaf = (1u << m_depth) - 1;
+    const vec3<float> pos_i = wrapPeriodic(query_point);
+
+    NodeRange stack[KDTREE_STACK_SIZE];
+    for (std::vector<vec3<float>>::const_iterator image = image_list.begin(); image != image_list.end();
+         ++image)
+    {
+        const vec3<float> pos_i_image = pos_i + *image;
+        unsigned int stack_size = 0;
+        stack[stack_size++] = {0, 0, m_n_points};
+        while (stack_size > 0)
+        {
+            const NodeRange cur = stack[--stack_size];
+            // For half queries, subtrees only containing points with j < i
+            // can be skipped entirely.
+            if ((args.symmetric_half && m_node_max_index[cur.node] < query_point_idx)
+                || nodeDistanceSq(cur.node, pos_i_image) >= r_max_sq)
+            {
+                continue;
+            }
+
+            if (cur.node < first_leaf)
+            {
+                // Push the right child first so that the left child is
+                // searched first.
+                const unsigned int mid = splitPoint(cur.begin, cur.end);
+                stack[stack_size++] = {2 * cur.node + 2, mid, cur.end};
+                stack[stack_size++] = {2 * cur.node + 1, cur.begin, mid};
+                continue;
+            }
+
+            for (unsigned int p = cur.begin; p < cur.end; ++p)
+            {
+                const float dx = m_x[p] - pos_i_image.x;
+                const float dy = m_y[p] - pos_i_image.y;
+                const float dz = m_z[p] - pos_i_image.z;
+                const float r_sq = dx * dx + dy * dy + dz * dz;
+                if (r_sq >= r_max_sq || r_sq < r_min_sq)
+                {
+                    continue;
+                }
+                const unsigned int j = m_point_indices[p];
+                if ((args.exclude_ii && query_point_idx == j) || (args.symmetric_half && j < query_point_idx))
+                {
+                    continue;
+                }
+                bonds.emplace_back(query_point_idx, j, std::sqrt(r_sq));
+            }
+        }
+    }
+}
+
+void KDTree::findNearestNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                                  const QueryArgs& args, const std::vector<vec3<float>>& image_list,
+                                  std::vector<NeighborBond>& bonds) const
+{
+    if (args.num_neighbors == 0 || m_n_points == 0)
+    {
+        return;
+    }
+
+    // Candidates closer than half of the smallest periodic plane distance
+    // are always the minimum image of their point (see NearestNeighborHeap).
+    const vec3<float> plane_distance = m_box.getNearestPlaneDistance();
+    const vec3<bool> periodic = m_box.getPeriodic();
+    float min_plane_distance = std::numeric_limits<float>::infinity();
+    if (periodic.x)
+        min_plane_distance = std::min(min_plane_distance, plane_distance.x);
+    if (periodic.y)
+        min_plane_distance = std::min(min_plane_distance, plane_distance.y);
+    if (!m_box.is2D() && periodic.z)
+        min_plane_distance = std::min(min_plane_distance, plane_distance.z);
+    NearestNeighborHeap heap(query_point_idx, args.num_neighbors, args.r_min,
+                             min_plane_distance * min_plane_distance / float(4.0));
+
+    const float r_max_sq = args.r_max * args.r_max;
+    const unsigned int first_leaf = (1u << m_depth) - 1;
+    const vec3<float> pos_i = wrapPeriodic(query_point);
+
+    std::priority_queue<QueuedNode> queue;
+    for (unsigned int image = 0; image < image_list.size(); ++image)
+    {
+        const float r_sq = nodeDistanceSq(0, pos_i + image_list[image]);
+        if (r_sq < r_max_sq)
+        {
+            queue.push(QueuedNode(r_sq, 0, 0, m_n_points, image));
+        }
+    }
+
+    while (!queue.empty())
+    {
+        const QueuedNode cur = queue.top();
+        // Stop once no unvisited node can contain a closer candidate.
+        if (heap.full() && cur.r_sq > heap.getMaxDistanceSq())
+        {
+            break;
+        }
+        queue.pop();
+
+        const vec3<float> pos_i_image = pos_i + image_list[cur.image];
+        if (cur.node < first_leaf)
+        {
+            const unsigned int mid = splitPoint(cur.begin, cur.end);
+            const float left_r_sq = nodeDistanceSq(2 * cur.node + 1, pos_i_image);
+            if (left_r_sq < r_max_sq)
+            {
+                queue.push(QueuedNode(left_r_sq, 2 * cur.node + 1, cur.begin, mid, cur.image));
+            }
+            const float right_r_sq = nodeDistanceSq(2 * cur.node + 2, pos_i_image);
+            if (right_r_sq < r_max_sq)
+            {
+                queue.push(QueuedNode(right_r_sq, 2 * cur.node + 2, mid, cur.end, cur.image));
+            }
+            continue;
+        }
+
+        for (unsigned int p = cur.begin; p < cur.end; ++p)
+        {
+            const float dx = m_x[p] - pos_i_image.x;
+            const float dy = m_y[p] - pos_i_image.y;
+            const float dz = m_z[p] - pos_i_image.z;
+            const float r_sq = dx * dx + dy * dy + dz * dz;
+            const unsigned int j = m_point_indices[p];
+            if (r_sq < r_max_sq && !(args.exclude_ii && query_point_idx == j))
+            {
+                heap.add(j, r_sq);
+            }
+        }
+    }
+
+    heap.finish(bonds);
+}
+
+NeighborBond KDTreeIterator::next()
+{
+    if (!m_searched)
+    {
+        m_kdtree->findNeighbors(m_query_point, m_query_point_idx, m_args, m_current_neighbors);
+        m_searched = true;
+    }
+
+    if (m_count < m_current_neighbors.size())
+    {
+        return m_current_neighbors[m_count++];
+    }
+
+    m_finished = true;
+    return NeighborQueryIterator::ITERATOR_TERMINATOR;
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,162 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include <memory>
+#include <vector>
+
+#include "Box.h"
+#include "NeighborQuery.h"
+
+/*! \file KDTree.h
+    \brief Defines a NeighborQuery based on an implicit k-d tree.
+*/
+
+namespace freud { namespace locality {
+
+const unsigned int KDTREE_LEAF_SIZE = 16;       //!< Maximum number of points in a leaf of a KDTree
+const unsigned int KDTREE_SERIAL_POINTS = 4096; //!< Subtrees with fewer points are built serially
+
+//! Find neighbors with an implicit k-d tree.
+/*! The tree is balanced and stored implicitly: node n has children 2n + 1 and
+ *  2n + 2, every internal node splits its range of points in half, and all
+ *  leaves are at the same depth. The range of points of each node therefore
+ *  follows from its position in the tree, and only the bounding box of each
+ *  node is stored. The points are stored in tree order as separate
+ *  coordinate arrays, so the points of each leaf are contiguous in memory.
+ *
+ *  Points are wrapped into the box in fractional coordinates, and each node
+ *  is split at the median of the fractional coordinate along which its
+ *  points are most spread out (measured as a distance between lattice
+ *  planes). This supports triclinic boxes and adapts the tree to strongly
+ *  inhomogeneous systems, such as interfaces and gels, where cell lists are
+ *  inefficient. Subtrees are built in parallel.
+ *
+ *  Periodic boundaries are treated by querying all images of the query point
+ *  within one box length, as in AABBQuery. Ball queries traverse the tree
+ *  depth-first, and nearest neighbor queries traverse it best-first.
+ */
+class KDTree : public NeighborQuery
+{
+public:
+    //! Nullary constructor for Cython
+    KDTree() : m_depth(0) {}
+
+    //! Constructor
+    /*! \param box The simulation box.
+     *  \param points The points to build the tree from.
+     *  \param n_points The number of points.
+     */
+    KDTree(const box::Box& box, const vec3<float>* points, unsigned int n_points);
+
+    //! Destructor
+    ~KDTree() {}
+
+    //! Implementation of per-particle query for KDTree (see NeighborQuery.h for documentation).
+    /*! \param query_point The point to find neighbors for.
+     *  \param query_point_idx The index of the query point.
+     *  \param args The query arguments that should be used to find neighbors.
+     */
+    virtual std::shared_ptr<NeighborQueryPerPointIterator>
+    querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const;
+
+    //! Implementation of bulk query for KDTree (see NeighborQuery.h for documentation).
+    virtual void queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                           QueryArgs args, std::vector<NeighborBond>& bonds) const;
+
+    //! Find the neighbors of a single query point.
+    /*! This is used by both querySingle and queryBulk, so both find the
+     *  neighbors in the same order.
+     *
+     *  \param query_point The point to find neighbors for.
+     *  \param query_point_idx The index of the query point.
+     *  \param args The (validated) query arguments.
+     *  \param bonds The buffer to append bonds to.
+     */
+    void findNeighbors(const vec3<float>& query_point, unsigned int query_point_idx, const QueryArgs& args,
+                       std::vector<NeighborBond>& bonds) const;
+
+    //! Get the number of nodes in the tree
+    unsigned int getNumNodes() const
+    {
+        return static_cast<unsigned int>(m_node_lower.size());
+    }
+
+    //! Get the depth of the leaves of the tree (zero if the root is a leaf)
+    unsigned int getDepth() const
+    {
+        return m_depth;
+    }
+
+private:
+    //! Sort the points of a node into its subtree and compute the node bounds.
+    void buildNode(unsigned int node, unsigned int begin, unsigned int end, unsigned int depth,
+                   const std::vector<vec3<float>>& frac, const std::vector<vec3<float>>& positions);
+
+    //! Wrap a position into the box along its periodic directions.
+    vec3<float> wrapPeriodic(const vec3<float>& position) const;
+
+    //! Compute the periodic image vectors of the query point to search.
+    /*! \param r_max The query cutoff distance.
+     *  \param check_r_max If true, throw an error if r_max is too large for the box.
+     *  \param image_list The vector to store the image vectors in.
+     */
+    void getImageVectors(float r_max, bool check_r_max, std::vector<vec3<float>>& image_list) const;
+
+    //! Find all neighbors of a query point within a ball.
+    void findBallNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                           const QueryArgs& args, const std::vector<vec3<float>>& image_list,
+                           std::vector<NeighborBond>& bonds) const;
+
+    //! Find the nearest neighbors of a query point.
+    void findNearestNeighbors(const vec3<float>& query_point, unsigned int query_point_idx,
+                              const QueryArgs& args, const std::vector<vec3<float>>& image_list,
+                              std::vector<NeighborBond>& bonds) const;
+
+    //! Squared distance from a position to the bounding box of a node.
+    float nodeDistanceSq(unsigned int node, const vec3<float>& position) const;
+
+    unsigned int m_depth;                       //!< Depth of the leaves of the tree.
+    std::vector<unsigned int> m_point_indices;  //!< Indices of the points in tree order.
+    std::vector<float> m_x;                     //!< x coordinates of the wrapped points in tree order.
+    std::vector<float> m_y;                     //!< y coordinates of the wrapped points in tree order.
+    std::vector<float> m_z;                     //!< z coordinates of the wrapped points in tree order.
+    std::vector<vec3<float>> m_node_lower;      //!< Lower corner of the bounding box of each node.
+    std::vector<vec3<float>> m_node_upper;      //!< Upper corner of the bounding box of each node.
+    std::vector<unsigned int> m_node_max_index; //!< Largest point index in each node.
+};
+
+//! Iterator that returns the neighbors of a point found by a KDTree.
+/*! This iterator is not truly lazy; it finds all neighbors of the point the
+ *  first time next is called, then returns them one-by-one.
+ */
+class KDTreeIterator : public NeighborQueryPerPointIterator
+{
+public:
+    //! Constructor
+    KDTreeIterator(const KDTree* neighbor_query, const vec3<float> query_point, unsigned int query_point_idx,
+                   const QueryArgs& args)
+        : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, args.r_max, args.r_min,
+                                        args.exclude_ii),
+          m_kdtree(neighbor_query), m_args(args), m_searched(false), m_count(0)
+    {}
+
+    //! Empty Destructor
+    virtual ~KDTreeIterator() {}
+
+    //! Get the next element.
+    virtual NeighborBond next();
+
+protected:
+    const KDTree* m_kdtree;                        //!< Link to the KDTree object.
+    QueryArgs m_args;                              //!< The query arguments.
+    bool m_searched;                               //!< Whether the neighbors have been found.
+    unsigned int m_count;                          //!< Number of neighbors returned for the current point.
+    std::vector<NeighborBond> m_current_neighbors; //!< The neighbors of the current point.
+};
+
+}; }; // end namespace freud::locality
+
+#endif // KDTREE_H
@@ -2,6 +2,7 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <stdexcept>
 
@@ -23,11 +24,11 @@ namespace freud { namespace locality {
  ********************/
 void IteratorLinkCell::copy(const IteratorLinkCell& rhs)
 {
-    m_cell_list = rhs.m_cell_list;
-    m_Np = rhs.m_Np;
-    m_Nc = rhs.m_Nc;
+    m_cell_point_indices = rhs.m_cell_point_indices;
+    m_first = rhs.m_first;
+    m_last = rhs.m_last;
+    m_pos = rhs.m_pos;
     m_cur_idx = rhs.m_cur_idx;
-    m_cell = rhs.m_cell;
 }
 
 bool IteratorLinkCell::atEnd()
@@ -37,15 +38,22 @@ bool IteratorLinkCell::atEnd()
 
 unsigned int IteratorLinkCell::next()
 {
-    m_cur_idx = m_cell_list[m_cur_idx];
+    if (m_pos < m_last)
+    {
+        m_cur_idx = m_cell_point_indices.get()[m_pos];
+        ++m_pos;
+    }
+    else
+    {
+        m_cur_idx = LINK_CELL_TERMINATOR;
+    }
     return m_cur_idx;
 }
 
 unsigned int IteratorLinkCell::begin()
 {
-    m_cur_idx = m_Np + m_cell;
-    m_cur_idx = m_cell_list[m_cur_idx];
-    return m_cur_idx;
+    m_pos = m_first;
+    return next();
 }
 
 /*********************
@@ -207,10 +215,14 @@ void IteratorCellShell::reset(unsigned int range)
  ********************/
 
 // Default constructor
-LinkCell::LinkCell() : NeighborQuery(), m_n_points(0), m_cell_width(0), m_celldim(0, 0, 0) {}
-
-LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width)
-    : NeighborQuery(box, points, n_points), m_n_points(0), m_cell_width(cell_width), m_celldim(0, 0, 0)
+LinkCell::LinkCell()
+    : NeighborQuery(), m_n_points(0), m_cell_width(0), m_deterministic(true), m_celldim(0, 0, 0)
+{}
+
+LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width,
+                   bool deterministic)
+    : NeighborQuery(box, points, n_points), m_n_points(0), m_cell_width(cell_width),
+      m_deterministic(deterministic), m_celldim(0, 0, 0)
 {
     // If no cell width is provided, we calculate the system density and
     // estimate the number of cells that would lead to 10 particles per cell.
@@ -306,23 +318,85 @@ void LinkCell::computeCellList(const vec3<float>* points, unsigned int n_points)
 
     // determine the number of cells and allocate memory
     unsigned int Nc = getNumCells();
-    m_cell_list.prepare(n_points + Nc);
+    m_cell_starts.prepare(Nc + 1);
+    m_cell_point_indices.prepare(n_points);
+    m_cell_points_x.prepare(n_points);
+    m_cell_points_y.prepare(n_points);
+    m_cell_points_z.prepare(n_points);
     m_n_points = n_points;
     m_Nc = Nc;
 
-    // initialize memory
-    for (unsigned int cell = 0; cell < Nc; cell++)
-    {
-        m_cell_list[n_points + cell] = LINK_CELL_TERMINATOR;
-    }
+    // Counting sort of the particles by cell, performed in parallel. First
+    // find the cell of each particle and count the particles in each cell.
+    std::vector<unsigned int> point_cells(n_points);
+    std::vector<std::atomic<unsigned int>> cell_counts(Nc);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            point_cells[i] = getCell(points[i]);
+            cell_counts[point_cells[i]].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // The exclusive prefix sum of the counts gives the start of each cell.
+    unsigned int* cell_starts = m_cell_starts.get();
+    tbb::parallel_scan(
+        tbb::blocked_range<size_t>(0, Nc), static_cast<unsigned int>(0),
+        [&](const tbb::blocked_range<size_t>& r, unsigned int sum, bool is_final_scan) {
+            for (size_t cell = r.begin(); cell < r.end(); ++cell)
+            {
+                sum += cell_counts[cell].load(std::memory_order_relaxed);
+                if (is_final_scan)
+                {
+                    cell_starts[cell + 1] = sum;
+                }
+            }
+            return sum;
+        },
+        [](unsigned int left, unsigned int right) { return left + right; });
+
+    // Scatter the particles into their cells, reusing the counts as the
+    // insertion cursor of each cell.
+    util::forLoopWrapper(0, Nc, [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell)
+        {
+            cell_counts[cell].store(cell_starts[cell], std::memory_order_relaxed);
+        }
+    });
+    unsigned int* cell_point_indices = m_cell_point_indices.get();
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            cell_point_indices[cell_counts[point_cells[i]].fetch_add(1, std::memory_order_relaxed)] = i;
+        }
+    });
 
-    // generate the cell list
-    for (int i = n_points - 1; i >= 0; i--)
+    // The parallel scatter does not preserve the order of the particles
+    // within a cell. Cells are small, so sorting them restores the order of
+    // a serial counting sort at little cost.
+    if (m_deterministic)
     {
-        unsigned int cell = getCell(points[i]);
-        m_cell_list[i] = m_cell_list[n_points + cell];
-        m_cell_list[n_points + cell] = i;
+        util::forLoopWrapper(0, Nc, [&](size_t begin, size_t end) {
+            for (size_t cell = begin; cell < end; ++cell)
+            {
+                std::sort(cell_point_indices + cell_starts[cell], cell_point_indices + cell_starts[cell + 1]);
+            }
+        });
     }
+
+    // Store the coordinates in cell order.
+    float* x = m_cell_points_x.get();
+    float* y = m_cell_points_y.get();
+    float* z = m_cell_points_z.get();
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+        {
+            const vec3<float>& p = points[cell_point_indices[k]];
+            x[k] = p.x;
+            y[k] = p.y;
+            z[k] = p.z;
+        }
+    });
 }
 
 vec3<unsigned int> LinkCell::indexToCoord(unsigned int x) const
@@ -461,6 +535,142 @@ const std::vector<unsigned int>& LinkCell::computeCellNeighbors(unsigned int cur
     return a->second;
 }
 
+const std::vector<CellStencilEntry>& LinkCell::getStencil(float r_max) const
+{
+    // check if the stencil has been already computed
+    // return it if it has
+    // otherwise, compute it (holding the lock so that other threads wait
+    // rather than computing it again) and return
+    // Stencils are keyed on the number of shells rather than on r_max, so
+    // there are at most as many of them as shells in the cell list.
+    const int range = getStencilRange(r_max);
+    CellStencils::const_accessor ca;
+    if (m_stencils.find(ca, range))
+    {
+        return ca->second;
+    }
+    ca.release();
+
+    CellStencils::accessor a;
+    if (m_stencils.insert(a, range))
+    {
+        a->second = computeStencil(range);
+    }
+    return a->second;
+}
+
+const std::vector<CellStencilEntry>& LinkCell::getSortedStencil(float r_max) const
+{
+    const int range = getStencilRange(r_max);
+    CellStencils::const_accessor ca;
+    if (m_sorted_stencils.find(ca, range))
+    {
+        return ca->second;
+    }
+    ca.release();
+
+    CellStencils::accessor a;
+    if (m_sorted_stencils.insert(a, range))
+    {
+        // The stable sort keeps the query point's cell (the only entry with
+        // a minimum distance of zero that is guaranteed to exist) first.
+        a->second = getStencil(r_max);
+        std::stable_sort(a->second.begin(), a->second.end(),
+                         [](const CellStencilEntry& first, const CellStencilEntry& second) {
+                             return first.min_distance < second.min_distance;
+                         });
+    }
+    return a->second;
+}
+
+int LinkCell::getStencilRange(float r_max) const
+{
+    const bool is2D = m_box.is2D();
+    const vec3<int> dim(m_celldim.x, m_celldim.y, m_celldim.z);
+    const vec3<float> plane_distance = m_box.getNearestPlaneDistance();
+    float min_width = std::min(plane_distance.x / float(dim.x), plane_distance.y / float(dim.y));
+    if (!is2D)
+    {
+        min_width = std::min(min_width, plane_distance.z / float(dim.z));
+    }
+
+    // A cell in shell R is separated from the central cell by at least R - 1
+    // cells along some axis, so no shell beyond the returned range can
+    // contain points within r_max. We also never need shells beyond those
+    // covering the whole (periodic) cell list.
+    int full_range = std::max(dim.x, dim.y) / 2;
+    if (!is2D)
+    {
+        full_range = std::max(full_range, dim.z / 2);
+    }
+    if (r_max / min_width < float(full_range))
+    {
+        return std::min(static_cast<int>(r_max / min_width) + 1, full_range);
+    }
+    return full_range;
+}
+
+std::vector<CellStencilEntry> LinkCell::computeStencil(int range) const
+{
+    const bool is2D = m_box.is2D();
+    const vec3<int> dim(m_celldim.x, m_celldim.y, m_celldim.z);
+
+    // The cells are parallelepipeds whose widths (the distances between their
+    // faces) are the nearest plane distances divided by the number of cells.
+    const vec3<float> plane_distance = m_box.getNearestPlaneDistance();
+    const vec3<float> widths(plane_distance.x / float(dim.x), plane_distance.y / float(dim.y),
+                             is2D ? float(0) : plane_distance.z / float(dim.z));
+    const bool orthorhombic = (m_box.getTiltFactorXY() == 0) && (m_box.getTiltFactorXZ() == 0)
+        && (m_box.getTiltFactorYZ() == 0);
+
+    // Computes the lower bound on the distance between two points in cells
+    // separated by some number of cells along one axis, using the closest
+    // periodic image of the offset.
+    auto axis_gap = [](int offset, int n, float width) {
+        int d = offset % n;
+        d += (d < 0) ? n : 0;
+        d = std::min(d, n - d);
+        return float(std::max(d - 1, 0)) * width;
+    };
+
+    std::vector<CellStencilEntry> stencil;
+    std::unordered_set<unsigned int> seen_cells;
+    for (IteratorCellShell iter(0, is2D); iter.getRange() <= range; ++iter)
+    {
+        const vec3<int> offset(*iter);
+        vec3<unsigned int> reduced_offset;
+        reduced_offset.x = static_cast<unsigned int>(((offset.x % dim.x) + dim.x) % dim.x);
+        reduced_offset.y = static_cast<unsigned int>(((offset.y % dim.y) + dim.y) % dim.y);
+        reduced_offset.z = static_cast<unsigned int>(((offset.z % dim.z) + dim.z) % dim.z);
+
+        // In small cell lists, different offsets may refer to the same cell.
+        if (!seen_cells.insert(getStencilCell(vec3<unsigned int>(0, 0, 0), reduced_offset)).second)
+        {
+            continue;
+        }
+
+        // Any point pair in the two cells must be separated along each
+        // lattice direction by at least the gap between the cells. For
+        // orthorhombic boxes these directions are orthogonal, so the gaps can
+        // be combined; otherwise, the largest one is a valid bound.
+        const float gap_x = axis_gap(offset.x, dim.x, widths.x);
+        const float gap_y = axis_gap(offset.y, dim.y, widths.y);
+        const float gap_z = is2D ? float(0) : axis_gap(offset.z, dim.z, widths.z);
+        float min_distance;
+        if (orthorhombic)
+        {
+            min_distance = std::sqrt(gap_x * gap_x + gap_y * gap_y + gap_z * gap_z);
+        }
+        else
+        {
+            min_distance = std::max(gap_x, std::max(gap_y, gap_z));
+        }
+
+        stencil.emplace_back(reduced_offset, min_distance);
+    }
+    return stencil;
+}
+
 std::shared_ptr<NeighborQueryPerPointIterator>
 LinkCell::querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const
 {
@@ -481,17 +691,99 @@ LinkCell::querySingle(const vec3<float> query_point, unsigned int query_point_id
     }
 }
 
+void LinkCell::queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                         QueryArgs args, std::vector<NeighborBond>& bonds) const
+{
+    this->validateQueryArgs(args);
+    if (args.mode != QueryArgs::ball)
+    {
+        NeighborQuery::queryBulk(query_points, begin, end, args, bonds);
+        return;
+    }
+
+    // Choose the wrapping arithmetic once for the whole batch.
+    switch (box::getWrapPolicy(m_box))
+    {
+    case box::OrthorhombicWrapPolicy:
+        queryBallBulk(box::OrthorhombicWrap(m_box), query_points, begin, end, args, bonds);
+        break;
+    case box::Orthorhombic2DWrapPolicy:
+        queryBallBulk(box::Orthorhombic2DWrap(m_box), query_points, begin, end, args, bonds);
+        break;
+    default:
+        queryBallBulk(box::TriclinicWrap(m_box), query_points, begin, end, args, bonds);
+    }
+}
+
+template<typename WrapPolicy>
+void LinkCell::queryBallBulk(const WrapPolicy& wrap, const vec3<float>* query_points, unsigned int begin,
+                             unsigned int end, const QueryArgs& args, std::vector<NeighborBond>& bonds) const
+{
+    const float r_max_sq = args.r_max * args.r_max;
+    const float r_min_sq = args.r_min * args.r_min;
+    const unsigned int* cell_starts = m_cell_starts.get();
+    const unsigned int* cell_point_indices = m_cell_point_indices.get();
+    const float* x = m_cell_points_x.get();
+    const float* y = m_cell_points_y.get();
+    const float* z = m_cell_points_z.get();
+    const std::vector<CellStencilEntry>& stencil = getStencil(args.r_max);
+
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        const vec3<float> query_point(query_points[i]);
+        const vec3<unsigned int> point_cell(getCellCoord(query_point));
+
+        // Loop over the stencil of cells that may contain neighbors, visiting
+        // cells in the same order as LinkCellQueryBallIterator.
+        for (std::vector<CellStencilEntry>::const_iterator entry = stencil.begin(); entry != stencil.end();
+             ++entry)
+        {
+            if (entry->min_distance >= args.r_max)
+            {
+                continue;
+            }
+            const unsigned int cell = getStencilCell(point_cell, entry->offset);
+
+            // The particles of the cell are contiguous in the cell-ordered arrays.
+            const unsigned int cell_end = cell_starts[cell + 1];
+            unsigned int cell_begin = cell_starts[cell];
+
+            // For half queries, we only need the particles with j >= i. If the
+            // particles in each cell are sorted, we can skip directly to them.
+            if (args.symmetric_half && m_deterministic)
+            {
+                cell_begin = static_cast<unsigned int>(
+                    std::lower_bound(cell_point_indices + cell_begin, cell_point_indices + cell_end, i)
+                    - cell_point_indices);
+            }
+
+            for (unsigned int k = cell_begin; k < cell_end; ++k)
+            {
+                const unsigned int j = cell_point_indices[k];
+                if ((args.exclude_ii && i == j) || (args.symmetric_half && j < i))
+                {
+                    continue;
+                }
+
+                const vec3<float> r_ij(wrap(vec3<float>(x[k], y[k], z[k]) - query_point));
+                const float r_sq(dot(r_ij, r_ij));
+
+                if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                {
+                    bonds.emplace_back(i, j, std::sqrt(r_sq));
+                }
+            }
+        }
+    }
+}
+
 NeighborBond LinkCellQueryBallIterator::next()
 {
     float r_max_sq = m_r_max * m_r_max;
     float r_min_sq = m_r_min * m_r_min;
 
-    vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
-    const unsigned int point_cell_index = m_linkcell->getCellIndex(
-        vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-    m_searched_cells.insert(point_cell_index);
-
-    // Loop over cell list neighbor shells relative to this point's cell.
+    // Loop over the stencil of cells that may contain neighbors. The cell
+    // iterator starts in the query point's cell, the first stencil entry.
     while (true)
     {
         // Iterate over the particles in that cell. Using a local counter
@@ -514,137 +806,82 @@ NeighborBond LinkCellQueryBallIterator::next()
             }
         }
 
-        bool out_of_range = false;
-
-        while (true)
+        // Skip the cells of the stencil that are too far away.
+        do
         {
-            // Determine the next neighbor cell to consider. We're done if we
-            // reach a new shell and the closest point of approach to the new
-            // shell is greater than our r_max.
-            ++m_neigh_cell_iter;
-
-            if ((m_neigh_cell_iter.getRange() - m_extra_search_width) * m_linkcell->getCellWidth() > m_r_max)
-            {
-                out_of_range = true;
-                break;
-            }
-
-            const unsigned int neighbor_cell_index = m_linkcell->getCellIndex(
-                vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-            // Insertion to an unordered set returns a pair, the second
-            // element indicates insertion success or failure (if it
-            // already exists)
-            if (m_searched_cells.insert(neighbor_cell_index).second)
-            {
-                // This cell has not been searched yet, so we will iterate
-                // over its contents. Otherwise, we loop back, increment
-                // the cell shell iterator, and try the next one.
-                m_cell_iter = m_linkcell->itercell(neighbor_cell_index);
-                break;
-            }
-        }
-        if (out_of_range)
+            ++m_stencil_idx;
+        } while (m_stencil_idx < m_stencil->size() && (*m_stencil)[m_stencil_idx].min_distance >= m_r_max);
+        if (m_stencil_idx >= m_stencil->size())
         {
             break;
         }
+        m_cell_iter = m_linkcell->itercell(
+            m_linkcell->getStencilCell(m_point_cell, (*m_stencil)[m_stencil_idx].offset));
     }
 
     m_finished = true;
     return NeighborQueryIterator::ITERATOR_TERMINATOR;
 }
 
-NeighborBond LinkCellQueryIterator::next()
+void LinkCellQueryIterator::findNeighbors()
 {
-    float r_max_sq = m_r_max * m_r_max;
-    float r_min_sq = m_r_min * m_r_min;
-
-    vec3<float> plane_distance = m_neighbor_query->getBox().getNearestPlaneDistance();
-    float min_plane_distance = std::min(plane_distance.x, plane_distance.y);
-    if (!m_neighbor_query->getBox().is2D())
+    if (m_num_neighbors == 0)
     {
-        min_plane_distance = std::min(min_plane_distance, plane_distance.z);
+        return;
     }
-    unsigned int max_range = ceil(min_plane_distance / (2 * m_linkcell->getCellWidth())) + 1;
-
-    vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
-    const unsigned int point_cell_index = m_linkcell->getCellIndex(
-        vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-    m_searched_cells.insert(point_cell_index);
 
-    // Loop over cell list neighbor shells relative to this point's cell.
-    if (!m_current_neighbors.size())
+    const float r_max_sq = m_r_max * m_r_max;
+    const box::Box& box = m_neighbor_query->getBox();
+    const std::vector<CellStencilEntry>& stencil = m_linkcell->getSortedStencil(m_r_max);
+    const vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
+    // Each cell in the stencil is distinct, so every point is found at most once.
+    NearestNeighborHeap heap(m_query_point_idx, m_num_neighbors, m_r_min);
+    for (std::vector<CellStencilEntry>::const_iterator entry = stencil.begin(); entry != stencil.end();
+         ++entry)
     {
-        // Expand search cell radius until termination conditions are met.
-        while (m_neigh_cell_iter != IteratorCellShell(max_range, m_neighbor_query->getBox().is2D()))
+        // Since the stencil is sorted, once a cell cannot contain points
+        // closer than the farthest candidate or r_max, no later cell can
+        // either.
+        if ((heap.full() && entry->min_distance * entry->min_distance > heap.getMaxDistanceSq())
+            || entry->min_distance >= m_r_max)
         {
-            // Iterate over the particles in that cell. Using a local counter
-            // variable is safe, because the IteratorLinkCell object is keeping
-            // track between calls to next. However, we have to add an extra
-            // check outside to proof ourselves against returning after
-            // previous calls to next that have not yet reset the iterator.
-            if (!m_cell_iter.atEnd())
-            {
-                for (unsigned int j = m_cell_iter.next(); !m_cell_iter.atEnd(); j = m_cell_iter.next())
-                {
-                    // Skip ii matches immediately if requested.
-                    if (m_exclude_ii && m_query_point_idx == j)
-                    {
-                        continue;
-                    }
-                    const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
-                    const float r_sq(dot(r_ij, r_ij));
-                    if (r_sq < r_max_sq && r_sq >= r_min_sq)
-                        m_current_neighbors.emplace_back(m_query_point_idx, j, sqrt(r_sq));
-                }
-            }
+            break;
+        }
 
-            while (true)
+        LinkCell::iteratorcell cell_iter
+            = m_linkcell->itercell(m_linkcell->getStencilCell(point_cell, entry->offset));
+        for (unsigned int j = cell_iter.next(); !cell_iter.atEnd(); j = cell_iter.next())
+        {
+            // Skip ii matches immediately if requested.
+            if (m_exclude_ii && m_query_point_idx == j)
             {
-                ++m_neigh_cell_iter;
-
-                if (m_neigh_cell_iter == IteratorCellShell(max_range, m_neighbor_query->getBox().is2D()))
-                {
-                    break;
-                }
-
-                const unsigned int neighbor_cell_index = m_linkcell->getCellIndex(
-                    vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-                // Insertion to an unordered set returns a pair, the second
-                // element indicates insertion success or failure (if it
-                // already exists)
-                if (m_searched_cells.insert(neighbor_cell_index).second)
-                {
-                    // This cell has not been searched yet, so we will
-                    // iterate over its contents. Otherwise, we loop back,
-                    // increment the cell shell iterator, and try the next
-                    // one.
-                    m_cell_iter = m_linkcell->itercell(neighbor_cell_index);
-                    break;
-                }
+                continue;
             }
 
-            // We can terminate early if we determine when we reach a shell
-            // such that we already have k neighbors closer than the
-            // closest possible neighbor in the new shell.
-            std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
-            if ((m_current_neighbors.size() >= m_num_neighbors)
-                && (m_current_neighbors[m_num_neighbors - 1].distance
-                    < (m_neigh_cell_iter.getRange() - 1) * m_linkcell->getCellWidth()))
+            const vec3<float> r_ij(box.wrap((*m_linkcell)[j] - m_query_point));
+            const float r_sq(dot(r_ij, r_ij));
+            if (r_sq < r_max_sq)
             {
-                break;
+                heap.add(j, r_sq);
             }
         }
     }
+    heap.finish(m_current_neighbors);
+}
 
-    while ((m_count < m_num_neighbors) && (m_count < m_current_neighbors.size()))
+NeighborBond LinkCellQueryIterator::next()
+{
+    // This iterator is not truly lazy; the nearest neighbors are found and
+    // sorted the first time next is called, then returned one-by-one.
+    if (!m_searched)
     {
-        m_count++;
-        if (m_current_neighbors[m_count - 1].distance > m_r_max)
-        {
-            m_finished = true;
-            return NeighborQueryIterator::ITERATOR_TERMINATOR;
-        }
-        return m_current_neighbors[m_count - 1];
+        findNeighbors();
+        m_searched = true;
+    }
+
+    if (m_count < m_current_neighbors.size())
+    {
+        return m_current_neighbors[m_count++];
     }
 
     m_finished = true;
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "Box.h"
+#include "NearestNeighborHeap.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
 
@@ -20,21 +21,17 @@
 namespace freud { namespace locality {
 
 /*! \internal
-    \brief Signifies the end of the linked list
+    \brief Signifies the end of the particles in a cell
 */
 const unsigned int LINK_CELL_TERMINATOR = 0xffffffff;
 
-//! Iterates over particles in a link cell list generated by LinkCell
-/*! The link-cell structure is not trivial to iterate over. This helper class
- *  makes that easier both in C++ and provides a Python compatible interface
- *  for direct usage there. An IteratorLinkCell is given the bare essentials
- *  it needs to iterate over a given cell, the cell list, the number of
- *  particles, number of cells and the cell to iterate over. Call next() to
- *  get the index of the next particle in the cell, atEnd() will return true
- *  if you are at the end. In C++, next() will crash the code if you attempt
- *  to iterate past the end (no bounds checking for performance). When called
- *  from Python, a different version of next() is used that will throw
- *  StopIteration at the end.
+//! Iterates over particles in a cell list generated by LinkCell
+/*! This helper class provides a simple interface for iterating over the
+ *  particles in a single cell. An IteratorLinkCell is given the bare
+ *  essentials it needs to iterate over a given cell, the array of particle
+ *  indices sorted by cell and the range of that array belonging to the cell
+ *  to iterate over. Call next() to get the index of the next particle in the
+ *  cell, atEnd() will return true if you are at the end.
  *
  *  A loop over all of the particles in a cell can be accomplished with the
  *   following code in C++.
@@ -52,15 +49,12 @@ const unsigned int LINK_CELL_TERMINATOR = 0xffffffff;
 class IteratorLinkCell
 {
 public:
-    IteratorLinkCell() : m_Np(0), m_Nc(0), m_cur_idx(LINK_CELL_TERMINATOR), m_cell(0) {}
+    IteratorLinkCell() : m_first(0), m_last(0), m_pos(0), m_cur_idx(LINK_CELL_TERMINATOR) {}
 
-    IteratorLinkCell(const util::ManagedArray<unsigned int> cell_list, unsigned int Np, unsigned int Nc,
-                     unsigned int cell)
-        : m_cell_list(cell_list), m_Np(Np), m_Nc(Nc)
-    {
-        m_cell = cell;
-        m_cur_idx = m_Np + cell;
-    }
+    IteratorLinkCell(const util::ManagedArray<unsigned int> cell_point_indices, unsigned int first,
+                     unsigned int last)
+        : m_cell_point_indices(cell_point_indices), m_first(first), m_last(last), m_pos(first), m_cur_idx(0)
+    {}
 
     //! Copy the position of rhs into this object
     void copy(const IteratorLinkCell& rhs);
@@ -75,11 +69,11 @@ public:
     unsigned int begin();
 
 private:
-    util::ManagedArray<unsigned int> m_cell_list; //!< The cell list
-    unsigned int m_Np;                            //!< Number of particles in the cell list
-    unsigned int m_Nc;                            //!< Number of cells in the cell list
-    unsigned int m_cur_idx;                       //!< Current index
-    unsigned int m_cell;                          //!< Cell being considered
+    util::ManagedArray<unsigned int> m_cell_point_indices; //!< Particle indices sorted by cell
+    unsigned int m_first;   //!< Position of the first particle of the cell in m_cell_point_indices
+    unsigned int m_last;    //!< One past the position of the last particle of the cell
+    unsigned int m_pos;     //!< Position of the next particle to return
+    unsigned int m_cur_idx; //!< Current particle index
 };
 
 //! Iterates over sets of shells in a cell list
@@ -147,9 +141,24 @@ private:
     bool m_is2D;     //!< true if the cell list is 2D
 };
 
+//! An entry of a precomputed stencil of neighbor cells.
+/*! The offset is stored reduced modulo the cell list dimensions, so the
+ *  neighbor of the cell with coordinates c is (c + offset) modulo the
+ *  dimensions, which only requires a conditional subtraction per dimension.
+ */
+struct CellStencilEntry
+{
+    CellStencilEntry(const vec3<unsigned int>& offset, float min_distance)
+        : offset(offset), min_distance(min_distance)
+    {}
+
+    vec3<unsigned int> offset; //!< Cell offset, reduced modulo the cell list dimensions.
+    float min_distance;        //!< Lower bound on the distance between points in the two cells.
+};
+
 //! Computes a cell id for each particle and a link cell data structure for iterating through it
-/*! For simplicity in only needing a small number of arrays, the link cell
- *  algorithm is used to generate and store the cell list data for particles.
+/*! Particles are binned into cells, and the cell list data is stored in a
+ *  compressed sparse row (CSR) layout for efficient traversal.
 
  *  Cells are given a nominal minimum width \a cell_width. Each dimension of
  *  the box is split into an integer number of cells no smaller than
@@ -165,8 +174,14 @@ private:
  *  an arbitrary point.
 
  *  <b>Data structures:</b><br>
- *  The internal data structure used in LinkCell is a linked list of particle
- *  indices. See IteratorLinkCell for information on how to iterate through these.
+ *  Particles are counting sorted by cell, so the indices of the particles in
+ *  cell \c c are stored contiguously (in increasing order) in the positions
+ *  [getCellStart(c), getCellStart(c + 1)) of the array of cell-ordered
+ *  particle indices. Copies of the particle coordinates are stored in the
+ *  same order as separate x, y and z arrays, so that a search over a cell
+ *  streams through contiguous memory instead of gathering coordinates from
+ *  the original points array. See IteratorLinkCell for information on how to
+ *  iterate through cells.
 
  *  <b>2D:</b><br>
  *  LinkCell properly handles 2D boxes. When a 2D box is handed to LinkCell,
@@ -185,7 +200,17 @@ public:
     LinkCell();
 
     //! Constructor
-    LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width = 0);
+    /*! \param box The simulation box.
+     *  \param points The points to bin into the cell list.
+     *  \param n_points The number of points.
+     *  \param cell_width The width of the cells (estimated if 0).
+     *  \param deterministic If true, the particles in each cell are stored in
+     *         increasing index order. Otherwise, the order of the particles
+     *         within a cell depends on thread scheduling, which makes the
+     *         parallel construction slightly faster.
+     */
+    LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width = 0,
+             bool deterministic = true);
 
     //! Compute LinkCell dimensions
     const vec3<unsigned int> computeDimensions(const box::Box& box, float cell_width) const;
@@ -205,6 +230,12 @@ public:
         return m_cell_width;
     }
 
+    //! Whether particles within each cell are stored in increasing index order
+    bool getDeterministic() const
+    {
+        return m_deterministic;
+    }
+
     //! Compute the cell id for a given position
     unsigned int getCell(const vec3<float>& p) const
     {
@@ -224,12 +255,73 @@ public:
     //! Iterate over particles in a cell
     iteratorcell itercell(unsigned int cell) const
     {
-        return iteratorcell(m_cell_list, m_n_points, getNumCells(), cell);
+        return iteratorcell(m_cell_point_indices, m_cell_starts[cell], m_cell_starts[cell + 1]);
+    }
+
+    //! Get the position of the first particle of a cell in the cell-ordered arrays.
+    /*! The particles of cell \c c occupy the positions [getCellStart(c),
+     *  getCellStart(c + 1)), and getCellStart(getNumCells()) is the number of
+     *  points.
+     */
+    unsigned int getCellStart(unsigned int cell) const
+    {
+        return m_cell_starts[cell];
+    }
+
+    //! Get the number of particles in a cell.
+    unsigned int getCellCount(unsigned int cell) const
+    {
+        return m_cell_starts[cell + 1] - m_cell_starts[cell];
+    }
+
+    //! Get the particle indices sorted by cell.
+    const util::ManagedArray<unsigned int>& getCellPointIndices() const
+    {
+        return m_cell_point_indices;
     }
 
     //! Get a list of neighbors to a cell
     const std::vector<unsigned int>& getCellNeighbors(unsigned int cell) const;
 
+    //! Get the stencil of neighbor cells that may contain points within a distance.
+    /*! The stencil contains each distinct neighbor cell (accounting for
+     *  periodic images in small cell lists) in the shells of cells that can
+     *  contain points within r_max, in the order in which IteratorCellShell
+     *  visits them. The first entry is always the cell itself. Stencils are
+     *  computed once for each number of shells and cached, so they may also
+     *  contain cells whose minimum distance bound is not less than r_max,
+     *  which callers should skip.
+     *
+     *  \param r_max The maximum distance of interest.
+     */
+    const std::vector<CellStencilEntry>& getStencil(float r_max) const;
+
+    //! Get the stencil of neighbor cells within a distance, sorted by minimum distance.
+    /*! This contains the same cells as getStencil, but sorted by increasing
+     *  minimum distance bound (the cell itself is still first), so that
+     *  nearest neighbor searches can stop at the first cell that is farther
+     *  away than the neighbors already found or than r_max. Sorted stencils
+     *  are cached in the same way as stencils.
+     *
+     *  \param r_max The maximum distance of interest.
+     */
+    const std::vector<CellStencilEntry>& getSortedStencil(float r_max) const;
+
+    //! Get the index of the cell at a stencil offset from a cell.
+    /*! \param cell The coordinates of the cell.
+     *  \param offset The offset of a stencil entry.
+     */
+    unsigned int getStencilCell(const vec3<unsigned int>& cell, const vec3<unsigned int>& offset) const
+    {
+        unsigned int x = cell.x + offset.x;
+        x -= (x >= m_celldim.x) ? m_celldim.x : 0;
+        unsigned int y = cell.y + offset.y;
+        y -= (y >= m_celldim.y) ? m_celldim.y : 0;
+        unsigned int z = cell.z + offset.z;
+        z -= (z >= m_celldim.z) ? m_celldim.z : 0;
+        return x + m_celldim.x * (y + m_celldim.y * z);
+    }
+
     //! Compute the cell list
     void computeCellList(const vec3<float>* points, unsigned int n_points);
 
@@ -241,6 +333,13 @@ public:
     virtual std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const;
 
+    //! Implementation of bulk query for LinkCell (see NeighborQuery.h for documentation).
+    /*! Ball queries are performed directly on the cell list without creating
+     *  per-point iterators. Other query modes use the per-point iterators.
+     */
+    virtual void queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                           QueryArgs args, std::vector<NeighborBond>& bonds) const;
+
 private:
     //! Rounding helper function.
     static unsigned int roundDown(unsigned int v, unsigned int m);
@@ -248,15 +347,35 @@ private:
     //! Helper function to compute cell neighbors
     const std::vector<unsigned int>& computeCellNeighbors(unsigned int cell) const;
 
+    //! Helper function to find the number of shells of cells that may contain points within a distance
+    int getStencilRange(float r_max) const;
+
+    //! Helper function to compute the stencil of all cells up to a shell
+    std::vector<CellStencilEntry> computeStencil(int range) const;
+
+    //! Ball query loop of queryBulk, specialized on the wrapping policy of the box
+    template<typename WrapPolicy>
+    void queryBallBulk(const WrapPolicy& wrap, const vec3<float>* query_points, unsigned int begin,
+                       unsigned int end, const QueryArgs& args, std::vector<NeighborBond>& bonds) const;
+
     unsigned int m_n_points;      //!< Number of particles last placed into the cell list
     unsigned int m_Nc;            //!< Number of cells last used
     float m_cell_width;           //!< Minimum necessary cell width cutoff
+    bool m_deterministic;         //!< Whether to sort the particles within each cell by index
     vec3<unsigned int> m_celldim; //!< Cell dimensions
     unsigned int m_size;          //!< The size of cell list.
 
-    util::ManagedArray<unsigned int> m_cell_list; //!< The cell list last computed
+    util::ManagedArray<unsigned int> m_cell_starts; //!< Position of the first particle of each cell (CSR
+                                                    //!< offsets, with one extra entry at the end).
+    util::ManagedArray<unsigned int> m_cell_point_indices; //!< Particle indices sorted by cell.
+    util::ManagedArray<float> m_cell_points_x; //!< x coordinates of the particles sorted by cell.
+    util::ManagedArray<float> m_cell_points_y; //!< y coordinates of the particles sorted by cell.
+    util::ManagedArray<float> m_cell_points_z; //!< z coordinates of the particles sorted by cell.
     typedef tbb::concurrent_hash_map<unsigned int, std::vector<unsigned int>> CellNeighbors;
     mutable CellNeighbors m_cell_neighbors; //!< Hash map of cell neighbors for each cell
+    typedef tbb::concurrent_hash_map<int, std::vector<CellStencilEntry>> CellStencils;
+    mutable CellStencils m_stencils;        //!< Hash map of cell stencils for each number of shells
+    mutable CellStencils m_sorted_stencils; //!< Hash map of sorted cell stencils for each number of shells
 };
 
 //! Parent class of LinkCell iterators that knows how to traverse general cell-linked list structures.
@@ -284,11 +403,15 @@ protected:
         m_neigh_cell_iter; //!< The shell iterator indicating how far out we're currently searching.
     LinkCell::iteratorcell
         m_cell_iter; //!< The cell iterator indicating which cell we're currently searching.
-    std::unordered_set<unsigned int>
-        m_searched_cells; //!< Set of cells that have already been searched by the cell shell iterator.
 };
 
 //! Iterator that gets specified numbers of nearest neighbors from LinkCell tree structures.
+/*! The cells of the sorted stencil are searched in order of their minimum
+ *  distance from the query point's cell, keeping the nearest candidates in a
+ *  max-heap of num_neighbors bonds. The search stops at the first cell whose
+ *  minimum distance exceeds the farthest candidate, and only the final
+ *  neighbors are sorted.
+ */
 class LinkCellQueryIterator : public LinkCellIterator
 {
 public:
@@ -297,7 +420,7 @@ public:
                           unsigned int query_point_idx, unsigned int num_neighbors, float r_max, float r_min,
                           bool exclude_ii)
         : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii),
-          m_count(0), m_num_neighbors(num_neighbors)
+          m_count(0), m_num_neighbors(num_neighbors), m_searched(false)
     {}
 
     //! Empty Destructor
@@ -307,9 +430,13 @@ public:
     virtual NeighborBond next();
 
 protected:
+    //! Find the nearest neighbors of the query point, sorted by distance.
+    void findNeighbors();
+
     unsigned int m_count;                          //!< Number of neighbors returned for the current point.
     unsigned int m_num_neighbors;                  //!< Number of nearest neighbors to find
-    std::vector<NeighborBond> m_current_neighbors; //!< The current set of found neighbors.
+    bool m_searched;                               //!< Whether the nearest neighbors have been found.
+    std::vector<NeighborBond> m_current_neighbors; //!< The nearest neighbors, sorted by distance.
 };
 
 //! Iterator that gets neighbors in a ball of size r using LinkCell tree structures.
@@ -319,20 +446,10 @@ public:
     //! Constructor
     LinkCellQueryBallIterator(const LinkCell* neighbor_query, const vec3<float> query_point,
                               unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
-        : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii)
-    {
-        // Upon querying, if the search radius is equal to the cell width, we
-        // can guarantee that we don't need to search the cell shell past the
-        // query radius. For simplicity, we store this value as an integer.
-        if (m_r_max == neighbor_query->getCellWidth())
-        {
-            m_extra_search_width = 0;
-        }
-        else
-        {
-            m_extra_search_width = 1;
-        }
-    }
+        : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii),
+          m_stencil(&neighbor_query->getStencil(r_max)), m_stencil_idx(0),
+          m_point_cell(neighbor_query->getCellCoord(query_point))
+    {}
 
     //! Empty Destructor
     virtual ~LinkCellQueryBallIterator() {}
@@ -341,7 +458,9 @@ public:
     virtual NeighborBond next();
 
 protected:
-    int m_extra_search_width; //!< The extra shell distance to search, always 0 or 1.
+    const std::vector<CellStencilEntry>* m_stencil; //!< The stencil of cells to search.
+    unsigned int m_stencil_idx;       //!< The index of the stencil entry currently being searched.
+    vec3<unsigned int> m_point_cell; //!< The coordinates of the cell containing the query point.
 };
 }; }; // end namespace freud::locality
 
@@ -0,0 +1,172 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef NEAREST_NEIGHBOR_HEAP_H
+#define NEAREST_NEIGHBOR_HEAP_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "NeighborBond.h"
+
+/*! \file NearestNeighborHeap.h
+    \brief Bounded heap of the nearest neighbor candidates of a query point.
+*/
+
+namespace freud { namespace locality {
+
+//! Keeps the nearest candidates found so far by a nearest neighbor search.
+/*! Candidates are stored in a max-heap of at most num_neighbors bonds,
+ *  ordered by distance with ties broken by point index, so a search can stop
+ *  as soon as nothing left to visit can be closer than the farthest
+ *  candidate (see getMaxDistanceSq). The distances are squared until finish
+ *  is called.
+ *
+ *  Searches over periodic images of the query point may find several images
+ *  of the same point. Two images are separated by a lattice vector, so at
+ *  least one of them is at least half of the smallest plane distance of the
+ *  box away. Candidates are therefore only checked against the heap for
+ *  duplicates beyond that distance, and only the minimum image of each point
+ *  is kept. A point is excluded entirely if any image of it is closer than
+ *  r_min.
+ */
+class NearestNeighborHeap
+{
+public:
+    //! Constructor
+    /*! \param query_point_idx The index of the query point.
+     *  \param num_neighbors The maximum number of neighbors to keep.
+     *  \param r_min The minimum distance of a neighbor.
+     *  \param duplicate_r_sq The squared distance beyond which a candidate may
+     *         not be the minimum image of its point (infinite if the search
+     *         never finds a point more than once).
+     */
+    NearestNeighborHeap(unsigned int query_point_idx, unsigned int num_neighbors, float r_min,
+                        float duplicate_r_sq = std::numeric_limits<float>::infinity())
+        : m_query_point_idx(query_point_idx), m_num_neighbors(num_neighbors), m_r_min_sq(r_min * r_min),
+          m_duplicate_r_sq(duplicate_r_sq)
+    {
+        m_heap.reserve(num_neighbors);
+    }
+
+    //! Whether num_neighbors candidates have been found.
+    bool full() const
+    {
+        return !m_heap.empty() && m_heap.size() >= m_num_neighbors;
+    }
+
+    //! Get the squared distance of the farthest candidate (only valid if full).
+    float getMaxDistanceSq() const
+    {
+        return m_heap.front().distance;
+    }
+
+    //! Add a candidate neighbor.
+    /*! \param point_idx The index of the candidate point.
+     *  \param r_sq The squared distance to the candidate.
+     */
+    void add(unsigned int point_idx, float r_sq)
+    {
+        if (m_num_neighbors == 0)
+        {
+            return;
+        }
+
+        const bool may_be_duplicate
+            = r_sq >= m_duplicate_r_sq || (!m_heap.empty() && m_heap.front().distance >= m_duplicate_r_sq);
+
+        if (r_sq < m_r_min_sq)
+        {
+            if (m_duplicate_r_sq != std::numeric_limits<float>::infinity())
+            {
+                m_excluded_points.push_back(point_idx);
+            }
+            if (may_be_duplicate)
+            {
+                remove(point_idx);
+            }
+            return;
+        }
+
+        if (may_be_duplicate)
+        {
+            if (std::find(m_excluded_points.begin(), m_excluded_points.end(), point_idx)
+                != m_excluded_points.end())
+            {
+                return;
+            }
+            for (std::vector<NeighborBond>::const_iterator it = m_heap.begin(); it != m_heap.end(); ++it)
+            {
+                if (it->point_idx == point_idx)
+                {
+                    if (r_sq >= it->distance)
+                    {
+                        return;
+                    }
+                    // Replace the farther image of this point.
+                    remove(point_idx);
+                    break;
+                }
+            }
+        }
+
+        const NeighborBond candidate(m_query_point_idx, point_idx, r_sq);
+        if (m_heap.size() < m_num_neighbors)
+        {
+            m_heap.push_back(candidate);
+            std::push_heap(m_heap.begin(), m_heap.end(), closer);
+        }
+        else if (closer(candidate, m_heap.front()))
+        {
+            std::pop_heap(m_heap.begin(), m_heap.end(), closer);
+            m_heap.back() = candidate;
+            std::push_heap(m_heap.begin(), m_heap.end(), closer);
+        }
+    }
+
+    //! Append the neighbors found to a vector, sorted by distance.
+    void finish(std::vector<NeighborBond>& bonds)
+    {
+        std::sort(m_heap.begin(), m_heap.end(), closer);
+        for (std::vector<NeighborBond>::iterator it = m_heap.begin(); it != m_heap.end(); ++it)
+        {
+            it->distance = std::sqrt(it->distance);
+            bonds.push_back(*it);
+        }
+        m_heap.clear();
+    }
+
+private:
+    //! Heap ordering of candidates.
+    static bool closer(const NeighborBond& a, const NeighborBond& b)
+    {
+        return a.less_distance_point(b);
+    }
+
+    //! Remove a point from the heap if it is present.
+    void remove(unsigned int point_idx)
+    {
+        for (std::vector<NeighborBond>::iterator it = m_heap.begin(); it != m_heap.end(); ++it)
+        {
+            if (it->point_idx == point_idx)
+            {
+                m_heap.erase(it);
+                std::make_heap(m_heap.begin(), m_heap.end(), closer);
+                return;
+            }
+        }
+    }
+
+    unsigned int m_query_point_idx;              //!< The index of the query point.
+    unsigned int m_num_neighbors;                //!< The number of neighbors to find.
+    float m_r_min_sq;                            //!< The squared minimum distance of a neighbor.
+    float m_duplicate_r_sq;                      //!< Squared distance beyond which duplicates may occur.
+    std::vector<NeighborBond> m_heap;            //!< Max-heap of the nearest candidates.
+    std::vector<unsigned int> m_excluded_points; //!< Points with an image closer than r_min.
+};
+
+}; }; // end namespace freud::locality
+
+#endif // NEAREST_NEIGHBOR_HEAP_H
@@ -40,6 +40,18 @@ struct NeighborBond
         return distance < n.distance;
     }
 
+    //! Compare by distance, breaking ties by point index.
+    /*! This gives a deterministic ordering of nearest neighbor candidates.
+     */
+    bool less_distance_point(const NeighborBond& n) const
+    {
+        if (distance != n.distance)
+        {
+            return distance < n.distance;
+        }
+        return point_idx < n.point_idx;
+    }
+
     bool less_id_ref_weight(const NeighborBond& n) const
     {
         if (query_point_idx != n.query_point_idx)
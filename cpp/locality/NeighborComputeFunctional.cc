@@ -8,16 +8,56 @@ namespace freud { namespace locality {
 
 NeighborList makeDefaultNlist(const NeighborQuery* nq, const NeighborList* nlist,
                               const vec3<float>* query_points, unsigned int num_query_points,
-                              locality::QueryArgs qargs)
+                              locality::QueryArgs qargs, bool store_vectors)
 {
     if (nlist == NULL)
     {
         auto nqiter(nq->query(query_points, num_query_points, qargs));
-        nlist = nqiter->toNeighborList();
+        nlist = nqiter->toNeighborList(store_vectors);
     }
     locality::NeighborList new_nlist = NeighborList(*nlist);
     new_nlist.validate(num_query_points, nq->getNPoints());
+    if (store_vectors && !new_nlist.hasVectors())
+    {
+        new_nlist.computeVectors(nq->getBox(), nq->getPoints(), query_points);
+    }
     return new_nlist;
 }
 
+void NeighborChunk::load(const NeighborQueryIterator* iter, unsigned int first, unsigned int last)
+{
+    m_bonds.clear();
+    iter->queryBulk(first, last, m_bonds);
+    sortBondsByQueryPoint(m_bonds);
+    index(first, last);
+}
+
+void NeighborChunk::load(const NeighborList* nlist, unsigned int first, unsigned int last)
+{
+    m_bonds.clear();
+    const unsigned int num_bonds = nlist->getNumBonds();
+    for (unsigned int bond = nlist->find_first_index(first);
+         bond < num_bonds && nlist->getNeighbors()(bond, 0) < last; ++bond)
+    {
+        m_bonds.emplace_back(nlist->getNeighbors()(bond, 0), nlist->getNeighbors()(bond, 1),
+                             nlist->getDistances()[bond], nlist->getWeights()[bond]);
+    }
+    index(first, last);
+}
+
+void NeighborChunk::index(unsigned int first, unsigned int last)
+{
+    m_first = first;
+    m_last = last;
+    m_segments.assign(last - first + 1, 0);
+    for (std::vector<NeighborBond>::const_iterator nb = m_bonds.begin(); nb != m_bonds.end(); ++nb)
+    {
+        ++m_segments[nb->query_point_idx - first + 1];
+    }
+    for (unsigned int i = 0; i < last - first; ++i)
+    {
+        m_segments[i + 1] += m_segments[i];
+    }
+}
+
 }; }; // end namespace freud::locality
@@ -1,9 +1,12 @@
 #ifndef NEIGHBOR_COMPUTE_FUNCTIONAL_H
 #define NEIGHBOR_COMPUTE_FUNCTIONAL_H
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "AABBQuery.h"
+#include "CompressedNeighborList.h"
 #include "NeighborList.h"
 #include "NeighborPerPointIterator.h"
 #include "NeighborQuery.h"
@@ -18,11 +21,29 @@ namespace freud { namespace locality {
 //! Make a default NeighborList object to use.
 /*! This function makes a NeighborList from the provided NeighborQuery object
  * if the provided NeighborList is NULL. Otherwise, it simply returns a copy of
- * the provided NeighborList.
+ * the provided NeighborList. If store_vectors is true, the returned list
+ * also stores the vector of each bond (see NeighborList::getVectors).
  */
 NeighborList makeDefaultNlist(const NeighborQuery* nq, const NeighborList* nlist,
                               const vec3<float>* query_points, unsigned int num_query_points,
-                              locality::QueryArgs qargs);
+                              locality::QueryArgs qargs, bool store_vectors = false);
+
+//! Determine whether neighbors can be found with a symmetric half query.
+/*! A symmetric_half query finds each pair only once, which halves the work
+ *  of finding neighbors. This is only possible when no NeighborList is
+ *  provided and the query is a ball query of the NeighborQuery's own points,
+ *  in which case the neighbor relation is symmetric.
+ */
+inline bool canQuerySymmetricHalf(const NeighborQuery* nq, const NeighborList* nlist,
+                                  const vec3<float>* query_points, unsigned int num_query_points,
+                                  const QueryArgs& qargs)
+{
+    const bool ball_query = (qargs.mode == QueryArgs::ball)
+        || (qargs.mode == QueryArgs::none && qargs.num_neighbors == QueryArgs::DEFAULT_NUM_NEIGHBORS
+            && qargs.r_max != QueryArgs::DEFAULT_R_MAX);
+    return (nlist == NULL) && ball_query && (query_points == nq->getPoints())
+        && (num_query_points == nq->getNPoints());
+}
 
 //! Compute the vector corresponding to a NeighborBond.
 /*! The primary purpose of this function is to standardize the directionality
@@ -86,6 +107,179 @@ private:
     bool m_finished;
 };
 
+//! Number of query points whose bonds are buffered at once when looping over neighbors.
+const unsigned int BULK_QUERY_BATCH_SIZE = 256;
+
+//! Implementation of per-point iteration over a segment of a bond buffer.
+/*! This class provides the per-point neighbor iteration interface for the
+ *  bonds of a single query point that have already been found in bulk (see
+ *  NeighborQuery::queryBulk) and stored contiguously. A single instance can be
+ *  reset to point at the segment of each query point in turn, avoiding an
+ *  allocation per query point.
+ */
+class NeighborBondSegmentIterator : public NeighborPerPointIterator
+{
+public:
+    NeighborBondSegmentIterator()
+        : NeighborPerPointIterator(0), m_current(NULL), m_last(NULL), m_finished(true)
+    {}
+
+    ~NeighborBondSegmentIterator() {}
+
+    //! Point the iterator at the bonds [first, last) of a query point.
+    void reset(unsigned int query_point_idx, const NeighborBond* first, const NeighborBond* last)
+    {
+        m_query_point_idx = query_point_idx;
+        m_current = first;
+        m_last = last;
+        m_finished = false;
+    }
+
+    virtual NeighborBond next()
+    {
+        if (m_current == m_last)
+        {
+            m_finished = true;
+            return ITERATOR_TERMINATOR;
+        }
+        return *(m_current++);
+    }
+
+    virtual bool end()
+    {
+        return m_finished;
+    }
+
+private:
+    const NeighborBond* m_current; //!< The next bond to return.
+    const NeighborBond* m_last;    //!< One past the last bond of the current query point.
+    bool m_finished;               //!< Whether the terminator has been returned.
+};
+
+//! Number of query points whose bonds are delivered together by streamNeighborChunks.
+const unsigned int NEIGHBOR_CHUNK_SIZE = 1024;
+
+//! The bonds of a block of contiguous query points.
+/*! The bonds are stored in CSR form: the bonds of each query point are
+ *  contiguous and sorted in the same order as in a NeighborList, and a
+ *  segments array gives the first bond of each query point. A chunk is
+ *  filled either by a bulk query or from a NeighborList, and can be refilled
+ *  for the next block of query points without reallocating.
+ */
+class NeighborChunk
+{
+public:
+    //! Default constructor
+    NeighborChunk() : m_first(0), m_last(0), m_segments(1, 0) {}
+
+    //! Fill the chunk with the bonds of the query points [first, last) found by a query.
+    void load(const NeighborQueryIterator* iter, unsigned int first, unsigned int last);
+
+    //! Fill the chunk with the bonds of the query points [first, last) of a NeighborList.
+    void load(const NeighborList* nlist, unsigned int first, unsigned int last);
+
+    //! Return the first query point of the chunk
+    unsigned int getFirstQueryPoint() const
+    {
+        return m_first;
+    }
+    //! Return one past the last query point of the chunk
+    unsigned int getLastQueryPoint() const
+    {
+        return m_last;
+    }
+    //! Return the number of bonds in the chunk
+    size_t getNumBonds() const
+    {
+        return m_bonds.size();
+    }
+    //! Return the number of bonds of a query point of the chunk
+    unsigned int getCount(unsigned int query_point_idx) const
+    {
+        return m_segments[query_point_idx - m_first + 1] - m_segments[query_point_idx - m_first];
+    }
+    //! Return a pointer to the first bond of a query point of the chunk
+    const NeighborBond* begin(unsigned int query_point_idx) const
+    {
+        return m_bonds.data() + m_segments[query_point_idx - m_first];
+    }
+    //! Return a pointer one past the last bond of a query point of the chunk
+    const NeighborBond* end(unsigned int query_point_idx) const
+    {
+        return m_bonds.data() + m_segments[query_point_idx - m_first + 1];
+    }
+
+private:
+    //! Build the segments of the query points [first, last) from the bonds.
+    void index(unsigned int first, unsigned int last);
+
+    unsigned int m_first;                 //!< First query point of the chunk.
+    unsigned int m_last;                  //!< One past the last query point of the chunk.
+    std::vector<unsigned int> m_segments; //!< First bond of each query point, then the bond count.
+    std::vector<NeighborBond> m_bonds;    //!< The bonds of all query points of the chunk.
+};
+
+//! Stream the neighbors of all query points to a consumer in chunks.
+/*! This function finds the neighbors of blocks of chunk_size contiguous query
+ *  points at a time, either with the provided NeighborQuery or by reading
+ *  them from the provided NeighborList, and passes each block to the
+ *  consumer as a NeighborChunk. Unlike building a NeighborList with
+ *  makeDefaultNlist, only the bonds of the chunks being processed are held
+ *  in memory, so computes that only need a single pass over the neighbors
+ *  of each point should prefer this function.
+ *
+ *  If parallel is false, the chunks are delivered in increasing order of
+ *  query point, so the consumer may depend on the order of the points.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, read the bonds from it. Otherwise, use neighbor_query with the
+ *  given qargs.
+ *  \param consumer An object with operator(const NeighborChunk&) as input.
+ *  \param parallel Whether chunks may be processed in parallel.
+ *  \param chunk_size The number of query points in each chunk.
+ */
+template<typename ChunkConsumerType>
+void streamNeighborChunks(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                          unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                          const ChunkConsumerType& consumer, bool parallel = true,
+                          unsigned int chunk_size = NEIGHBOR_CHUNK_SIZE)
+{
+    std::shared_ptr<NeighborQueryIterator> iter;
+    if (nlist != NULL)
+    {
+        nlist->validate(n_query_points, neighbor_query->getNPoints());
+    }
+    else
+    {
+        iter = neighbor_query->query(query_points, n_query_points, qargs);
+    }
+
+    const size_t num_chunks = (size_t(n_query_points) + chunk_size - 1) / chunk_size;
+    util::forLoopWrapper(
+        0, num_chunks,
+        [&](size_t begin, size_t end) {
+            NeighborChunk chunk;
+            for (size_t chunk_idx = begin; chunk_idx < end; ++chunk_idx)
+            {
+                const unsigned int first = chunk_idx * chunk_size;
+                const unsigned int last = std::min(n_query_points, first + chunk_size);
+                if (nlist != NULL)
+                {
+                    chunk.load(nlist, first, last);
+                }
+                else
+                {
+                    chunk.load(iter.get(), first, last);
+                }
+                consumer(static_cast<const NeighborChunk&>(chunk));
+            }
+        },
+        parallel);
+}
+
 //! Wrapper iterating looping over NeighborQuery or NeighborList.
 /*! This function dynamically determines whether or not the provided
  *  NeighborList is valid. If it is, it applies the provide compute function to
@@ -135,14 +329,34 @@ void loopOverNeighborsIterator(const NeighborQuery* neighbor_query, const vec3<f
         std::shared_ptr<NeighborQueryIterator> iter
             = neighbor_query->query(query_points, n_query_points, qargs);
 
-        // iterate over the query object in parallel
+        // iterate over the query object in parallel, finding the neighbors
+        // of batches of query points in bulk and handing out the segment of
+        // each query point through a single reusable iterator.
         util::forLoopWrapper(
             0, n_query_points,
-            [=](size_t begin, size_t end) {
-                for (size_t i = begin; i != end; ++i)
+            [&iter, &cf](size_t begin, size_t end) {
+                std::vector<NeighborBond> bonds;
+                std::shared_ptr<NeighborBondSegmentIterator> segment
+                    = std::make_shared<NeighborBondSegmentIterator>();
+                const std::shared_ptr<NeighborPerPointIterator> it(segment);
+                for (size_t batch_begin = begin; batch_begin < end; batch_begin += BULK_QUERY_BATCH_SIZE)
                 {
-                    std::shared_ptr<NeighborQueryPerPointIterator> it = iter->query(i);
-                    cf(i, it);
+                    const size_t batch_end = std::min(end, batch_begin + BULK_QUERY_BATCH_SIZE);
+                    bonds.clear();
+                    iter->queryBulk(batch_begin, batch_end, bonds);
+
+                    // Bonds are grouped by query point in increasing order.
+                    size_t bond = 0;
+                    for (size_t i = batch_begin; i != batch_end; ++i)
+                    {
+                        const size_t first_bond = bond;
+                        while (bond < bonds.size() && bonds[bond].query_point_idx == i)
+                        {
+                            ++bond;
+                        }
+                        segment->reset(i, bonds.data() + first_bond, bonds.data() + bond);
+                        cf(i, it);
+                    }
                 }
             },
             parallel);
@@ -195,19 +409,88 @@ void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* q
         std::shared_ptr<NeighborQueryIterator> iter
             = neighbor_query->query(query_points, n_query_points, qargs);
 
-        // iterate over the query object in parallel
+        // iterate over the query object in parallel, finding the neighbors
+        // of batches of query points in bulk.
         util::forLoopWrapper(
             0, n_query_points,
             [&iter, &cf](size_t begin, size_t end) {
-                NeighborBond nb;
-                for (size_t i = begin; i != end; ++i)
+                std::vector<NeighborBond> bonds;
+                for (size_t batch_begin = begin; batch_begin < end; batch_begin += BULK_QUERY_BATCH_SIZE)
+                {
+                    const size_t batch_end = std::min(end, batch_begin + BULK_QUERY_BATCH_SIZE);
+                    bonds.clear();
+                    iter->queryBulk(batch_begin, batch_end, bonds);
+                    for (std::vector<NeighborBond>::const_iterator nb = bonds.begin(); nb != bonds.end(); ++nb)
+                    {
+                        cf(*nb);
+                    }
+                }
+            },
+            parallel);
+    }
+}
+
+//! Number of bonds of a NeighborList passed to the compute function of loopOverNeighborBlocks at once.
+const unsigned int BOND_BLOCK_SIZE = 1024;
+
+//! Wrapper looping over all bonds in blocks of consecutive bonds.
+/*! This function behaves like loopOverNeighbors, but calls the compute
+ *  function once for each block of bonds rather than once for every bond.
+ *  Computes can use this to do per-block work, such as looking up
+ *  thread-local storage, once per block. The bonds of a NeighborList are
+ *  copied into blocks of BOND_BLOCK_SIZE bonds, and bonds found with a
+ *  NeighborQuery are passed in the batches returned by bulk queries.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ *  given qargs.
+ *  \param cf An object with operator(const NeighborBond* first, const NeighborBond* last) as input.
+ */
+template<typename ComputeBlockType>
+void loopOverNeighborBlocks(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                            unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                            const ComputeBlockType& cf, bool parallel = true)
+{
+    if (nlist != NULL)
+    {
+        util::forLoopWrapper(
+            0, nlist->getNumBonds(),
+            [=](size_t begin, size_t end) {
+                std::vector<NeighborBond> bonds;
+                for (size_t block_begin = begin; block_begin < end; block_begin += BOND_BLOCK_SIZE)
+                {
+                    const size_t block_end = std::min(end, block_begin + BOND_BLOCK_SIZE);
+                    bonds.clear();
+                    for (size_t bond = block_begin; bond != block_end; ++bond)
+                    {
+                        bonds.emplace_back(nlist->getNeighbors()(bond, 0), nlist->getNeighbors()(bond, 1),
+                                           nlist->getDistances()[bond], nlist->getWeights()[bond]);
+                    }
+                    cf(bonds.data(), bonds.data() + bonds.size());
+                }
+            },
+            parallel);
+    }
+    else
+    {
+        std::shared_ptr<NeighborQueryIterator> iter
+            = neighbor_query->query(query_points, n_query_points, qargs);
+
+        util::forLoopWrapper(
+            0, n_query_points,
+            [&iter, &cf](size_t begin, size_t end) {
+                std::vector<NeighborBond> bonds;
+                for (size_t batch_begin = begin; batch_begin < end; batch_begin += BULK_QUERY_BATCH_SIZE)
                 {
-                    std::shared_ptr<NeighborQueryPerPointIterator> it = iter->query(i);
-                    nb = it->next();
-                    while (!it->end())
+                    const size_t batch_end = std::min(end, batch_begin + BULK_QUERY_BATCH_SIZE);
+                    bonds.clear();
+                    iter->queryBulk(batch_begin, batch_end, bonds);
+                    if (!bonds.empty())
                     {
-                        cf(nb);
-                        nb = it->next();
+                        cf(bonds.data(), bonds.data() + bonds.size());
                     }
                 }
             },
@@ -215,6 +498,361 @@ void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* q
     }
 }
 
+//! Per-point iteration over bonds together with their bond vectors.
+/*! This class wraps a NeighborPerPointIterator and returns the vector of
+ *  each bond (see bondVector) along with the bond. The vectors of the bonds
+ *  of the query point are read from an array in the order of the bonds,
+ *  either the vectors stored in a NeighborList or vectors computed in bulk
+ *  by loopOverNeighborVectorsIterator.
+ */
+class NeighborVectorIterator
+{
+public:
+    //! Constructor
+    /*! \param iter The iterator over the bonds of a query point.
+     *  \param vectors The vectors of the bonds returned by iter, in the same order.
+     */
+    NeighborVectorIterator(const std::shared_ptr<NeighborPerPointIterator>& iter, const vec3<float>* vectors)
+        : m_iter(iter), m_vectors(vectors)
+    {}
+
+    //! Return the next bond, setting vector to its bond vector (only valid if not end).
+    NeighborBond next(vec3<float>& vector)
+    {
+        const NeighborBond nb = m_iter->next();
+        if (!m_iter->end())
+        {
+            vector = *(m_vectors++);
+        }
+        return nb;
+    }
+
+    //! Whether all bonds of the query point have been returned
+    bool end()
+    {
+        return m_iter->end();
+    }
+
+private:
+    std::shared_ptr<NeighborPerPointIterator> m_iter; //!< The iterator over the bonds.
+    const vec3<float>* m_vectors;                    //!< The vector of the next bond.
+};
+
+//! Compute the bond vectors of an array of bonds with a wrapping policy.
+/*! \param wrap The wrapping policy of the box (see Box.h).
+ *  \param points The points of the bonds.
+ *  \param query_points The query points of the bonds.
+ *  \param bonds The bonds.
+ *  \param num_bonds The number of bonds.
+ *  \param vectors Output array of num_bonds vectors.
+ */
+template<typename WrapPolicy>
+void computeBondVectors(const WrapPolicy& wrap, const vec3<float>* points, const vec3<float>* query_points,
+                        const NeighborBond* bonds, size_t num_bonds, vec3<float>* vectors)
+{
+    for (size_t bond = 0; bond < num_bonds; ++bond)
+    {
+        vectors[bond] = wrap(points[bonds[bond].point_idx] - query_points[bonds[bond].query_point_idx]);
+    }
+}
+
+//! Helper of loopOverNeighborVectorsIterator computing the bond vectors with a wrapping policy.
+template<typename WrapPolicy, typename ComputePairType>
+void loopOverWrappedNeighborVectorsIterator(const WrapPolicy& wrap, const NeighborQuery* neighbor_query,
+                                            const vec3<float>* query_points, unsigned int n_query_points,
+                                            QueryArgs qargs, const NeighborList* nlist,
+                                            const ComputePairType& cf, bool parallel)
+{
+    const vec3<float>* points = neighbor_query->getPoints();
+    streamNeighborChunks(
+        neighbor_query, query_points, n_query_points, qargs, nlist,
+        [&](const NeighborChunk& chunk) {
+            const unsigned int first = chunk.getFirstQueryPoint();
+            std::vector<vec3<float>> vectors(chunk.getNumBonds());
+            computeBondVectors(wrap, points, query_points, chunk.begin(first), chunk.getNumBonds(),
+                               vectors.data());
+
+            std::shared_ptr<NeighborBondSegmentIterator> segment
+                = std::make_shared<NeighborBondSegmentIterator>();
+            const std::shared_ptr<NeighborPerPointIterator> it(segment);
+            for (unsigned int i = first; i != chunk.getLastQueryPoint(); ++i)
+            {
+                segment->reset(i, chunk.begin(i), chunk.end(i));
+                NeighborVectorIterator iter(it, vectors.data() + (chunk.begin(i) - chunk.begin(first)));
+                cf(i, iter);
+            }
+        },
+        parallel, BULK_QUERY_BATCH_SIZE);
+}
+
+//! Wrapper looping over the bonds of each query point together with their bond vectors.
+/*! This function behaves like loopOverNeighborsIterator, but hands the
+ *  compute function a NeighborVectorIterator that also returns the vector
+ *  of each bond (see bondVector). If the provided NeighborList stores its
+ *  bond vectors (see NeighborList::computeVectors), they are read from the
+ *  list. Otherwise, the bonds of batches of query points are gathered and
+ *  their vectors are computed together with the wrapping policy of the box,
+ *  which is chosen once per call.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ *  given qargs.
+ *  \param cf An object with operator(size_t point_index, NeighborVectorIterator&) as input. It should
+ *  implement iteration logic over the iterator.
+ */
+template<typename ComputePairType>
+void loopOverNeighborVectorsIterator(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                                     unsigned int n_query_points, QueryArgs qargs,
+                                     const NeighborList* nlist, const ComputePairType& cf,
+                                     bool parallel = true)
+{
+    if (nlist != NULL && nlist->hasVectors())
+    {
+        const vec3<float>* vectors = nlist->getVectors().get();
+        loopOverNeighborsIterator(
+            neighbor_query, query_points, n_query_points, qargs, nlist,
+            [&](size_t i, const std::shared_ptr<NeighborPerPointIterator>& ppiter) {
+                NeighborVectorIterator iter(ppiter, vectors + nlist->find_first_index(i));
+                cf(i, iter);
+            },
+            parallel);
+        return;
+    }
+
+    const box::Box& box = neighbor_query->getBox();
+    switch (box::getWrapPolicy(box))
+    {
+    case box::OrthorhombicWrapPolicy:
+        loopOverWrappedNeighborVectorsIterator(box::OrthorhombicWrap(box), neighbor_query, query_points,
+                                               n_query_points, qargs, nlist, cf, parallel);
+        break;
+    case box::Orthorhombic2DWrapPolicy:
+        loopOverWrappedNeighborVectorsIterator(box::Orthorhombic2DWrap(box), neighbor_query, query_points,
+                                               n_query_points, qargs, nlist, cf, parallel);
+        break;
+    default:
+        loopOverWrappedNeighborVectorsIterator(box::TriclinicWrap(box), neighbor_query, query_points,
+                                               n_query_points, qargs, nlist, cf, parallel);
+    }
+}
+
+//! Helper of loopOverNeighborVectors computing the bond vectors with a wrapping policy.
+template<typename WrapPolicy, typename ComputePairType>
+void loopOverWrappedNeighborVectors(const WrapPolicy& wrap, const NeighborQuery* neighbor_query,
+                                    const vec3<float>* query_points, unsigned int n_query_points,
+                                    QueryArgs qargs, const NeighborList* nlist, const ComputePairType& cf,
+                                    bool parallel)
+{
+    const vec3<float>* points = neighbor_query->getPoints();
+    loopOverNeighbors(
+        neighbor_query, query_points, n_query_points, qargs, nlist,
+        [&](const NeighborBond& nb) {
+            cf(nb, wrap(points[nb.point_idx] - query_points[nb.query_point_idx]));
+        },
+        parallel);
+}
+
+//! Wrapper looping over all bonds together with their bond vectors.
+/*! This function behaves like loopOverNeighbors, but also passes the
+ *  vector of each bond (see bondVector) to the compute function. If the
+ *  provided NeighborList stores its bond vectors (see
+ *  NeighborList::computeVectors), they are read from the list. Otherwise,
+ *  they are computed with the wrapping policy of the box, which is chosen
+ *  once per call.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ *  given qargs.
+ *  \param cf An object with operator(NeighborBond, vec3<float>) as input.
+ */
+template<typename ComputePairType>
+void loopOverNeighborVectors(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                             unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                             const ComputePairType& cf, bool parallel = true)
+{
+    if (nlist != NULL && nlist->hasVectors())
+    {
+        const vec3<float>* vectors = nlist->getVectors().get();
+        util::forLoopWrapper(
+            0, nlist->getNumBonds(),
+            [=](size_t begin, size_t end) {
+                for (size_t bond = begin; bond != end; ++bond)
+                {
+                    const NeighborBond nb(nlist->getNeighbors()(bond, 0), nlist->getNeighbors()(bond, 1),
+                                          nlist->getDistances()[bond], nlist->getWeights()[bond]);
+                    cf(nb, vectors[bond]);
+                }
+            },
+            parallel);
+        return;
+    }
+
+    const box::Box& box = neighbor_query->getBox();
+    switch (box::getWrapPolicy(box))
+    {
+    case box::OrthorhombicWrapPolicy:
+        loopOverWrappedNeighborVectors(box::OrthorhombicWrap(box), neighbor_query, query_points,
+                                       n_query_points, qargs, nlist, cf, parallel);
+        break;
+    case box::Orthorhombic2DWrapPolicy:
+        loopOverWrappedNeighborVectors(box::Orthorhombic2DWrap(box), neighbor_query, query_points,
+                                       n_query_points, qargs, nlist, cf, parallel);
+        break;
+    default:
+        loopOverWrappedNeighborVectors(box::TriclinicWrap(box), neighbor_query, query_points, n_query_points,
+                                       qargs, nlist, cf, parallel);
+    }
+}
+
+//! Helper of loopOverNeighborVectorBlocks computing the bond vectors with a wrapping policy.
+template<typename WrapPolicy, typename ComputeBlockType>
+void loopOverWrappedNeighborVectorBlocks(const WrapPolicy& wrap, const NeighborQuery* neighbor_query,
+                                         const vec3<float>* query_points, unsigned int n_query_points,
+                                         QueryArgs qargs, const NeighborList* nlist,
+                                         const ComputeBlockType& cf, bool parallel)
+{
+    const vec3<float>* points = neighbor_query->getPoints();
+    loopOverNeighborBlocks(
+        neighbor_query, query_points, n_query_points, qargs, nlist,
+        [&](const NeighborBond* first, const NeighborBond* last) {
+            std::vector<vec3<float>> vectors(last - first);
+            computeBondVectors(wrap, points, query_points, first, last - first, vectors.data());
+            cf(first, last, static_cast<const vec3<float>*>(vectors.data()));
+        },
+        parallel);
+}
+
+//! Wrapper looping over all bonds and their bond vectors in blocks of consecutive bonds.
+/*! This function behaves like loopOverNeighborBlocks, but also passes the
+ *  vectors of the bonds of each block (see bondVector) to the compute
+ *  function. If the provided NeighborList stores its bond vectors (see
+ *  NeighborList::computeVectors), they are read from the list. Otherwise,
+ *  the vectors of each block are computed together with the wrapping policy
+ *  of the box, which is chosen once per call.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ *  given qargs.
+ *  \param cf An object with operator(const NeighborBond* first, const NeighborBond* last, const
+ *  vec3<float>* vectors) as input, where vectors holds the vectors of the bonds [first, last).
+ */
+template<typename ComputeBlockType>
+void loopOverNeighborVectorBlocks(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                                  unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                                  const ComputeBlockType& cf, bool parallel = true)
+{
+    if (nlist != NULL && nlist->hasVectors())
+    {
+        const vec3<float>* vectors = nlist->getVectors().get();
+        util::forLoopWrapper(
+            0, nlist->getNumBonds(),
+            [=](size_t begin, size_t end) {
+                std::vector<NeighborBond> bonds;
+                for (size_t block_begin = begin; block_begin < end; block_begin += BOND_BLOCK_SIZE)
+                {
+                    const size_t block_end = std::min(end, block_begin + BOND_BLOCK_SIZE);
+                    bonds.clear();
+                    for (size_t bond = block_begin; bond != block_end; ++bond)
+                    {
+                        bonds.emplace_back(nlist->getNeighbors()(bond, 0), nlist->getNeighbors()(bond, 1),
+                                           nlist->getDistances()[bond], nlist->getWeights()[bond]);
+                    }
+                    cf(bonds.data(), bonds.data() + bonds.size(), vectors + block_begin);
+                }
+            },
+            parallel);
+        return;
+    }
+
+    const box::Box& box = neighbor_query->getBox();
+    switch (box::getWrapPolicy(box))
+    {
+    case box::OrthorhombicWrapPolicy:
+        loopOverWrappedNeighborVectorBlocks(box::OrthorhombicWrap(box), neighbor_query, query_points,
+                                            n_query_points, qargs, nlist, cf, parallel);
+        break;
+    case box::Orthorhombic2DWrapPolicy:
+        loopOverWrappedNeighborVectorBlocks(box::Orthorhombic2DWrap(box), neighbor_query, query_points,
+                                            n_query_points, qargs, nlist, cf, parallel);
+        break;
+    default:
+        loopOverWrappedNeighborVectorBlocks(box::TriclinicWrap(box), neighbor_query, query_points,
+                                            n_query_points, qargs, nlist, cf, parallel);
+    }
+}
+
+//! Loop over the bonds of a CompressedNeighborList one query point at a time.
+/*! This overload of loopOverNeighborsIterator reads the bonds of each query
+ *  point from a CompressedNeighborList, so computes written against the
+ *  NeighborPerPointIterator interface can use compressed lists unchanged.
+ *
+ *  \param nlist The CompressedNeighborList to loop over.
+ *  \param cf An object with operator(size_t point_index, std::shared_ptr<NeighborIterator>) as
+ *  input. It should implement iteration logic over the iterator.
+ */
+template<typename ComputePairType>
+void loopOverNeighborsIterator(const CompressedNeighborList* nlist, const ComputePairType& cf,
+                               bool parallel = true)
+{
+    util::forLoopWrapper(
+        0, nlist->getNumQueryPoints(),
+        [=](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i)
+            {
+                std::shared_ptr<CompressedNeighborListPerPointIterator> niter
+                    = std::make_shared<CompressedNeighborListPerPointIterator>(nlist, i);
+                cf(i, niter);
+            }
+        },
+        parallel);
+}
+
+//! Loop over all bonds of a CompressedNeighborList in blocks of consecutive bonds.
+/*! This overload of loopOverNeighborBlocks decodes the bonds of batches of
+ *  BULK_QUERY_BATCH_SIZE query points in parallel and passes each batch to
+ *  the compute function, so computes written against the block interface can
+ *  use compressed lists unchanged.
+ *
+ *  \param nlist The CompressedNeighborList to loop over.
+ *  \param cf An object with operator(const NeighborBond* first, const NeighborBond* last) as input.
+ */
+template<typename ComputeBlockType>
+void loopOverNeighborBlocks(const CompressedNeighborList* nlist, const ComputeBlockType& cf,
+                            bool parallel = true)
+{
+    util::forLoopWrapper(
+        0, nlist->getNumQueryPoints(),
+        [=](size_t begin, size_t end) {
+            std::vector<NeighborBond> bonds;
+            for (size_t batch_begin = begin; batch_begin < end; batch_begin += BULK_QUERY_BATCH_SIZE)
+            {
+                const size_t batch_end = std::min(end, batch_begin + BULK_QUERY_BATCH_SIZE);
+                bonds.clear();
+                for (size_t i = batch_begin; i != batch_end; ++i)
+                {
+                    for (CompressedNeighborList::Cursor cursor(nlist, i); !cursor.done();)
+                    {
+                        bonds.push_back(cursor.next());
+                    }
+                }
+                if (!bonds.empty())
+                {
+                    cf(bonds.data(), bonds.data() + bonds.size());
+                }
+            }
+        },
+        parallel);
+}
+
 }; }; // end namespace freud::locality
 
 #endif // NEIGHBOR_COMPUTE_FUNCTIONAL_H
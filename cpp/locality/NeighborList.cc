@@ -1,7 +1,12 @@
 // Copyright (c) 2010-2019 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <atomic>
+#include <tbb/tbb.h>
+
 #include "NeighborList.h"
+#include "utils.h"
 
 namespace freud { namespace locality {
 
@@ -66,6 +71,7 @@ unsigned int NeighborList::getNumPoints() const
 void NeighborList::setNumBonds(unsigned int num_bonds, unsigned int num_query_points, unsigned int num_points)
 {
     resize(num_bonds);
+    clearVectors();
     m_num_query_points = num_query_points;
     m_num_points = num_points;
     m_segments_counts_updated = false;
@@ -106,11 +112,54 @@ void NeighborList::updateSegmentCounts() const
     }
 }
 
+namespace {
+//! Compute the vectors of bonds stored as (query point, point) index pairs with a wrapping policy.
+template<typename WrapPolicy>
+void computeWrappedVectors(const WrapPolicy& wrap, const unsigned int* neighbors, unsigned int num_bonds,
+                           const vec3<float>* points, const vec3<float>* query_points, vec3<float>* vectors)
+{
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+        for (size_t bond = begin; bond < end; ++bond)
+        {
+            vectors[bond] = wrap(points[neighbors[2 * bond + 1]] - query_points[neighbors[2 * bond]]);
+        }
+    });
+}
+} // namespace
+
+void NeighborList::computeVectors(const box::Box& box, const vec3<float>* points,
+                                  const vec3<float>* query_points)
+{
+    const unsigned int num_bonds = getNumBonds();
+    m_vectors.prepare(num_bonds);
+    const unsigned int* neighbors = m_neighbors.get();
+    vec3<float>* vectors = m_vectors.get();
+    switch (box::getWrapPolicy(box))
+    {
+    case box::OrthorhombicWrapPolicy:
+        computeWrappedVectors(box::OrthorhombicWrap(box), neighbors, num_bonds, points, query_points,
+                              vectors);
+        break;
+    case box::Orthorhombic2DWrapPolicy:
+        computeWrappedVectors(box::Orthorhombic2DWrap(box), neighbors, num_bonds, points, query_points,
+                              vectors);
+        break;
+    default:
+        computeWrappedVectors(box::TriclinicWrap(box), neighbors, num_bonds, points, query_points, vectors);
+    }
+}
+
+void NeighborList::clearVectors()
+{
+    m_vectors = util::ManagedArray<vec3<float>>();
+}
+
 unsigned int NeighborList::filter(const bool* filt)
 {
     // number of good (unfiltered-out) elements so far
     unsigned int num_good(0);
     const unsigned int old_size(getNumBonds());
+    const bool has_vectors(hasVectors());
 
     for (unsigned int i(0); i < old_size; ++i)
     {
@@ -120,6 +169,10 @@ unsigned int NeighborList::filter(const bool* filt)
             m_neighbors(num_good, 1) = m_neighbors(i, 1);
             m_weights[num_good] = m_weights[i];
             m_distances[num_good] = m_distances[i];
+            if (has_vectors)
+            {
+                m_vectors[num_good] = m_vectors[i];
+            }
             ++num_good;
         }
     }
@@ -146,11 +199,155 @@ unsigned int NeighborList::find_first_index(unsigned int i) const
         return 0;
 }
 
+void NeighborList::mirror()
+{
+    if (m_num_query_points != m_num_points)
+    {
+        throw std::runtime_error("Only NeighborLists between a set of points and itself can be mirrored.");
+    }
+    const unsigned int num_bonds = getNumBonds();
+    const unsigned int num_points = m_num_points;
+    const unsigned int* neighbors = m_neighbors.get();
+    const float* distances = m_distances.get();
+    const float* weights = m_weights.get();
+    const bool has_vectors = hasVectors();
+    const vec3<float>* vectors = has_vectors ? m_vectors.get() : NULL;
+
+    // Count the bonds of each point in the mirrored list.
+    std::vector<std::atomic<unsigned int>> counts(num_points);
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+        for (size_t bond = begin; bond < end; ++bond)
+        {
+            const unsigned int i = neighbors[2 * bond];
+            const unsigned int j = neighbors[2 * bond + 1];
+            counts[i].fetch_add(1, std::memory_order_relaxed);
+            if (i != j)
+            {
+                counts[j].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // The exclusive prefix sum of the counts gives the start of each segment.
+    std::vector<unsigned int> segments(num_points + 1, 0);
+    tbb::parallel_scan(
+        tbb::blocked_range<size_t>(0, num_points), static_cast<unsigned int>(0),
+        [&](const tbb::blocked_range<size_t>& r, unsigned int sum, bool is_final_scan) {
+            for (size_t i = r.begin(); i < r.end(); ++i)
+            {
+                sum += counts[i].load(std::memory_order_relaxed);
+                if (is_final_scan)
+                {
+                    segments[i + 1] = sum;
+                }
+            }
+            return sum;
+        },
+        [](unsigned int left, unsigned int right) { return left + right; });
+
+    // Scatter each bond and its reverse into their segments, reusing the
+    // counts as insertion cursors, then sort each (short) segment.
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            counts[i].store(segments[i], std::memory_order_relaxed);
+        }
+    });
+    // Bond vectors are scattered alongside the bonds, the reverse of a bond
+    // having the opposite vector.
+    std::vector<NeighborBond> bonds(segments[num_points]);
+    std::vector<vec3<float>> bond_vectors(has_vectors ? bonds.size() : 0);
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+        for (size_t bond = begin; bond < end; ++bond)
+        {
+            const unsigned int i = neighbors[2 * bond];
+            const unsigned int j = neighbors[2 * bond + 1];
+            const unsigned int forward = counts[i].fetch_add(1, std::memory_order_relaxed);
+            bonds[forward] = NeighborBond(i, j, distances[bond], weights[bond]);
+            if (has_vectors)
+            {
+                bond_vectors[forward] = vectors[bond];
+            }
+            if (i != j)
+            {
+                const unsigned int reverse = counts[j].fetch_add(1, std::memory_order_relaxed);
+                bonds[reverse] = NeighborBond(j, i, distances[bond], weights[bond]);
+                if (has_vectors)
+                {
+                    bond_vectors[reverse] = -vectors[bond];
+                }
+            }
+        }
+    });
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        std::vector<unsigned int> order;
+        std::vector<NeighborBond> sorted_bonds;
+        std::vector<vec3<float>> sorted_vectors;
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!has_vectors)
+            {
+                std::sort(bonds.begin() + segments[i], bonds.begin() + segments[i + 1], compareNeighborBond);
+                continue;
+            }
+            // Sort the bonds of the segment through a permutation that is
+            // also applied to their vectors.
+            const unsigned int first = segments[i];
+            const unsigned int count = segments[i + 1] - first;
+            order.resize(count);
+            for (unsigned int k = 0; k < count; ++k)
+            {
+                order[k] = first + k;
+            }
+            std::sort(order.begin(), order.end(), [&](unsigned int left, unsigned int right) {
+                return compareNeighborBond(bonds[left], bonds[right]);
+            });
+            sorted_bonds.resize(count);
+            sorted_vectors.resize(count);
+            for (unsigned int k = 0; k < count; ++k)
+            {
+                sorted_bonds[k] = bonds[order[k]];
+                sorted_vectors[k] = bond_vectors[order[k]];
+            }
+            std::copy(sorted_bonds.begin(), sorted_bonds.end(), bonds.begin() + first);
+            std::copy(sorted_vectors.begin(), sorted_vectors.end(), bond_vectors.begin() + first);
+        }
+    });
+
+    const unsigned int new_num_bonds = bonds.size();
+    setNumBonds(new_num_bonds, num_points, num_points);
+    unsigned int* new_neighbors = m_neighbors.get();
+    float* new_distances = m_distances.get();
+    float* new_weights = m_weights.get();
+    vec3<float>* new_vectors = NULL;
+    if (has_vectors)
+    {
+        m_vectors.prepare(new_num_bonds);
+        new_vectors = m_vectors.get();
+    }
+    util::forLoopWrapper(0, new_num_bonds, [&](size_t begin, size_t end) {
+        for (size_t bond = begin; bond < end; ++bond)
+        {
+            new_neighbors[2 * bond] = bonds[bond].query_point_idx;
+            new_neighbors[2 * bond + 1] = bonds[bond].point_idx;
+            new_distances[bond] = bonds[bond].distance;
+            new_weights[bond] = bonds[bond].weight;
+            if (has_vectors)
+            {
+                new_vectors[bond] = bond_vectors[bond];
+            }
+        }
+    });
+}
+
 void NeighborList::resize(unsigned int num_bonds)
 {
     auto new_neighbors = util::ManagedArray<unsigned int>({num_bonds, 2});
     auto new_distances = util::ManagedArray<float>(num_bonds);
     auto new_weights = util::ManagedArray<float>(num_bonds);
+    // Bond vectors are only kept on shrinking resizes.
+    const bool keep_vectors = hasVectors() && num_bonds <= getNumBonds();
+    auto new_vectors = util::ManagedArray<vec3<float>>(keep_vectors ? num_bonds : 0);
 
     // On shrinking resizes, keep existing data.
     if (num_bonds <= getNumBonds())
@@ -161,12 +358,17 @@ void NeighborList::resize(unsigned int num_bonds)
             new_neighbors(i, 1) = m_neighbors(i, 1);
             new_distances[i] = m_distances[i];
             new_weights[i] = m_weights[i];
+            if (keep_vectors)
+            {
+                new_vectors[i] = m_vectors[i];
+            }
         }
     }
 
     m_neighbors = new_neighbors;
     m_distances = new_distances;
     m_weights = new_weights;
+    m_vectors = new_vectors;
     m_segments_counts_updated = false;
 }
 
@@ -176,6 +378,7 @@ void NeighborList::copy(const NeighborList& other)
     m_neighbors = other.m_neighbors.copy();
     m_weights = other.m_weights.copy();
     m_distances = other.m_distances.copy();
+    m_vectors = other.m_vectors.copy();
     m_segments_counts_updated = false;
 }
 
@@ -23,6 +23,9 @@ namespace freud { namespace locality {
 
     Query point and point indices are stored in a 2D array m_neighbors of shape
     (n_bonds, 2). The distances and weights arrays are flat per-bond arrays.
+    Optionally, the wrapped vector of each bond (point - query_point) is
+    stored in a per-bond array of vectors, so that computes do not need to
+    recompute it (see computeVectors).
  */
 class NeighborList
 {
@@ -65,6 +68,11 @@ public:
     {
         return m_weights;
     }
+    //! Access the bond vectors array for reading and writing
+    util::ManagedArray<vec3<float>>& getVectors()
+    {
+        return m_vectors;
+    }
     //! Access the counts array for reading
     util::ManagedArray<unsigned int>& getCounts()
     {
@@ -93,6 +101,11 @@ public:
     {
         return m_weights;
     }
+    //! Access the bond vectors array for reading
+    const util::ManagedArray<vec3<float>>& getVectors() const
+    {
+        return m_vectors;
+    }
     //! Access the counts array for reading
     const util::ManagedArray<unsigned int>& getCounts() const
     {
@@ -106,6 +119,16 @@ public:
         return m_segments;
     }
 
+    //! Return whether the wrapped vector of every bond is stored
+    bool hasVectors() const
+    {
+        return m_vectors.size() != 0 && m_vectors.size() == getNumBonds();
+    }
+    //! Compute and store the wrapped vector (point - query_point) of every bond
+    void computeVectors(const box::Box& box, const vec3<float>* points, const vec3<float>* query_points);
+    //! Discard the stored bond vectors
+    void clearVectors();
+
     //! Remove bonds in this object based on an array of boolean values. The
     //  array must be at least as long as the number of neighbor bonds.
     //  Returns the number of bonds removed.
@@ -117,6 +140,11 @@ public:
     //! Return the first bond index corresponding to point i
     unsigned int find_first_index(unsigned int i) const;
 
+    //! Add the reverse (j, i) of every bond (i, j) with i != j, keeping the list sorted.
+    //  This converts a list containing each pair of a set of points with
+    //  itself only once (e.g. from a symmetric_half query) into the full list.
+    void mirror();
+
     //! Resize member arrays to a different size
     void resize(unsigned int num_bonds);
 
@@ -140,6 +168,8 @@ private:
     util::ManagedArray<float> m_distances;
     //! Neighbor list per-bond weight array
     util::ManagedArray<float> m_weights;
+    //! Neighbor list per-bond vector array (empty if the vectors are not stored)
+    util::ManagedArray<vec3<float>> m_vectors;
 
     //! Track whether segments and counts are up to date
     mutable bool m_segments_counts_updated;
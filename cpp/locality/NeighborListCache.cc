@@ -0,0 +1,162 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <limits>
+
+#include "NeighborListCache.h"
+
+/*! \file NeighborListCache.cc
+    \brief Shares neighbor lists between computes that perform the same query.
+*/
+
+namespace freud { namespace locality {
+
+NeighborListCache::NeighborListCache(size_t max_memory)
+    : m_max_memory(max_memory), m_memory_usage(0), m_num_hits(0), m_num_misses(0)
+{}
+
+std::shared_ptr<NeighborList> NeighborListCache::get(const NeighborQuery* nq, const vec3<float>* query_points,
+                                                     unsigned int n_query_points, QueryArgs qargs)
+{
+    const Key key = makeKey(nq, query_points, n_query_points, qargs);
+
+    // Neighbors are found while holding the lock so that concurrent requests
+    // for the same query do not find them more than once.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<Key, std::list<Entry>::iterator>::iterator cached = m_index.find(key);
+    if (cached != m_index.end())
+    {
+        ++m_num_hits;
+        m_entries.splice(m_entries.begin(), m_entries, cached->second);
+        return cached->second->nlist;
+    }
+
+    ++m_num_misses;
+    std::shared_ptr<NeighborList> nlist(nq->query(query_points, n_query_points, qargs)->toNeighborList());
+    Entry entry;
+    entry.key = key;
+    entry.nlist = nlist;
+    entry.memory = getNeighborListMemory(*nlist);
+
+    // Lists larger than the whole cache are returned without being cached.
+    if (entry.memory <= m_max_memory)
+    {
+        evict(m_max_memory - entry.memory);
+        m_entries.push_front(entry);
+        m_index[key] = m_entries.begin();
+        m_memory_usage += entry.memory;
+    }
+    return nlist;
+}
+
+void NeighborListCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_memory_usage = 0;
+}
+
+size_t NeighborListCache::getMaxMemory() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_max_memory;
+}
+
+void NeighborListCache::setMaxMemory(size_t max_memory)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_memory = max_memory;
+    evict(m_max_memory);
+}
+
+size_t NeighborListCache::getMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memory_usage;
+}
+
+unsigned int NeighborListCache::getNumEntries() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+unsigned int NeighborListCache::getNumHits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_num_hits;
+}
+
+unsigned int NeighborListCache::getNumMisses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_num_misses;
+}
+
+size_t NeighborListCache::getNeighborListMemory(const NeighborList& nlist)
+{
+    // Each bond stores two indices, a distance, a weight, and possibly a
+    // vector, and each query point a count and a segment.
+    return size_t(nlist.getNumBonds()) * (2 * sizeof(unsigned int) + 2 * sizeof(float))
+        + nlist.getVectors().size() * sizeof(vec3<float>)
+        + size_t(nlist.getNumQueryPoints()) * 2 * sizeof(unsigned int);
+}
+
+NeighborListCache::Key NeighborListCache::makeKey(const NeighborQuery* nq, const vec3<float>* query_points,
+                                                  unsigned int n_query_points, const QueryArgs& qargs)
+{
+    // The NeighborQuery's own points are identified by its version. Other
+    // query points are identified by a 64-bit FNV-1a hash of their
+    // coordinates, since their memory may be reused for different points.
+    uint64_t query_points_hash = 0;
+    if (query_points != nq->getPoints())
+    {
+        query_points_hash = 14695981039346656037ULL;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(query_points);
+        const size_t num_bytes = size_t(n_query_points) * sizeof(vec3<float>);
+        for (size_t i = 0; i < num_bytes; ++i)
+        {
+            query_points_hash = (query_points_hash ^ bytes[i]) * 1099511628211ULL;
+        }
+        // Never collide with the NeighborQuery's own points.
+        query_points_hash |= 1;
+    }
+    // Equivalent query arguments are given the same key, inferring the mode
+    // and the r_max of nearest neighbor queries in the same way as
+    // NeighborQuery::validateQueryArgs.
+    QueryArgs::QueryType mode = qargs.mode;
+    if (mode == QueryArgs::none)
+    {
+        if (qargs.num_neighbors != QueryArgs::DEFAULT_NUM_NEIGHBORS)
+        {
+            mode = QueryArgs::nearest;
+        }
+        else if (qargs.r_max != QueryArgs::DEFAULT_R_MAX)
+        {
+            mode = QueryArgs::ball;
+        }
+    }
+    float r_max = qargs.r_max;
+    if (mode == QueryArgs::nearest && r_max == QueryArgs::DEFAULT_R_MAX)
+    {
+        r_max = std::numeric_limits<float>::infinity();
+    }
+
+    return Key(nq->getVersion(), query_points_hash, n_query_points, static_cast<int>(mode),
+               qargs.num_neighbors, r_max, qargs.r_min, qargs.r_guess, qargs.scale, qargs.exclude_ii,
+               qargs.symmetric_half);
+}
+
+void NeighborListCache::evict(size_t max_memory)
+{
+    while (m_memory_usage > max_memory && !m_entries.empty())
+    {
+        const Entry& entry = m_entries.back();
+        m_memory_usage -= entry.memory;
+        m_index.erase(entry.key);
+        m_entries.pop_back();
+    }
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,115 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef NEIGHBOR_LIST_CACHE_H
+#define NEIGHBOR_LIST_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+
+/*! \file NeighborListCache.h
+    \brief Shares neighbor lists between computes that perform the same query.
+*/
+
+namespace freud { namespace locality {
+
+//! Default maximum memory used by the neighbor lists of a NeighborListCache (1 GiB).
+const size_t NEIGHBOR_LIST_CACHE_DEFAULT_MAX_MEMORY = size_t(1) << 30;
+
+//! Cache of neighbor lists keyed on the query that produced them
+/*! Several computes run on the same frame with the same query arguments each
+ *  find the same neighbors. A NeighborListCache builds the NeighborList of
+ *  each distinct query once and returns the same list to all later requests.
+ *
+ *  Lists are keyed on the version of the NeighborQuery (see
+ *  NeighborQuery::getVersion), the query points, and all query arguments.
+ *  Query points that are the NeighborQuery's own points are identified by
+ *  the version alone, while other query points are identified by a hash of
+ *  their coordinates. A cached list is therefore never returned for a
+ *  NeighborQuery whose points have changed.
+ *
+ *  The cache holds at most max_memory bytes of neighbor lists, evicting the
+ *  least recently used lists first. Lists are returned as shared pointers,
+ *  so evicted lists remain valid for as long as they are in use.
+ */
+class NeighborListCache
+{
+public:
+    //! Constructor
+    /*! \param max_memory The maximum number of bytes of neighbor lists to keep.
+     */
+    NeighborListCache(size_t max_memory = NEIGHBOR_LIST_CACHE_DEFAULT_MAX_MEMORY);
+
+    //! Return the NeighborList of a query, finding the neighbors only if it is not cached.
+    /*! \param nq The NeighborQuery to find neighbors with.
+     *  \param query_points The points to find neighbors for.
+     *  \param n_query_points The number of query points.
+     *  \param qargs The query arguments that should be used to find neighbors.
+     */
+    std::shared_ptr<NeighborList> get(const NeighborQuery* nq, const vec3<float>* query_points,
+                                      unsigned int n_query_points, QueryArgs qargs);
+
+    //! Remove all neighbor lists from the cache
+    void clear();
+
+    //! Return the maximum number of bytes of neighbor lists to keep
+    size_t getMaxMemory() const;
+
+    //! Set the maximum number of bytes of neighbor lists to keep, evicting lists if necessary
+    void setMaxMemory(size_t max_memory);
+
+    //! Return the number of bytes used by the cached neighbor lists
+    size_t getMemoryUsage() const;
+
+    //! Return the number of cached neighbor lists
+    unsigned int getNumEntries() const;
+
+    //! Return the number of requests answered from the cache
+    unsigned int getNumHits() const;
+
+    //! Return the number of requests that required finding neighbors
+    unsigned int getNumMisses() const;
+
+    //! Return the number of bytes used by a NeighborList
+    static size_t getNeighborListMemory(const NeighborList& nlist);
+
+private:
+    //! Version, query point hash, number of query points, and query arguments of a query.
+    typedef std::tuple<uint64_t, uint64_t, unsigned int, int, unsigned int, float, float, float, float, bool,
+                       bool>
+        Key;
+    //! A cached list with its key and size.
+    struct Entry
+    {
+        Key key;                             //!< The query that found the list.
+        std::shared_ptr<NeighborList> nlist; //!< The neighbor list.
+        size_t memory;                       //!< The number of bytes used by the list.
+    };
+
+    //! Build the key identifying a query.
+    static Key makeKey(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                       const QueryArgs& qargs);
+
+    //! Evict the least recently used lists until at most max_memory bytes are used.
+    void evict(size_t max_memory);
+
+    mutable std::mutex m_mutex;                        //!< Guards all members.
+    size_t m_max_memory;                               //!< Maximum bytes of neighbor lists to keep.
+    size_t m_memory_usage;                             //!< Bytes used by the cached neighbor lists.
+    std::list<Entry> m_entries;                        //!< Cached lists, most recently used first.
+    std::map<Key, std::list<Entry>::iterator> m_index; //!< The cached list of each query.
+    unsigned int m_num_hits;                           //!< Requests answered from the cache.
+    unsigned int m_num_misses;                         //!< Requests that required finding neighbors.
+};
+
+}; }; // end namespace freud::locality
+
+#endif // NEIGHBOR_LIST_CACHE_H
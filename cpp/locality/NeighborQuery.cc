@@ -14,4 +14,23 @@ const float QueryArgs::DEFAULT_R_MIN(0);
 const float QueryArgs::DEFAULT_R_GUESS(-1.0);
 const float QueryArgs::DEFAULT_SCALE(-1.0);
 const bool QueryArgs::DEFAULT_EXCLUDE_II(false);
+const bool QueryArgs::DEFAULT_SYMMETRIC_HALF(false);
+
+void NeighborQuery::queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                              QueryArgs args, std::vector<NeighborBond>& bonds) const
+{
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        std::shared_ptr<NeighborQueryPerPointIterator> it = this->querySingle(query_points[i], i, args);
+        while (!it->end())
+        {
+            NeighborBond nb = it->next();
+            if (nb != NeighborQueryIterator::ITERATOR_TERMINATOR && !(args.symmetric_half && nb.point_idx < i))
+            {
+                bonds.push_back(nb);
+            }
+        }
+    }
+}
+
 }; }; // end namespace freud::locality
@@ -4,9 +4,13 @@
 #ifndef NEIGHBOR_QUERY_H
 #define NEIGHBOR_QUERY_H
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <tbb/tbb.h>
+#include <vector>
 
 #include "Box.h"
 #include "NeighborBond.h"
@@ -21,6 +25,29 @@
 
 namespace freud { namespace locality {
 
+//! Number of query points whose bonds are found together when building a NeighborList.
+const unsigned int NEIGHBOR_LIST_BLOCK_SIZE = 256;
+
+//! Sort the bonds of each query point in a buffer of bonds grouped by query point.
+/*! Bulk queries return the bonds of each query point contiguously, in
+ *  increasing order of query point. Sorting each of these short runs with
+ *  compareNeighborBond puts the bonds in the order of a NeighborList.
+ */
+inline void sortBondsByQueryPoint(std::vector<NeighborBond>& bonds)
+{
+    std::vector<NeighborBond>::iterator run_begin = bonds.begin();
+    while (run_begin != bonds.end())
+    {
+        std::vector<NeighborBond>::iterator run_end = run_begin + 1;
+        while (run_end != bonds.end() && run_end->query_point_idx == run_begin->query_point_idx)
+        {
+            ++run_end;
+        }
+        std::sort(run_begin, run_end, compareNeighborBond);
+        run_begin = run_end;
+    }
+}
+
 //! POD class to hold information about generic queries.
 /*! This class provides a standard method for specifying the type of query to
  *  perform with a NeighborQuery object. Rather than calling queryBall
@@ -34,7 +61,8 @@ struct QueryArgs
      */
     QueryArgs()
         : mode(DEFAULT_MODE), num_neighbors(DEFAULT_NUM_NEIGHBORS), r_max(DEFAULT_R_MAX),
-          r_min(DEFAULT_R_MIN), r_guess(DEFAULT_R_GUESS), scale(DEFAULT_SCALE), exclude_ii(DEFAULT_EXCLUDE_II)
+          r_min(DEFAULT_R_MIN), r_guess(DEFAULT_R_GUESS), scale(DEFAULT_SCALE), exclude_ii(DEFAULT_EXCLUDE_II),
+          symmetric_half(DEFAULT_SYMMETRIC_HALF)
     {}
 
     //! Enumeration for types of queries.
@@ -54,6 +82,8 @@ struct QueryArgs
     float scale; //! The scale factor to use when performing repeated ball queries to find a specified number
                  //! of nearest neighbors.
     bool exclude_ii; //! If true, exclude self-neighbors.
+    bool symmetric_half; //! If true, only find bonds (i, j) with j >= i. This is only valid for ball queries of
+                         //! a set of points against itself, where each unordered pair is then found once.
 
     static const QueryType DEFAULT_MODE;             //!< Default mode.
     static const unsigned int DEFAULT_NUM_NEIGHBORS; //!< Default number of neighbors.
@@ -62,6 +92,7 @@ struct QueryArgs
     static const float DEFAULT_R_GUESS;              //!< Default guess query distance.
     static const float DEFAULT_SCALE;     //!< Default scaling parameter for AABB nearest neighbor queries.
     static const bool DEFAULT_EXCLUDE_II; //!< Default for whether or not to include self-neighbors.
+    static const bool DEFAULT_SYMMETRIC_HALF; //!< Default for whether or not to only find half of the bonds.
 };
 
 // Forward declare the iterators
@@ -79,11 +110,11 @@ class NeighborQuery
 {
 public:
     //! Nullary constructor for Cython
-    NeighborQuery() {}
+    NeighborQuery() : m_version(nextVersion()) {}
 
     //! Constructor
     NeighborQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points)
-        : m_box(box), m_points(points), m_n_points(n_points)
+        : m_box(box), m_points(points), m_n_points(n_points), m_version(nextVersion())
     {
         // For 2D systems, check if any z-coordinates are outside some tolerance of z=0
         if (m_box.is2D())
@@ -133,6 +164,28 @@ public:
     virtual std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const = 0;
 
+    //! Find the neighbors of a contiguous range of query points in bulk.
+    /*! All bonds of the query points with indices in [begin, end) are
+     *  appended to \c bonds, grouped by query point in increasing index order.
+     *  The bonds of each query point are produced in the same order as
+     *  iterating over the result of querySingle would produce them. The
+     *  default implementation does exactly that (additionally dropping bonds
+     *  with point_idx < query_point_idx if args.symmetric_half is set);
+     *  subclasses should override it with loops that avoid constructing a
+     *  per-point iterator and calling next() for every bond, and that reject
+     *  the pairs excluded by symmetric_half before computing distances. Since
+     *  \c bonds is only appended to, callers can reuse a single (e.g.
+     *  thread-local) buffer across calls to avoid repeated allocations.
+     *
+     *  \param query_points The points to find neighbors for.
+     *  \param begin The index of the first query point to find neighbors for.
+     *  \param end One past the index of the last query point to find neighbors for.
+     *  \param args The query arguments that should be used to find neighbors.
+     *  \param bonds The buffer to append bonds to.
+     */
+    virtual void queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                           QueryArgs args, std::vector<NeighborBond>& bonds) const;
+
     //! Get the simulation box
     const box::Box& getBox() const
     {
@@ -151,6 +204,17 @@ public:
         return m_n_points;
     }
 
+    //! Get a number identifying this object and the current state of its points
+    /*! Versions are unique across all NeighborQuery objects, and a new
+     *  version is assigned whenever the points of an object change, so two
+     *  calls returning the same version are guaranteed to refer to the same
+     *  points. This allows results (such as neighbor lists) to be cached.
+     */
+    uint64_t getVersion() const
+    {
+        return m_version;
+    }
+
     //! Get a point's coordinates using index operator notation
     /*! \param index The point index to return.
      */
@@ -198,6 +262,11 @@ protected:
         {
             throw std::runtime_error("Unknown mode");
         }
+
+        if (args.symmetric_half && args.mode != QueryArgs::ball)
+        {
+            throw std::runtime_error("The symmetric_half query argument is only supported for ball queries.");
+        }
     }
 
     //! Try to determine the query mode if one is not specified.
@@ -222,9 +291,25 @@ protected:
         }
     }
 
+    //! Assign a new version, to be called by subclasses whenever their points change.
+    void updateVersion()
+    {
+        m_version = nextVersion();
+    }
+
     const box::Box m_box;        //!< Simulation box where the particles belong.
     const vec3<float>* m_points; //!< Point coordinates.
     unsigned int m_n_points;     //!< Number of points.
+
+private:
+    //! Return a version that has not been used by any NeighborQuery.
+    static uint64_t nextVersion()
+    {
+        static std::atomic<uint64_t> version_counter(0);
+        return ++version_counter;
+    }
+
+    uint64_t m_version; //!< Identifies this object and the current state of its points.
 };
 
 //! Implementation of per-point finding logic for NeighborQuery objects.
@@ -297,6 +382,13 @@ public:
         : m_neighbor_query(neighbor_query), m_query_points(query_points),
           m_num_query_points(num_query_points), m_qargs(qargs), m_finished(false), m_cur_p(0)
     {
+        if (m_qargs.symmetric_half
+            && (m_query_points != m_neighbor_query->getPoints()
+                || m_num_query_points != m_neighbor_query->getNPoints()))
+        {
+            throw std::runtime_error("The symmetric_half query argument requires the query points to be the "
+                                     "same as the points.");
+        }
         m_iter = this->query(m_cur_p);
     }
 
@@ -310,11 +402,22 @@ public:
     }
 
     //! Get an iterator for a specific query point by index.
+    /*! Note that per-point iterators do not apply the symmetric_half query
+     *  argument; they always find all neighbors of the query point.
+     */
     std::shared_ptr<NeighborQueryPerPointIterator> query(unsigned int i)
     {
         return m_neighbor_query->querySingle(m_query_points[i], i, m_qargs);
     }
 
+    //! Append the bonds of a contiguous range of query points to a buffer.
+    /*! See NeighborQuery::queryBulk for details.
+     */
+    void queryBulk(unsigned int begin, unsigned int end, std::vector<NeighborBond>& bonds) const
+    {
+        m_neighbor_query->queryBulk(m_query_points, begin, end, m_qargs, bonds);
+    }
+
     //! Get the next element.
     NeighborBond next()
     {
@@ -327,7 +430,7 @@ public:
             {
                 nb = m_iter->next();
 
-                if (nb != ITERATOR_TERMINATOR)
+                if (nb != ITERATOR_TERMINATOR && !(m_qargs.symmetric_half && nb.point_idx < nb.query_point_idx))
                 {
                     return nb;
                 }
@@ -342,59 +445,83 @@ public:
     }
 
     //! Generate a NeighborList from query.
-    /*! This function exploits parallelism by finding the neighbors for
-     *  each query point in parallel and adding them to a list, which is
-     *  then sorted in parallel as well before being added to the
-     *  NeighborList object. Right now this won't be backwards compatible
+    /*! This function exploits parallelism by finding the neighbors of fixed
+     *  blocks of query points in parallel (using the bulk query interface).
+     *  Since the bonds of each block are grouped by query point in increasing
+     *  order, only the (short) run of bonds of each query point needs to be
+     *  sorted. A prefix sum of the number of bonds in each block then gives
+     *  the range of the NeighborList that each block fills, and the blocks
+     *  are copied into the NeighborList in parallel. The result is the same
+     *  as sorting all bonds, without the memory and time needed for a global
+     *  sort. Right now this won't be backwards compatible
      *  because the kn query is not symmetric, so even if we reverse the
      *  output order here the actual neighbors found will be different.
      *
+     *  If store_vectors is true, the wrapped vector of each bond
+     *  (point - query_point) is also computed while the bonds are copied and
+     *  stored in the NeighborList (see NeighborList::getVectors).
+     *
      *  This function returns a pointer, not a shared pointer, so the
      *  caller is responsible for deleting it. The reason for this is that
      *  the primary use-case is to have this object be managed by instances
      *  of the Cython NeighborList class.
      */
-    NeighborList* toNeighborList()
+    NeighborList* toNeighborList(bool store_vectors = false)
     {
-        typedef tbb::enumerable_thread_specific<std::vector<NeighborBond>> BondVector;
-        BondVector bonds;
-        util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
-            BondVector::reference local_bonds(bonds.local());
-            NeighborBond nb;
-            for (size_t i = begin; i < end; ++i)
+        // Pass 1: find and sort the bonds of each block of query points.
+        const size_t num_blocks
+            = (size_t(m_num_query_points) + NEIGHBOR_LIST_BLOCK_SIZE - 1) / NEIGHBOR_LIST_BLOCK_SIZE;
+        std::vector<std::vector<NeighborBond>> block_bonds(num_blocks);
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
             {
-                std::shared_ptr<NeighborQueryPerPointIterator> it = this->query(i);
-                while (!it->end())
-                {
-                    nb = it->next();
-                    // If we're excluding ii bonds, we have to check before adding.
-                    if (nb != ITERATOR_TERMINATOR)
-                    {
-                        local_bonds.emplace_back(nb.query_point_idx, nb.point_idx, nb.distance);
-                    }
-                }
+                std::vector<NeighborBond>& bonds = block_bonds[block];
+                const unsigned int first = block * NEIGHBOR_LIST_BLOCK_SIZE;
+                const unsigned int last = std::min(m_num_query_points, first + NEIGHBOR_LIST_BLOCK_SIZE);
+                this->queryBulk(first, last, bonds);
+                sortBondsByQueryPoint(bonds);
             }
         });
 
-        tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(bonds);
-        std::vector<NeighborBond> linear_bonds(flat_bonds.begin(), flat_bonds.end());
-        tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborBond);
-
-        unsigned int num_bonds = linear_bonds.size();
+        // The exclusive prefix sum of the block sizes gives the first bond of
+        // each block in the NeighborList.
+        std::vector<size_t> block_offsets(num_blocks + 1, 0);
+        for (size_t block = 0; block < num_blocks; ++block)
+        {
+            block_offsets[block + 1] = block_offsets[block] + block_bonds[block].size();
+        }
+        const unsigned int num_bonds = block_offsets[num_blocks];
 
         NeighborList* nl = new NeighborList();
         nl->setNumBonds(num_bonds, m_num_query_points, m_neighbor_query->getNPoints());
-
-        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
-            for (size_t bond = begin; bond < end; ++bond)
+        unsigned int* neighbors = nl->getNeighbors().get();
+        float* distances = nl->getDistances().get();
+        float* weights = nl->getWeights().get();
+
+        // Pass 2: copy each block into its range, releasing blocks as they
+        // are copied.
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
             {
-                nl->getNeighbors()(bond, 0) = linear_bonds[bond].query_point_idx;
-                nl->getNeighbors()(bond, 1) = linear_bonds[bond].point_idx;
-                nl->getDistances()[bond] = linear_bonds[bond].distance;
-                nl->getWeights()[bond] = float(1.0);
+                const std::vector<NeighborBond>& bonds = block_bonds[block];
+                size_t bond = block_offsets[block];
+                for (std::vector<NeighborBond>::const_iterator nb = bonds.begin(); nb != bonds.end();
+                     ++nb, ++bond)
+                {
+                    neighbors[2 * bond] = nb->query_point_idx;
+                    neighbors[2 * bond + 1] = nb->point_idx;
+                    distances[bond] = nb->distance;
+                    weights[bond] = float(1.0);
+                }
+                std::vector<NeighborBond>().swap(block_bonds[block]);
             }
         });
 
+        if (store_vectors)
+        {
+            nl->computeVectors(m_neighbor_query->getBox(), m_neighbor_query->getPoints(), m_query_points);
+        }
+
         return nl;
     }
 
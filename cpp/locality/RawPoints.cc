@@ -0,0 +1,128 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "RawPoints.h"
+
+/*! \file RawPoints.cc
+    \brief Automatic selection of the NeighborQuery used to answer queries.
+*/
+
+namespace freud { namespace locality {
+
+std::shared_ptr<NeighborQueryIterator> RawPoints::query(const vec3<float>* query_points,
+                                                        unsigned int n_query_points,
+                                                        QueryArgs query_args) const
+{
+    this->validateQueryArgs(query_args);
+    return std::make_shared<NeighborQueryIterator>(getBackend(query_args), query_points, n_query_points,
+                                                   query_args);
+}
+
+std::shared_ptr<NeighborQueryPerPointIterator>
+RawPoints::querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs qargs) const
+{
+    this->validateQueryArgs(qargs);
+    return getBackend(qargs)->querySingle(query_point, query_point_idx, qargs);
+}
+
+void RawPoints::queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                          QueryArgs qargs, std::vector<NeighborBond>& bonds) const
+{
+    this->validateQueryArgs(qargs);
+    getBackend(qargs)->queryBulk(query_points, begin, end, qargs, bonds);
+}
+
+const NeighborQuery* RawPoints::getBackend(const QueryArgs& qargs) const
+{
+    std::lock_guard<std::mutex> lock(m_backend_mutex);
+    const BackendKey key(static_cast<int>(qargs.mode), qargs.r_max);
+    std::map<BackendKey, const NeighborQuery*>::const_iterator backend = m_backends.find(key);
+    if (backend != m_backends.end())
+    {
+        return backend->second;
+    }
+    const NeighborQuery* selected = selectBackend(qargs);
+    m_backends[key] = selected;
+    return selected;
+}
+
+const NeighborQuery* RawPoints::selectBackend(const QueryArgs& qargs) const
+{
+    if (qargs.mode == QueryArgs::ball && m_n_points > 0)
+    {
+        const bool is2D = m_box.is2D();
+        const vec3<bool> periodic = m_box.getPeriodic();
+        const float dim = is2D ? 2 : 3;
+
+        // Cells narrower than the typical spacing of the points would mostly
+        // be empty, so the cells are never smaller than that.
+        const float spacing = std::pow(m_box.getVolume() / float(m_n_points), float(1) / dim);
+        const float cell_width = std::max(qargs.r_max, spacing);
+        const float cell_occupancy = float(m_n_points) / m_box.getVolume() * std::pow(qargs.r_max, dim);
+
+        // A LinkCell checks all points in the cells around each query point,
+        // which is only faster than searching a tree if there are few points
+        // in each cell and the points are spread evenly over the cells.
+        const vec3<float> plane_distance = m_box.getNearestPlaneDistance();
+        const bool fits_cells = periodic.x && periodic.y && (is2D || periodic.z)
+            && plane_distance.x >= 2 * cell_width && plane_distance.y >= 2 * cell_width
+            && (is2D || plane_distance.z >= 2 * cell_width);
+        if (fits_cells && cell_occupancy <= RAW_POINTS_MAX_CELL_OCCUPANCY
+            && estimateDispersion() <= RAW_POINTS_MAX_DISPERSION)
+        {
+            std::unique_ptr<LinkCell>& link_cell = m_link_cells[cell_width];
+            if (!link_cell)
+            {
+                link_cell = std::unique_ptr<LinkCell>(new LinkCell(m_box, m_points, m_n_points, cell_width));
+            }
+            return link_cell.get();
+        }
+    }
+
+    if (!m_kdtree)
+    {
+        m_kdtree = std::unique_ptr<KDTree>(new KDTree(m_box, m_points, m_n_points));
+    }
+    return m_kdtree.get();
+}
+
+float RawPoints::estimateDispersion() const
+{
+    if (m_dispersion >= 0)
+    {
+        return m_dispersion;
+    }
+
+    const bool is2D = m_box.is2D();
+    const unsigned int num_cells_target = std::max(m_n_points / RAW_POINTS_DISPERSION_OCCUPANCY, 1u);
+    const unsigned int cells_per_dim = std::max(
+        static_cast<unsigned int>(std::pow(float(num_cells_target), float(1) / (is2D ? 2 : 3))), 1u);
+    const vec3<unsigned int> grid(cells_per_dim, cells_per_dim, is2D ? 1 : cells_per_dim);
+
+    std::vector<unsigned int> counts(grid.x * grid.y * grid.z, 0);
+    for (unsigned int i = 0; i < m_n_points; ++i)
+    {
+        vec3<float> f = m_box.makeFractional(m_points[i]);
+        f -= vec3<float>(std::floor(f.x), std::floor(f.y), std::floor(f.z));
+        const unsigned int x = std::min(static_cast<unsigned int>(f.x * grid.x), grid.x - 1);
+        const unsigned int y = std::min(static_cast<unsigned int>(f.y * grid.y), grid.y - 1);
+        const unsigned int z = std::min(static_cast<unsigned int>(f.z * grid.z), grid.z - 1);
+        ++counts[(z * grid.y + y) * grid.x + x];
+    }
+
+    const float mean = float(m_n_points) / float(counts.size());
+    float variance = 0;
+    for (std::vector<unsigned int>::const_iterator count = counts.begin(); count != counts.end(); ++count)
+    {
+        variance += (float(*count) - mean) * (float(*count) - mean);
+    }
+    variance /= float(counts.size());
+    m_dispersion = mean > 0 ? variance / mean : 0;
+    return m_dispersion;
+}
+
+}; }; // end namespace freud::locality
@@ -4,75 +4,107 @@
 #ifndef RAW_POINTS_H
 #define RAW_POINTS_H
 
-#include <stdexcept>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
 
-#include "AABBQuery.h"
+#include "KDTree.h"
+#include "LinkCell.h"
 #include "NeighborQuery.h"
 
 /*! \file RawPoints.h
-    \brief Defines a simplest NeighborQuery object that actually farms out
-           querying logic to an AABBQuery.
+    \brief Defines a NeighborQuery object that farms out querying logic to an
+           automatically selected NeighborQuery.
 */
 
 namespace freud { namespace locality {
 
-//! Dummy class to just contain minimal information and not actually query.
+//! Ball queries with more points than this in each cell of width r_max use a tree instead of a LinkCell
+const float RAW_POINTS_MAX_CELL_OCCUPANCY = 2.0;
+
+//! Systems whose point counts in a coarse grid have a larger index of dispersion are inhomogeneous
+const float RAW_POINTS_MAX_DISPERSION = 4.0;
+
+//! Average number of points in each cell of the grid used to estimate the homogeneity of a system
+const unsigned int RAW_POINTS_DISPERSION_OCCUPANCY = 8;
+
+//! Class containing points without a spatial data structure of its own.
 /*! The purpose of this class is to support dynamic NeighborQuery object
  *  resolution. Users may pass instances of this class instead of providing a
  *  NeighborQuery to various compute functions throughout freud, which is an
  *  indication that the function needs to compute its own NeighborQuery. That
  *  logic, which is primary encapsulated in the NeighborComputeFunctional.h
  *  file, helps provide a nice Python API as well.
+ *
+ *  When this object is queried, it selects the NeighborQuery that should
+ *  answer the query fastest from the box, the density of the points, and the
+ *  query arguments, and builds it on first use. Ball queries of homogeneous,
+ *  periodic systems with few points within r_max of each point use a
+ *  LinkCell with a cell width matched to r_max. All other queries use a
+ *  KDTree, which adapts to inhomogeneous systems and is at least as fast as
+ *  an AABBQuery otherwise. Each decision is cached per query mode and r_max,
+ *  and the NeighborQuery objects that are built are shared by all decisions.
  */
 class RawPoints : public NeighborQuery
 {
 public:
-    RawPoints() {}
+    RawPoints() : m_dispersion(-1) {}
 
     RawPoints(const box::Box& box, const vec3<float>* points, unsigned int n_points)
-        : NeighborQuery(box, points, n_points)
+        : NeighborQuery(box, points, n_points), m_dispersion(-1)
     {}
 
     ~RawPoints() {}
 
     //! Perform a query based on a set of query parameters.
-    /*! Shadow parent function to ensure that the underlying AABBQuery is
-     * only constructed when this object is actually queried. Note that unlike
-     * the parent function it is not const since it does modify the object.
+    /*! Shadow parent function to ensure that the underlying NeighborQuery is
+     *  only selected and constructed when this object is actually queried.
+     *  The returned iterator queries the selected NeighborQuery directly.
      *
      *  \param query_points The points to find neighbors for.
      *  \param n_query_points The number of query points.
      *  \param qargs The query arguments that should be used to find neighbors.
      */
     virtual std::shared_ptr<NeighborQueryIterator>
-    query(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs query_args) const
-    {
-        if (!aq)
-        {
-            aq = std::unique_ptr<AABBQuery>(new AABBQuery(m_box, m_points, m_n_points));
-        }
-
-        this->validateQueryArgs(query_args);
-        return std::make_shared<NeighborQueryIterator>(this, query_points, n_query_points, query_args);
-    }
-
-    // dummy implementation for pure virtual function in the parent class
+    query(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs query_args) const;
+
+    //! Delegate per-point queries to the selected NeighborQuery.
     virtual std::shared_ptr<NeighborQueryPerPointIterator>
-    querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs qargs) const
-    {
-        if (!aq)
-        {
-            throw std::runtime_error("The underlying AABBQuery object has not yet been initialized. Please "
-                                     "report this error.");
-        }
+    querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs qargs) const;
+
+    //! Delegate bulk queries to the selected NeighborQuery.
+    virtual void queryBulk(const vec3<float>* query_points, unsigned int begin, unsigned int end,
+                           QueryArgs qargs, std::vector<NeighborBond>& bonds) const;
 
-        return aq->querySingle(query_point, query_point_idx, qargs);
-    }
+    //! Get the NeighborQuery that answers queries with the given arguments, building it if necessary.
+    /*! \param qargs The (validated) query arguments.
+     */
+    const NeighborQuery* getBackend(const QueryArgs& qargs) const;
 
 private:
-    mutable std::unique_ptr<AABBQuery> aq; //!< The AABBQuery object that will be used to perform queries.
+    //! Build the NeighborQuery that should answer queries with the given arguments.
+    const NeighborQuery* selectBackend(const QueryArgs& qargs) const;
+
+    //! Estimate how inhomogeneous the points are.
+    /*! The points are counted in a coarse grid in fractional coordinates, and
+     *  the index of dispersion (the variance divided by the mean) of the
+     *  counts is returned. It is close to 1 for uniformly random points and
+     *  much larger for clustered points or points that only fill part of the
+     *  box.
+     */
+    float estimateDispersion() const;
+
+    //! Key identifying the query mode and r_max of a query.
+    typedef std::pair<int, float> BackendKey;
+
+    mutable std::mutex m_backend_mutex;                              //!< Guards the selection of backends.
+    mutable std::map<BackendKey, const NeighborQuery*> m_backends;   //!< Backend per query mode and r_max.
+    mutable std::unique_ptr<KDTree> m_kdtree;                        //!< The KDTree, if it has been built.
+    mutable std::map<float, std::unique_ptr<LinkCell>> m_link_cells; //!< The LinkCells per cell width.
+    mutable float m_dispersion;                                      //!< Dispersion of the points, or -1.
 };
 
 }; }; // end namespace freud::locality
 
-#endif // NEIGHBOR_QUERY_H
+#endif // RAW_POINTS_H
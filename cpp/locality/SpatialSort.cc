@@ -0,0 +1,47 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <cstdint>
+#include <vector>
+
+#include "MortonCode.h"
+#include "RadixSort.h"
+#include "SpatialSort.h"
+#include "utils.h"
+
+/*! \file SpatialSort.cc
+    \brief Orders points along a space-filling curve.
+*/
+
+namespace freud { namespace locality {
+
+SpatialSort::SpatialSort() : m_order(0), m_inverse_order(0) {}
+
+SpatialSort::SpatialSort(const box::Box& box, const vec3<float>* points, unsigned int n_points)
+    : m_order(n_points), m_inverse_order(n_points)
+{
+    // Points are wrapped into the box first, so that periodic images of a
+    // point share its code.
+    std::vector<uint64_t> codes(n_points);
+    std::vector<unsigned int> order(n_points);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            codes[i] = util::mortonCode(box.makeFractional(box.wrap(points[i])));
+            order[i] = static_cast<unsigned int>(i);
+        }
+    });
+    util::radixSortPairs(codes, order, 3 * util::MORTON_BITS_PER_DIM);
+
+    unsigned int* sorted = m_order.get();
+    unsigned int* inverse = m_inverse_order.get();
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+        {
+            sorted[k] = order[k];
+            inverse[order[k]] = static_cast<unsigned int>(k);
+        }
+    });
+}
+
+}; }; // end namespace freud::locality
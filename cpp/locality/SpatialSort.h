@@ -0,0 +1,68 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef SPATIAL_SORT_H
+#define SPATIAL_SORT_H
+
+#include "Box.h"
+#include "ManagedArray.h"
+#include "VectorMath.h"
+
+/*! \file SpatialSort.h
+    \brief Orders points along a space-filling curve.
+*/
+
+namespace freud { namespace locality {
+
+//! Order points along a Morton (Z-order) space-filling curve
+/*! Simulation engines usually store points in an order that is unrelated to
+ *  their positions, so every loop over neighbors gathers coordinates and
+ *  per-point data from scattered memory. A SpatialSort computes the
+ *  permutation that sorts points by the Morton code of their wrapped
+ *  fractional coordinates, so that points that are close in space are
+ *  mostly close in memory once reordered.
+ *
+ *  The order maps positions in the sorted order to indices of the original
+ *  points, i.e. the k-th sorted point is the point order[k], and the inverse
+ *  order gives the sorted position of each original point. The codes are
+ *  computed and sorted in parallel, and the result is deterministic.
+ */
+class SpatialSort
+{
+public:
+    //! Default constructor
+    SpatialSort();
+
+    //! Compute the spatial order of a set of points
+    /*! \param box The box containing the points.
+     *  \param points The points to order.
+     *  \param n_points The number of points.
+     */
+    SpatialSort(const box::Box& box, const vec3<float>* points, unsigned int n_points);
+
+    //! Return the number of points
+    unsigned int getNPoints() const
+    {
+        return m_order.size();
+    }
+
+    //! Return the index of the original point at each position of the sorted order
+    const util::ManagedArray<unsigned int>& getOrder() const
+    {
+        return m_order;
+    }
+
+    //! Return the position in the sorted order of each original point
+    const util::ManagedArray<unsigned int>& getInverseOrder() const
+    {
+        return m_inverse_order;
+    }
+
+private:
+    util::ManagedArray<unsigned int> m_order;         //!< Original index of each sorted point.
+    util::ManagedArray<unsigned int> m_inverse_order; //!< Sorted position of each original point.
+};
+
+}; }; // end namespace freud::locality
+
+#endif // SPATIAL_SORT_H
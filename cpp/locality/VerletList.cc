@@ -0,0 +1,233 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tbb/tbb.h>
+
+#include "VerletList.h"
+#include "utils.h"
+
+/*! \file VerletList.cc
+    \brief Reuses ball query neighbor lists across frames using a skin distance.
+*/
+
+namespace freud { namespace locality {
+
+namespace {
+
+//! Number of candidate bonds processed together when refreshing the neighbor list
+const unsigned int REFRESH_BLOCK_SIZE = 4096;
+
+//! Find the largest (minimum image) displacement of a set of points from their reference positions
+float maxDisplacement(const box::Box& box, const std::vector<vec3<float>>& ref_points,
+                      const vec3<float>* points)
+{
+    const float max_disp_sq = tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, ref_points.size()), float(0),
+        [&](const tbb::blocked_range<size_t>& r, float local_max) {
+            for (size_t i = r.begin(); i < r.end(); ++i)
+            {
+                const vec3<float> delta = box.wrap(points[i] - ref_points[i]);
+                local_max = std::max(local_max, dot(delta, delta));
+            }
+            return local_max;
+        },
+        [](float a, float b) { return std::max(a, b); });
+    return std::sqrt(max_disp_sq);
+}
+
+//! Find the largest cutoff that a ball query accepts in a box
+/*! Queries require twice the cutoff to be smaller than the nearest plane
+ *  distance in every periodic direction.
+ */
+float maxQueryDistance(const box::Box& box)
+{
+    const vec3<float> plane_distance = box.getNearestPlaneDistance();
+    const vec3<bool> periodic = box.getPeriodic();
+    float max_distance = std::numeric_limits<float>::max();
+    if (periodic.x)
+    {
+        max_distance = std::min(max_distance, plane_distance.x / 2);
+    }
+    if (periodic.y)
+    {
+        max_distance = std::min(max_distance, plane_distance.y / 2);
+    }
+    if (!box.is2D() && periodic.z)
+    {
+        max_distance = std::min(max_distance, plane_distance.z / 2);
+    }
+    return std::nextafter(max_distance, float(0));
+}
+
+}; // end anonymous namespace
+
+VerletList::VerletList(float skin)
+    : m_skin(skin), m_effective_skin(skin), m_num_builds(0), m_rebuilt(false), m_self_query(false),
+      m_neighbor_list(std::make_shared<NeighborList>())
+{
+    if (skin < 0)
+    {
+        throw std::invalid_argument("VerletList requires a non-negative skin distance.");
+    }
+}
+
+void VerletList::compute(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                         QueryArgs qargs)
+{
+    // Infer the mode in the same way as NeighborQuery::inferMode.
+    if (qargs.mode == QueryArgs::none && qargs.num_neighbors == QueryArgs::DEFAULT_NUM_NEIGHBORS
+        && qargs.r_max != QueryArgs::DEFAULT_R_MAX)
+    {
+        qargs.mode = QueryArgs::ball;
+    }
+    if (qargs.mode != QueryArgs::ball)
+    {
+        throw std::runtime_error("VerletList only supports ball queries.");
+    }
+
+    m_rebuilt = needsRebuild(nq, query_points, n_query_points, qargs);
+    if (m_rebuilt)
+    {
+        rebuild(nq, query_points, n_query_points, qargs);
+    }
+    refresh(nq, query_points);
+}
+
+bool VerletList::needsRebuild(const NeighborQuery* nq, const vec3<float>* query_points,
+                              unsigned int n_query_points, const QueryArgs& qargs) const
+{
+    if (!m_candidates || nq->getBox() != m_box || nq->getNPoints() != m_ref_points.size()
+        || qargs.r_max != m_qargs.r_max || qargs.r_min != m_qargs.r_min
+        || qargs.exclude_ii != m_qargs.exclude_ii || qargs.symmetric_half != m_qargs.symmetric_half)
+    {
+        return true;
+    }
+
+    const bool self_query = (query_points == nq->getPoints() && n_query_points == nq->getNPoints());
+    if (self_query != m_self_query)
+    {
+        return true;
+    }
+
+    // Any pair of points whose distance has decreased by more than the skin
+    // could have moved from outside r_max + skin to inside r_max.
+    const float max_disp = maxDisplacement(m_box, m_ref_points, nq->getPoints());
+    if (self_query)
+    {
+        return 2 * max_disp > m_effective_skin;
+    }
+    if (n_query_points != m_ref_query_points.size())
+    {
+        return true;
+    }
+    return max_disp + maxDisplacement(m_box, m_ref_query_points, query_points) > m_effective_skin;
+}
+
+void VerletList::rebuild(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                         const QueryArgs& qargs)
+{
+    m_box = nq->getBox();
+    m_qargs = qargs;
+    m_self_query = (query_points == nq->getPoints() && n_query_points == nq->getNPoints());
+    m_ref_points.assign(nq->getPoints(), nq->getPoints() + nq->getNPoints());
+    if (m_self_query)
+    {
+        m_ref_query_points.clear();
+    }
+    else
+    {
+        m_ref_query_points.assign(query_points, query_points + n_query_points);
+    }
+
+    QueryArgs candidate_args(qargs);
+    candidate_args.r_max = qargs.r_max + m_skin;
+    // Reduce the skin if r_max + skin is too large for the box. If r_max
+    // itself is too large, the query reports the error as usual.
+    const float max_r_max = maxQueryDistance(m_box);
+    if (qargs.r_max <= max_r_max)
+    {
+        candidate_args.r_max = std::min(candidate_args.r_max, max_r_max);
+    }
+    m_effective_skin = candidate_args.r_max - qargs.r_max;
+    candidate_args.r_min = std::max(qargs.r_min - m_effective_skin, float(0));
+    m_candidates.reset(nq->query(query_points, n_query_points, candidate_args)->toNeighborList());
+    ++m_num_builds;
+}
+
+void VerletList::refresh(const NeighborQuery* nq, const vec3<float>* query_points)
+{
+    const unsigned int num_candidates = m_candidates->getNumBonds();
+    const unsigned int num_blocks = (num_candidates + REFRESH_BLOCK_SIZE - 1) / REFRESH_BLOCK_SIZE;
+    const unsigned int* candidate_neighbors = m_candidates->getNeighbors().get();
+    const float* candidate_weights = m_candidates->getWeights().get();
+    const vec3<float>* points = nq->getPoints();
+    const float r_max_sq = m_qargs.r_max * m_qargs.r_max;
+    const float r_min_sq = m_qargs.r_min * m_qargs.r_min;
+
+    // Compute the current distances of all candidate bonds and count the
+    // bonds kept in each block.
+    m_candidate_distances.resize(num_candidates);
+    std::vector<unsigned int> block_starts(num_blocks + 1, 0);
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block)
+        {
+            const unsigned int first = block * REFRESH_BLOCK_SIZE;
+            const unsigned int last = std::min(first + REFRESH_BLOCK_SIZE, num_candidates);
+            unsigned int count = 0;
+            for (unsigned int bond = first; bond < last; ++bond)
+            {
+                const unsigned int query_point_idx = candidate_neighbors[2 * bond];
+                const unsigned int point_idx = candidate_neighbors[2 * bond + 1];
+                const vec3<float> r_ij = m_box.wrap(points[point_idx] - query_points[query_point_idx]);
+                const float r_sq = dot(r_ij, r_ij);
+                if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                {
+                    m_candidate_distances[bond] = std::sqrt(r_sq);
+                    ++count;
+                }
+                else
+                {
+                    m_candidate_distances[bond] = -1;
+                }
+            }
+            block_starts[block + 1] = count;
+        }
+    });
+    for (unsigned int block = 0; block < num_blocks; ++block)
+    {
+        block_starts[block + 1] += block_starts[block];
+    }
+
+    // Copy the kept bonds, preserving their order.
+    const unsigned int num_bonds = block_starts[num_blocks];
+    m_neighbor_list->setNumBonds(num_bonds, m_candidates->getNumQueryPoints(),
+                                 m_candidates->getNumPoints());
+    unsigned int* neighbors = m_neighbor_list->getNeighbors().get();
+    float* distances = m_neighbor_list->getDistances().get();
+    float* weights = m_neighbor_list->getWeights().get();
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block)
+        {
+            const unsigned int first = block * REFRESH_BLOCK_SIZE;
+            const unsigned int last = std::min(first + REFRESH_BLOCK_SIZE, num_candidates);
+            unsigned int out = block_starts[block];
+            for (unsigned int bond = first; bond < last; ++bond)
+            {
+                if (m_candidate_distances[bond] >= 0)
+                {
+                    neighbors[2 * out] = candidate_neighbors[2 * bond];
+                    neighbors[2 * out + 1] = candidate_neighbors[2 * bond + 1];
+                    distances[out] = m_candidate_distances[bond];
+                    weights[out] = candidate_weights[bond];
+                    ++out;
+                }
+            }
+        }
+    });
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,118 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef VERLET_LIST_H
+#define VERLET_LIST_H
+
+#include <memory>
+#include <vector>
+
+#include "Box.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file VerletList.h
+    \brief Reuses ball query neighbor lists across frames using a skin distance.
+*/
+
+namespace freud { namespace locality {
+
+//! Neighbor list that is reused across frames of a trajectory
+/*! A VerletList finds the bonds of a ball query with a maximum distance of
+ *  r_max + skin and stores them as candidate bonds along with the positions
+ *  of the points and query points at that time. On subsequent calls to
+ *  compute, the candidate bonds only need to be rebuilt if the sum of the
+ *  largest displacements of any point and any query point since the last
+ *  rebuild exceeds the skin distance (i.e. half of the skin for a set of
+ *  points queried against itself), since no pair of points that was further
+ *  apart than r_max + skin can have moved within r_max of each other.
+ *  Otherwise, the distances of the candidate bonds are recomputed and the
+ *  bonds outside of [r_min, r_max) are filtered out.
+ *
+ *  The candidate bonds are also rebuilt if the box, the number of points, or
+ *  any of the query arguments change.
+ *
+ *  Ball queries reject cutoffs of half the box or more, so near that limit
+ *  the skin used for the candidate bonds is reduced until r_max + skin fits
+ *  in the box. The candidate bonds are then rebuilt more often.
+ */
+class VerletList
+{
+public:
+    //! Constructor
+    /*! \param skin The extra distance added to r_max when finding candidate bonds.
+     */
+    VerletList(float skin);
+
+    //! Find the bonds of a ball query, reusing the candidate bonds if possible
+    /*! \param nq The NeighborQuery used to rebuild the candidate bonds.
+     *  \param query_points The query points.
+     *  \param n_query_points The number of query points.
+     *  \param qargs The query arguments, which must describe a ball query.
+     */
+    void compute(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                 QueryArgs qargs);
+
+    //! Get the skin distance
+    float getSkin() const
+    {
+        return m_skin;
+    }
+
+    //! Get the skin distance used for the current candidate bonds
+    /*! This is smaller than the skin if r_max + skin does not fit in the box.
+     */
+    float getEffectiveSkin() const
+    {
+        return m_effective_skin;
+    }
+
+    //! Get the number of times the candidate bonds have been built
+    unsigned int getNumBuilds() const
+    {
+        return m_num_builds;
+    }
+
+    //! Return whether the last call to compute rebuilt the candidate bonds
+    bool getRebuilt() const
+    {
+        return m_rebuilt;
+    }
+
+    //! Get the neighbor list found by the last call to compute
+    std::shared_ptr<NeighborList> getNeighborList() const
+    {
+        return m_neighbor_list;
+    }
+
+private:
+    //! Determine whether the candidate bonds must be rebuilt
+    bool needsRebuild(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                      const QueryArgs& qargs) const;
+
+    //! Find new candidate bonds and store the reference positions
+    void rebuild(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                 const QueryArgs& qargs);
+
+    //! Recompute the candidate bond distances and filter them into the neighbor list
+    void refresh(const NeighborQuery* nq, const vec3<float>* query_points);
+
+    float m_skin;              //!< Extra distance added to r_max for the candidate bonds
+    float m_effective_skin;    //!< Skin used for the current candidate bonds
+    unsigned int m_num_builds; //!< Number of times the candidate bonds have been built
+    bool m_rebuilt;            //!< Whether the last call to compute rebuilt the candidate bonds
+
+    box::Box m_box;                              //!< Box used to build the candidate bonds
+    QueryArgs m_qargs;                           //!< Query arguments used to build the candidate bonds
+    bool m_self_query;                           //!< Whether the points were queried against themselves
+    std::vector<vec3<float>> m_ref_points;       //!< Positions of the points at the last rebuild
+    std::vector<vec3<float>> m_ref_query_points; //!< Positions of the query points at the last rebuild
+    std::unique_ptr<NeighborList> m_candidates;  //!< Bonds within r_max + skin at the last rebuild
+    std::vector<float> m_candidate_distances;    //!< Refreshed candidate distances (negative if filtered)
+    std::shared_ptr<NeighborList> m_neighbor_list; //!< Bonds within [r_min, r_max)
+};
+
+}; }; // end namespace freud::locality
+
+#endif // VERLET_LIST_H
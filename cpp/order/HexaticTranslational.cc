@@ -19,16 +19,14 @@ void HexaticTranslational<T>::computeGeneral(Func func, const freud::locality::N
 
     m_psi_array.prepare(Np);
 
-    freud::locality::loopOverNeighborsIterator(
+    freud::locality::loopOverNeighborVectorsIterator(
         points, points->getPoints(), Np, qargs, nlist,
-        [=](size_t i, std::shared_ptr<freud::locality::NeighborPerPointIterator> ppiter) {
-            const vec3<float> ref = (*points)[i];
+        [=](size_t i, freud::locality::NeighborVectorIterator& ppiter) {
+            // Vector from query_point to point
+            vec3<float> delta;
 
-            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
+            for (ppiter.next(delta); !ppiter.end(); ppiter.next(delta))
             {
-                // Compute vector from query_point to point
-                const vec3<float> delta = box.wrap((*points)[nb.point_idx] - ref);
-
                 // Compute psi for this vector
                 m_psi_array[i] += func(delta);
             }
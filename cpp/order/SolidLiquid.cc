@@ -22,7 +22,9 @@ SolidLiquid::SolidLiquid(unsigned int l, float q_threshold, unsigned int solid_t
 void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
                           const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
 {
-    // This function requires a NeighborList object, so we always make one and store it locally.
+    // This function requires a NeighborList object, so we always make one and store it locally. It cannot
+    // be streamed with streamNeighborChunks: the Steinhardt compute consumes the full list, and ql_ij is
+    // indexed by its bonds and filtered into the solid-like list returned by getNList.
     m_nlist = locality::makeDefaultNlist(points, nlist, points->getPoints(), points->getNPoints(), qargs);
 
     const unsigned int num_query_points(m_nlist.getNumQueryPoints());
@@ -1,6 +1,8 @@
 // Copyright (c) 2010-2019 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <memory>
+
 #include "Steinhardt.h"
 #include "NeighborComputeFunctional.h"
 #include "utils.h"
@@ -60,6 +62,18 @@ void Steinhardt::compute(const freud::locality::NeighborList* nlist,
     // Allocate and zero out arrays as necessary.
     reallocateArrays(points->getNPoints());
 
+    // For ball queries, find each pair of points only once and mirror the
+    // bonds into the full neighbor list used by all subsequent steps.
+    std::unique_ptr<freud::locality::NeighborList> half_nlist;
+    if (freud::locality::canQuerySymmetricHalf(points, nlist, points->getPoints(), points->getNPoints(),
+                                               qargs))
+    {
+        qargs.symmetric_half = true;
+        half_nlist.reset(points->query(points->getPoints(), points->getNPoints(), qargs)->toNeighborList());
+        half_nlist->mirror();
+        nlist = half_nlist.get();
+    }
+
     // Computes the base qlmi required for each specialized order parameter
     baseCompute(nlist, points, qargs);
 
@@ -92,14 +106,14 @@ void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
     // For consistency, this reset is done here regardless of whether the array
     // is populated in baseCompute or computeAve.
     m_qlm_local.reset();
-    freud::locality::loopOverNeighborsIterator(
+    freud::locality::loopOverNeighborVectorsIterator(
         points, points->getPoints(), m_Np, qargs, nlist,
-        [=](size_t i, std::shared_ptr<freud::locality::NeighborPerPointIterator> ppiter) {
+        [=](size_t i, freud::locality::NeighborVectorIterator& ppiter) {
             float total_weight(0);
-            const vec3<float> ref((*points)[i]);
-            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
+            vec3<float> delta;
+            for (freud::locality::NeighborBond nb = ppiter.next(delta); !ppiter.end();
+                 nb = ppiter.next(delta))
             {
-                const vec3<float> delta = points->getBox().wrap((*points)[nb.point_idx] - ref);
                 const float weight(m_weighted ? nb.weight : 1.0);
 
                 // phi is usually in range 0..2Pi, but
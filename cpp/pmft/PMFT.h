@@ -41,34 +41,27 @@ public:
         \param query_points Points
         \param n_query_points Number of query_points
         \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query
-           appropriately with given qargs.
+           appropriately with given qargs. Bond vectors stored in the list are used directly.
         \param qargs Query arguments
-        \param cf An object with operator(NeighborBond) as input.
+        \param cf An object with operator(NeighborBond, vec3<float>, BondHistogramAccumulator&) as input.
     */
     template<typename Func>
     void accumulateGeneral(const locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                            unsigned int n_query_points, const locality::NeighborList* nlist,
                            freud::locality::QueryArgs qargs, Func cf)
     {
-        m_box = neighbor_query->getBox();
-        locality::loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, nlist, cf);
-        m_frame_counter++;
-        m_n_points = neighbor_query->getNPoints();
-        m_n_query_points = n_query_points;
-        // flag to reduce
-        m_reduce = true;
+        accumulateGeneralVectors(neighbor_query, query_points, n_query_points, nlist, qargs, cf);
     }
 
     template<typename JacobFactor> void reduce(JacobFactor jf)
     {
         m_pcf_array.prepare(m_histogram.shape());
-        m_histogram.prepare(m_histogram.shape());
 
         float inv_num_dens = m_box.getVolume() / (float) m_n_query_points;
         float norm_factor = (float) 1.0 / ((float) m_frame_counter * (float) m_n_points);
         float prefactor = inv_num_dens * norm_factor;
 
-        m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &jf](size_t i) {
+        reduceHistogramPerBin([this, &prefactor, &jf](size_t i) {
             m_pcf_array[i] = m_histogram[i] * prefactor * jf(i);
         });
     }
@@ -32,6 +32,7 @@ PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int
     axes.push_back(std::make_shared<util::RegularAxis>(n_t2, 0, TWO_PI));
     m_histogram = BondHistogram(axes);
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_static_axes = util::StaticAxes<util::RegularAxis, util::RegularAxis, util::RegularAxis>(m_histogram);
 
     // calculate the jacobian array; computed as the inverse for faster use later
     m_inv_jacobian_array.prepare({n_r, n_t1, n_t2});
@@ -69,8 +70,8 @@ void PMFTR12::accumulate(const locality::NeighborQuery* neighbor_query, float* o
 {
     neighbor_query->getBox().enforce2D();
     accumulateGeneral(neighbor_query, query_points, n_p, nlist, qargs,
-                      [=](const freud::locality::NeighborBond& neighbor_bond) {
-                          vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+                      [=](const freud::locality::NeighborBond& neighbor_bond, const vec3<float>& delta,
+                          freud::locality::BondHistogramAccumulator& histogram) {
                           // calculate angles
                           float d_theta1 = atan2(delta.y, delta.x);
                           float d_theta2 = atan2(-delta.y, -delta.x);
@@ -87,8 +88,24 @@ void PMFTR12::accumulate(const locality::NeighborQuery* neighbor_query, float* o
                           {
                               t2 += TWO_PI;
                           }
-                          m_local_histograms(neighbor_bond.distance, t1, t2);
+                          histogram.increment(m_static_axes.bin(neighbor_bond.distance, t1, t2));
                       });
 }
 
+void PMFTR12::accumulateFrames(const std::vector<Frame>& frames,
+                               const std::vector<float*>& orientations,
+                               const std::vector<float*>& query_orientations,
+                               freud::locality::QueryArgs qargs)
+{
+    validateFrameData(frames, orientations, "orientations");
+    validateFrameData(frames, query_orientations, "query orientations");
+    accumulateFramesGeneral(frames, qargs,
+                            [&](size_t frame, const locality::NeighborQuery* neighbor_query,
+                                const locality::NeighborList* nlist) {
+                                accumulate(neighbor_query, orientations[frame], frames[frame].query_points,
+                                           query_orientations[frame], frames[frame].n_query_points, nlist,
+                                           qargs);
+                            });
+}
+
 }; }; // end namespace freud::pmft
@@ -25,11 +25,20 @@ public:
                     vec3<float>* query_points, float* query_orientations, unsigned int n_query_points,
                     const locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
 
+    /*! Compute the PCF over a sequence of frames, with one array of
+        orientations and query orientations per frame (see
+        BondHistogramCompute::accumulateFramesGeneral).
+    */
+    void accumulateFrames(const std::vector<Frame>& frames, const std::vector<float*>& orientations,
+                          const std::vector<float*>& query_orientations, freud::locality::QueryArgs qargs);
+
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
     virtual void reduce();
 
 private:
+    util::StaticAxes<util::RegularAxis, util::RegularAxis, util::RegularAxis>
+        m_static_axes; //!< The axes of the histogram, for inlined binning
     util::ManagedArray<float> m_inv_jacobian_array; //!< Array of inverse jacobians for each bin
 };
 
@@ -39,6 +39,7 @@ PMFTXY::PMFTXY(float x_max, float y_max, unsigned int n_x, unsigned int n_y) : P
     axes.push_back(std::make_shared<util::RegularAxis>(n_y, -y_max, y_max));
     m_histogram = BondHistogram(axes);
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_static_axes = util::StaticAxes<util::RegularAxis, util::RegularAxis>(m_histogram);
 }
 
 //! \internal
@@ -58,8 +59,8 @@ void PMFTXY::accumulate(const locality::NeighborQuery* neighbor_query, float* qu
 {
     neighbor_query->getBox().enforce2D();
     accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [=](const freud::locality::NeighborBond& neighbor_bond) {
-                          vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+                      [=](const freud::locality::NeighborBond& neighbor_bond, const vec3<float>& delta,
+                          freud::locality::BondHistogramAccumulator& histogram) {
 
                           // rotate interparticle vector
                           vec2<float> myVec(delta.x, delta.y);
@@ -67,8 +68,21 @@ void PMFTXY::accumulate(const locality::NeighborQuery* neighbor_query, float* qu
                               = rotmat2<float>::fromAngle(-query_orientations[neighbor_bond.query_point_idx]);
                           vec2<float> rotVec = myMat * myVec;
 
-                          m_local_histograms(rotVec.x, rotVec.y);
+                          histogram.increment(m_static_axes.bin(rotVec.x, rotVec.y));
                       });
 }
 
+void PMFTXY::accumulateFrames(const std::vector<Frame>& frames, const std::vector<float*>& query_orientations,
+                              freud::locality::QueryArgs qargs)
+{
+    validateFrameData(frames, query_orientations, "query orientations");
+    accumulateFramesGeneral(frames, qargs,
+                            [&](size_t frame, const locality::NeighborQuery* neighbor_query,
+                                const locality::NeighborList* nlist) {
+                                accumulate(neighbor_query, query_orientations[frame],
+                                           frames[frame].query_points, frames[frame].n_query_points, nlist,
+                                           qargs);
+                            });
+}
+
 }; }; // end namespace freud::pmft
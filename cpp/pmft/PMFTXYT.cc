@@ -42,6 +42,7 @@ PMFTXYT::PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, u
     axes.push_back(std::make_shared<util::RegularAxis>(n_t, 0, TWO_PI));
     m_histogram = BondHistogram(axes);
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_static_axes = util::StaticAxes<util::RegularAxis, util::RegularAxis, util::RegularAxis>(m_histogram);
 }
 
 //! \internal
@@ -58,8 +59,8 @@ void PMFTXYT::accumulate(const locality::NeighborQuery* neighbor_query, float* o
 {
     neighbor_query->getBox().enforce2D();
     accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [=](const freud::locality::NeighborBond& neighbor_bond) {
-                          vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+                      [=](const freud::locality::NeighborBond& neighbor_bond, const vec3<float>& delta,
+                          freud::locality::BondHistogramAccumulator& histogram) {
 
                           // rotate interparticle vector
                           vec2<float> myVec(delta.x, delta.y);
@@ -76,7 +77,24 @@ void PMFTXYT::accumulate(const locality::NeighborQuery* neighbor_query, float* o
                               t += TWO_PI;
                           }
 
-                          m_local_histograms(rotVec.x, rotVec.y, t);
+                          histogram.increment(m_static_axes.bin(rotVec.x, rotVec.y, t));
                       });
 }
+
+void PMFTXYT::accumulateFrames(const std::vector<Frame>& frames,
+                               const std::vector<float*>& orientations,
+                               const std::vector<float*>& query_orientations,
+                               freud::locality::QueryArgs qargs)
+{
+    validateFrameData(frames, orientations, "orientations");
+    validateFrameData(frames, query_orientations, "query orientations");
+    accumulateFramesGeneral(frames, qargs,
+                            [&](size_t frame, const locality::NeighborQuery* neighbor_query,
+                                const locality::NeighborList* nlist) {
+                                accumulate(neighbor_query, orientations[frame], frames[frame].query_points,
+                                           query_orientations[frame], frames[frame].n_query_points, nlist,
+                                           qargs);
+                            });
+}
+
 }; }; // end namespace freud::pmft
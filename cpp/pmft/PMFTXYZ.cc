@@ -55,6 +55,7 @@ PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsign
     axes.push_back(std::make_shared<util::RegularAxis>(n_z, -z_max, z_max));
     m_histogram = BondHistogram(axes);
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_static_axes = util::StaticAxes<util::RegularAxis, util::RegularAxis, util::RegularAxis>(m_histogram);
 }
 
 //! \internal
@@ -76,11 +77,10 @@ void PMFTXYZ::accumulate(const locality::NeighborQuery* neighbor_query, quat<flo
     // precalc some values for faster computation within the loop
     neighbor_query->getBox().enforce3D();
     accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [=](const freud::locality::NeighborBond& neighbor_bond) {
+                      [=](const freud::locality::NeighborBond& neighbor_bond, const vec3<float>& delta,
+                          freud::locality::BondHistogramAccumulator& histogram) {
                           // create the reference point quaternion
                           quat<float> ref_q(query_orientations[neighbor_bond.query_point_idx]);
-                          // make sure that the particles are wrapped into the box
-                          vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
 
                           for (unsigned int k = 0; k < num_equiv_orientations; k++)
                           {
@@ -90,9 +90,24 @@ void PMFTXYZ::accumulate(const locality::NeighborQuery* neighbor_query, quat<flo
                               v = rotate(conj(ref_q), v);
                               v = rotate(equiv_orientations[k], v);
 
-                              m_local_histograms(v.x, v.y, v.z);
+                              histogram.increment(m_static_axes.bin(v.x, v.y, v.z));
                           }
                       });
 }
 
+void PMFTXYZ::accumulateFrames(const std::vector<Frame>& frames,
+                               const std::vector<quat<float>*>& query_orientations,
+                               quat<float>* equiv_orientations, unsigned int num_equiv_orientations,
+                               freud::locality::QueryArgs qargs)
+{
+    validateFrameData(frames, query_orientations, "query orientations");
+    accumulateFramesGeneral(frames, qargs,
+                            [&](size_t frame, const locality::NeighborQuery* neighbor_query,
+                                const locality::NeighborList* nlist) {
+                                accumulate(neighbor_query, query_orientations[frame],
+                                           frames[frame].query_points, frames[frame].n_query_points,
+                                           equiv_orientations, num_equiv_orientations, nlist, qargs);
+                            });
+}
+
 }; }; // end namespace freud::pmft
@@ -27,11 +27,21 @@ public:
                     unsigned int num_equiv_orientations, const locality::NeighborList* nlist,
                     freud::locality::QueryArgs qargs);
 
+    /*! Compute the PCF over a sequence of frames, with one array of query
+        orientations per frame (see BondHistogramCompute::accumulateFramesGeneral).
+    */
+    void accumulateFrames(const std::vector<Frame>& frames,
+                          const std::vector<quat<float>*>& query_orientations,
+                          quat<float>* equiv_orientations, unsigned int num_equiv_orientations,
+                          freud::locality::QueryArgs qargs);
+
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
     virtual void reduce();
 
 private:
+    util::StaticAxes<util::RegularAxis, util::RegularAxis, util::RegularAxis>
+        m_static_axes; //!< The axes of the histogram, for inlined binning
     float m_jacobian;
     vec3<float> m_shiftvec; //!< vector that points from [0,0,0] to the origin of the pmft
 };
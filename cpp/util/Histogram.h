@@ -6,8 +6,12 @@
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 #include <sstream>
 #include <tbb/tbb.h>
+#include <tuple>
 #include <utility>
 
 #include "ManagedArray.h"
@@ -110,10 +114,16 @@ protected:
  * relatively small set of parameter and are very efficient to bin with
  * defining them. Given a value along the Axis, the Axis can compute the bin
  * within which this value falls.
+ *
+ * The class is final so that calls to bin through a RegularAxis (rather than
+ * an Axis) are not virtual and can be inlined, see StaticAxes.
  */
-class RegularAxis : public Axis
+class RegularAxis final : public Axis
 {
 public:
+    //! Default constructor (an empty axis, only useful as a placeholder).
+    RegularAxis() : Axis(), m_dr(0), m_dr_inv(0) {}
+
     RegularAxis(size_t nbins, float min, float max) : Axis(nbins, min, max)
     {
         m_bin_edges.resize(m_nbins + 1);
@@ -144,8 +154,9 @@ public:
     {
         // Since we're using an unsigned int cast for truncation, we must
         // ensure that we will be working with a positive number or we will
-        // fail to detect underflow.
-        if (value < m_min || value >= m_max)
+        // fail to detect underflow. NaN values fail both comparisons and
+        // are out of range as well.
+        if (!(value >= m_min && value < m_max))
         {
             return OVERFLOW_BIN;
         }
@@ -163,6 +174,43 @@ public:
             return bin;
     }
 
+    //! Find the bins of a batch of values along this axis.
+    /*! This gives the same bins as bin, computing eight of them at once with
+     * AVX2 instructions when they are enabled at compile time (the --SIMD
+     * avx2, avx512 or native options of setup.py). By default, the scalar
+     * loop is used.
+     *
+     * \param values The values to bin.
+     * \param num_values The number of values.
+     * \param bins Output array of num_values bins (OVERFLOW_BIN for values out of range).
+     */
+    void binBatch(const float* values, size_t num_values, unsigned int* bins) const
+    {
+        size_t i = 0;
+#ifdef __AVX2__
+        const __m256 min = _mm256_set1_ps(m_min);
+        const __m256 max = _mm256_set1_ps(m_max);
+        const __m256 dr_inv = _mm256_set1_ps(m_dr_inv);
+        const __m256i last_bin = _mm256_set1_epi32(static_cast<int>(m_nbins - 1));
+        for (; i + 8 <= num_values; i += 8)
+        {
+            const __m256 value = _mm256_loadu_ps(values + i);
+            // The unordered comparison also marks NaN values out of range, as in bin.
+            const __m256 out_of_range = _mm256_or_ps(_mm256_cmp_ps(value, min, _CMP_NGE_UQ),
+                                                     _mm256_cmp_ps(value, max, _CMP_GE_OQ));
+            const __m256i bin = _mm256_min_epu32(
+                _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(value, min), dr_inv)), last_bin);
+            // The out of range mask has all bits set, which is OVERFLOW_BIN.
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(bins + i),
+                                _mm256_or_si256(bin, _mm256_castps_si256(out_of_range)));
+        }
+#endif
+        for (; i < num_values; ++i)
+        {
+            bins[i] = static_cast<unsigned int>(bin(values[i]));
+        }
+    }
+
 protected:
     float m_dr;     //!< Gap between bins
     float m_dr_inv; //!< Inverse gap between bins
@@ -191,6 +239,10 @@ public:
      * local copies all share the same axes (because the axes are stored as
      * arrays of shared_ptrs in the Histogram class). This should cause no
      * problems, but can be refactored if needed.
+     *
+     * Every copy retrieved through local() is marked as modified, so that
+     * foldOverThreadsPerBin only visits the copies of threads that counted
+     * something since the last fold.
      */
     class ThreadLocalHistogram
     {
@@ -227,7 +279,9 @@ public:
 
         reference local()
         {
-            return m_local_histograms.local();
+            reference local_histogram = m_local_histograms.local();
+            local_histogram.m_modified = true;
+            return local_histogram;
         }
 
         void reset()
@@ -241,13 +295,13 @@ public:
         //! Dispatch to thread local histogram.
         template<typename... FloatsOrWeight> void operator()(FloatsOrWeight... values)
         {
-            m_local_histograms.local()(values...);
+            local()(values...);
         }
 
         //! Dispatch to thread local histogram.
         void increment(size_t value_bin, T weight = 1)
         {
-            m_local_histograms.local().increment(value_bin, weight);
+            local().increment(value_bin, weight);
         }
 
     protected:
@@ -259,10 +313,10 @@ public:
     typedef Axes::const_iterator AxisIterator;
 
     //! Default constructor
-    Histogram() {}
+    Histogram() : m_modified(false) {}
 
     //! Constructor
-    Histogram(std::vector<std::shared_ptr<Axis>> axes) : m_axes(axes)
+    Histogram(std::vector<std::shared_ptr<Axis>> axes) : m_axes(axes), m_modified(false)
     {
         std::vector<size_t> sizes;
         for (AxisIterator it = m_axes.begin(); it != m_axes.end(); it++)
@@ -313,6 +367,38 @@ public:
         }
     }
 
+    //! Number of interleaved sub-histograms used by incrementBatch.
+    static const unsigned int NUM_SUB_HISTOGRAMS = 4;
+
+    //! Increment the linear bins of a batch of values, all with the same weight.
+    /*! When many consecutive values fall into the same bin, as they do near
+     * the first peak of an RDF, incrementing a single counter makes each
+     * increment wait for the previous one. Consecutive values are therefore
+     * counted in NUM_SUB_HISTOGRAMS interleaved sub-histograms (the counts of
+     * a bin in each sub-histogram are adjacent in memory), which are folded
+     * into the bin counts by reduceOverThreads and reduceOverThreadsPerBin.
+     * This is meant for thread-local histograms (see ThreadLocalHistogram).
+     *
+     * \param bins The linear bins of the values (entries equal to Axis::OVERFLOW_BIN are skipped).
+     * \param num_values The number of values.
+     * \param weight The weight of each value.
+     */
+    void incrementBatch(const unsigned int* bins, size_t num_values, T weight = 1)
+    {
+        if (m_sub_bin_counts.size() == 0)
+        {
+            m_sub_bin_counts.prepare(m_bin_counts.size() * NUM_SUB_HISTOGRAMS);
+        }
+        T* sub_bin_counts = m_sub_bin_counts.get();
+        for (size_t i = 0; i < num_values; ++i)
+        {
+            if (bins[i] != Axis::OVERFLOW_BIN)
+            {
+                sub_bin_counts[size_t(bins[i]) * NUM_SUB_HISTOGRAMS + (i % NUM_SUB_HISTOGRAMS)] += weight;
+            }
+        }
+    }
+
     //! Find the bin of a value.
     /*! Bins are first computed along each axis of the histogram. These bins
      *  are then combined into a single linear index using the underlying
@@ -343,6 +429,12 @@ public:
         return m_bin_counts.getIndex(ax_bins);
     }
 
+    //! Get the axes of the histogram.
+    const Axes& getAxes() const
+    {
+        return m_axes;
+    }
+
     //! Get the computed histogram.
     const ManagedArray<T>& getBinCounts() const
     {
@@ -359,6 +451,8 @@ public:
     void reset()
     {
         m_bin_counts.reset();
+        m_sub_bin_counts.reset();
+        m_modified = false;
     }
 
     //! Return the edges of bins.
@@ -427,6 +521,15 @@ public:
                      local_bins != local_histograms.end(); ++local_bins)
                 {
                     m_bin_counts[i] += (*local_bins).m_bin_counts[i];
+                    if ((*local_bins).m_sub_bin_counts.size() != 0)
+                    {
+                        const T* sub_bin_counts
+                            = (*local_bins).m_sub_bin_counts.get() + i * NUM_SUB_HISTOGRAMS;
+                        for (unsigned int k = 0; k < NUM_SUB_HISTOGRAMS; ++k)
+                        {
+                            m_bin_counts[i] += sub_bin_counts[k];
+                        }
+                    }
                 }
 
                 cf(i);
@@ -449,6 +552,79 @@ public:
         reduceOverThreadsPerBin(local_histograms, [](size_t i) {});
     }
 
+    //!< Move the counts of a set of thread-local histograms into this one and apply a function.
+    /*! Unlike reduceOverThreadsPerBin, which sums every thread-local histogram
+     * from scratch and is therefore meant to be called on a freshly prepared
+     * histogram, this function adds the counts accumulated since the previous
+     * fold to the counts already in this histogram and zeroes them in the
+     * thread-local histograms. Only the thread-local histograms that were
+     * modified since the previous fold (see ThreadLocalHistogram::local) are
+     * visited, and the bins are processed in parallel, so that the cost of
+     * keeping this histogram up to date after each of many accumulations does
+     * not grow with the total number of threads.
+     *
+     * If the bin counts of this histogram are shared with other arrays (for
+     * example because they were returned to Python), they are copied first so
+     * that those arrays are not modified.
+     *
+     * \param local_histograms The set of local histograms to fold into this one.
+     * \param cf The function to apply to each bin, must have signature (size_t i) {...}
+     */
+    template<typename ComputeFunction>
+    void foldOverThreadsPerBin(ThreadLocalHistogram& local_histograms, const ComputeFunction& cf)
+    {
+        std::vector<Histogram*> modified_histograms;
+        for (typename ThreadLocalHistogram::iterator local_bins = local_histograms.begin();
+             local_bins != local_histograms.end(); ++local_bins)
+        {
+            if ((*local_bins).m_modified)
+            {
+                modified_histograms.push_back(&(*local_bins));
+                (*local_bins).m_modified = false;
+            }
+        }
+
+        m_bin_counts.detach();
+        T* bin_counts = m_bin_counts.get();
+        util::forLoopWrapper(0, m_bin_counts.size(), [&](size_t begin, size_t end) {
+            for (typename std::vector<Histogram*>::const_iterator local_bins = modified_histograms.begin();
+                 local_bins != modified_histograms.end(); ++local_bins)
+            {
+                T* local_bin_counts = (*local_bins)->m_bin_counts.get();
+                for (size_t i = begin; i < end; ++i)
+                {
+                    bin_counts[i] += local_bin_counts[i];
+                    local_bin_counts[i] = T(0);
+                }
+                if ((*local_bins)->m_sub_bin_counts.size() != 0)
+                {
+                    T* sub_bin_counts = (*local_bins)->m_sub_bin_counts.get();
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        for (unsigned int k = 0; k < NUM_SUB_HISTOGRAMS; ++k)
+                        {
+                            bin_counts[i] += sub_bin_counts[i * NUM_SUB_HISTOGRAMS + k];
+                            sub_bin_counts[i * NUM_SUB_HISTOGRAMS + k] = T(0);
+                        }
+                    }
+                }
+            }
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                cf(i);
+            }
+        });
+    }
+
+    //!< Move the counts of a set of thread-local histograms into this one.
+    /*! \param local_histograms The set of local histograms to fold into this one.
+     */
+    void foldOverThreads(ThreadLocalHistogram& local_histograms)
+    {
+        foldOverThreadsPerBin(local_histograms, [](size_t i) {});
+    }
+
     //! Writeable index into array.
     T& operator[](size_t i)
     {
@@ -469,6 +645,8 @@ public:
 protected:
     std::vector<std::shared_ptr<Axis>> m_axes; //!< The axes.
     ManagedArray<T> m_bin_counts;              //!< Counts for each bin
+    ManagedArray<T> m_sub_bin_counts;          //!< Interleaved sub-histograms of incrementBatch, if used
+    bool m_modified;                           //!< Whether the histogram was modified since the last fold
 
     //! The base case for type float when constructing a vector of values provided to operator().
     /*! This function and the accompanying recursive function below employ
@@ -509,6 +687,107 @@ protected:
     }
 };
 
+namespace detail {
+//! Combine the bins of the values along axes I to N - 1 into a linear index (see StaticAxes::bin).
+template<size_t I, size_t N> struct StaticAxesBin
+{
+    template<typename AxesTuple> static size_t bin(const AxesTuple& axes, const float* values, size_t index)
+    {
+        const size_t axis_bin = std::get<I>(axes).bin(values[I]);
+        if (axis_bin == Axis::OVERFLOW_BIN)
+        {
+            return Axis::OVERFLOW_BIN;
+        }
+        return StaticAxesBin<I + 1, N>::bin(axes, values, index * std::get<I>(axes).size() + axis_bin);
+    }
+};
+
+template<size_t N> struct StaticAxesBin<N, N>
+{
+    template<typename AxesTuple> static size_t bin(const AxesTuple&, const float*, size_t index)
+    {
+        return index;
+    }
+};
+
+//! Copy the axes I to N - 1 of a Histogram into a tuple of axes of known types.
+template<size_t I, size_t N> struct StaticAxesCopy
+{
+    template<typename AxesTuple>
+    static void copy(AxesTuple& axes, const std::vector<std::shared_ptr<Axis>>& source)
+    {
+        typedef typename std::tuple_element<I, AxesTuple>::type AxisType;
+        const AxisType* axis = dynamic_cast<const AxisType*>(source[I].get());
+        if (axis == NULL)
+        {
+            std::ostringstream msg;
+            msg << "Axis " << I << " of the Histogram does not have the requested type." << std::endl;
+            throw std::invalid_argument(msg.str());
+        }
+        std::get<I>(axes) = *axis;
+        StaticAxesCopy<I + 1, N>::copy(axes, source);
+    }
+};
+
+template<size_t N> struct StaticAxesCopy<N, N>
+{
+    template<typename AxesTuple> static void copy(AxesTuple&, const std::vector<std::shared_ptr<Axis>>&) {}
+};
+} // namespace detail
+
+//! The axes of a histogram with types known at compile time.
+/*! Histogram::bin handles any number of axes of any type, which costs a
+ * virtual call per axis and temporary vectors for every value binned. A
+ * StaticAxes holds copies of the axes of a Histogram as concrete types, so
+ * that binning a set of values compiles down to the inlined arithmetic of
+ * each axis. The linear bin is the same as the one computed by
+ * Histogram::bin, so it can be passed to Histogram::increment:
+ *
+ * \code
+ * StaticAxes<RegularAxis, RegularAxis> axes(histogram);
+ * histogram.increment(axes.bin(x, y));
+ * \endcode
+ */
+template<typename... AxisTypes> class StaticAxes
+{
+public:
+    //! Default constructor
+    StaticAxes() {}
+
+    //! Copy the axes of a histogram, which must have the types AxisTypes.
+    template<typename T> explicit StaticAxes(const Histogram<T>& histogram)
+    {
+        if (histogram.getAxes().size() != sizeof...(AxisTypes))
+        {
+            std::ostringstream msg;
+            msg << "The Histogram is " << histogram.getAxes().size() << "-dimensional, but "
+                << sizeof...(AxisTypes) << " axis types were provided" << std::endl;
+            throw std::invalid_argument(msg.str());
+        }
+        detail::StaticAxesCopy<0, sizeof...(AxisTypes)>::copy(m_axes, histogram.getAxes());
+    }
+
+    //! Find the bins of a batch of values (only for one-dimensional axes, see RegularAxis::binBatch).
+    void binBatch(const float* values, size_t num_values, unsigned int* bins) const
+    {
+        static_assert(sizeof...(AxisTypes) == 1, "Batches can only be binned along a single axis.");
+        std::get<0>(m_axes).binBatch(values, num_values, bins);
+    }
+
+    //! Find the linear bin of a set of values, one along each axis.
+    /*! \return The linear bin, or Axis::OVERFLOW_BIN if any value is out of range.
+     */
+    template<typename... Floats> size_t bin(Floats... values) const
+    {
+        static_assert(sizeof...(Floats) == sizeof...(AxisTypes), "One value must be provided per axis.");
+        const float value_array[] = {static_cast<float>(values)...};
+        return detail::StaticAxesBin<0, sizeof...(AxisTypes)>::bin(m_axes, value_array, 0);
+    }
+
+private:
+    std::tuple<AxisTypes...> m_axes; //!< Copies of the axes.
+};
+
 }; }; // namespace freud::util
 
 #endif
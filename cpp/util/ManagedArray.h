@@ -1,6 +1,7 @@
 #ifndef MANAGED_ARRAY_H
 #define MANAGED_ARRAY_H
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <sstream>
@@ -327,6 +328,22 @@ public:
         return newarray;
     }
 
+    //! Stop sharing the data with other ManagedArrays, keeping its contents.
+    /*! This is the counterpart of prepare for arrays that are updated in place
+     * rather than rewritten: if there are other ManagedArrays pointing to the
+     * data, the data is copied to a new array, so that subsequent writes to
+     * this array do not modify the arrays previously handed out.
+     */
+    void detach()
+    {
+        if (m_data.use_count() > 1)
+        {
+            ManagedArray newarray(shape());
+            std::copy(get(), get() + size(), newarray.get());
+            *this = newarray;
+        }
+    }
+
 private:
     //! The base case for building up the index.
     /*! These argument building functions are templated on two types, one that
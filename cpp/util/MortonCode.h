@@ -0,0 +1,47 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef MORTON_CODE_H
+#define MORTON_CODE_H
+
+#include <cstdint>
+
+#include "VectorMath.h"
+#include "utils.h"
+
+/*! \file MortonCode.h
+    \brief Morton (Z-order) codes for sorting points along a space-filling curve.
+*/
+
+namespace freud { namespace util {
+
+//! Number of bits used for each dimension of a Morton code
+const unsigned int MORTON_BITS_PER_DIM = 21;
+
+//! Spread the lowest 21 bits of v so that there are two zero bits between each of them.
+inline uint64_t expandBitsMorton(uint64_t v)
+{
+    v &= 0x1fffff;
+    v = (v | (v << 32)) & 0x1f00000000ffffULL;
+    v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+    v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+    v = (v | (v << 2)) & 0x1249249249249249ULL;
+    return v;
+}
+
+//! Compute the 63-bit Morton code of a point given by fractional coordinates.
+/*! \param frac Fractional coordinates of the point, which are clamped to [0, 1].
+ */
+inline uint64_t mortonCode(const vec3<float>& frac)
+{
+    const float scale = float((1u << MORTON_BITS_PER_DIM) - 1);
+    const uint64_t x = static_cast<uint64_t>(clamp(frac.x, 0, 1) * scale);
+    const uint64_t y = static_cast<uint64_t>(clamp(frac.y, 0, 1) * scale);
+    const uint64_t z = static_cast<uint64_t>(clamp(frac.z, 0, 1) * scale);
+    return (expandBitsMorton(x) << 2) | (expandBitsMorton(y) << 1) | expandBitsMorton(z);
+}
+
+}; }; // end namespace freud::util
+
+#endif // MORTON_CODE_H
@@ -0,0 +1,96 @@
+// Copyright (c) 2010-2019 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <algorithm>
+#include <vector>
+
+#include "utils.h"
+
+/*! \file RadixSort.h
+    \brief Parallel least significant digit radix sort of key-value pairs.
+*/
+
+namespace freud { namespace util {
+
+const unsigned int RADIX_SORT_DIGIT_BITS = 8;                            //!< Bits sorted per pass
+const unsigned int RADIX_SORT_BUCKETS = 1u << RADIX_SORT_DIGIT_BITS;     //!< Buckets per pass
+const size_t RADIX_SORT_BLOCK_SIZE = 65536;                              //!< Keys counted per task
+
+//! Stably sort unsigned integer keys and their associated values by the lowest num_bits bits of the keys.
+/*! Each pass sorts by one digit: the keys are split into fixed-size blocks,
+ *  the digits in each block are counted in parallel, the counts are scanned
+ *  to find where each block writes each digit, and each block then scatters
+ *  its keys in parallel. Since the blocks are fixed, the result is
+ *  deterministic.
+ *
+ *  \param keys The keys to sort.
+ *  \param values The values to reorder along with the keys.
+ *  \param num_bits The number of (low) bits of the keys to sort by.
+ */
+template<typename Key, typename Value>
+void radixSortPairs(std::vector<Key>& keys, std::vector<Value>& values, unsigned int num_bits)
+{
+    const size_t n = keys.size();
+    if (n <= 1)
+    {
+        return;
+    }
+    const size_t num_blocks = (n + RADIX_SORT_BLOCK_SIZE - 1) / RADIX_SORT_BLOCK_SIZE;
+    std::vector<Key> keys_out(n);
+    std::vector<Value> values_out(n);
+    std::vector<size_t> offsets(num_blocks * RADIX_SORT_BUCKETS);
+
+    for (unsigned int shift = 0; shift < num_bits; shift += RADIX_SORT_DIGIT_BITS)
+    {
+        // Count the digits in each block.
+        std::fill(offsets.begin(), offsets.end(), 0);
+        forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
+            {
+                size_t* block_counts = &offsets[block * RADIX_SORT_BUCKETS];
+                const size_t last = std::min(n, (block + 1) * RADIX_SORT_BLOCK_SIZE);
+                for (size_t i = block * RADIX_SORT_BLOCK_SIZE; i < last; ++i)
+                {
+                    ++block_counts[(keys[i] >> shift) & (RADIX_SORT_BUCKETS - 1)];
+                }
+            }
+        });
+
+        // Exclusive scan in digit-major order gives the first output index of
+        // each digit in each block.
+        size_t total = 0;
+        for (unsigned int digit = 0; digit < RADIX_SORT_BUCKETS; ++digit)
+        {
+            for (size_t block = 0; block < num_blocks; ++block)
+            {
+                const size_t count = offsets[block * RADIX_SORT_BUCKETS + digit];
+                offsets[block * RADIX_SORT_BUCKETS + digit] = total;
+                total += count;
+            }
+        }
+
+        // Scatter the keys of each block.
+        forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
+            {
+                size_t* block_offsets = &offsets[block * RADIX_SORT_BUCKETS];
+                const size_t last = std::min(n, (block + 1) * RADIX_SORT_BLOCK_SIZE);
+                for (size_t i = block * RADIX_SORT_BLOCK_SIZE; i < last; ++i)
+                {
+                    const size_t dest = block_offsets[(keys[i] >> shift) & (RADIX_SORT_BUCKETS - 1)]++;
+                    keys_out[dest] = keys[i];
+                    values_out[dest] = values[i];
+                }
+            }
+        });
+        keys.swap(keys_out);
+        values.swap(values_out);
+    }
+}
+
+}; }; // end namespace freud::util
+
+#endif // RADIX_SORT_H
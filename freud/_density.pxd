@@ -22,6 +22,10 @@ cdef extern from "CorrelationFunction.h" namespace "freud::density":
                         const T*,
                         unsigned int, const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateFrames(const vector[freud._locality.Frame] &,
+                              const vector[T*] &,
+                              const vector[T*] &,
+                              freud._locality.QueryArgs) except +
         const freud.util.ManagedArray[T] &getCorrelation()
 
 cdef extern from "GaussianDensity.h" namespace "freud::density":
@@ -44,6 +48,10 @@ cdef extern from "LocalDensity.h" namespace "freud::density":
             const vec3[float]*,
             unsigned int, const freud._locality.NeighborList *,
             freud._locality.QueryArgs) except +
+        void compute(
+            const freud._locality.NeighborQuery*,
+            unsigned int,
+            const freud._locality.CompressedNeighborList *) except +
         const freud.util.ManagedArray[float] &getDensity() const
         const freud.util.ManagedArray[float] &getNumNeighbors() const
         float getRMax() const
@@ -58,5 +66,10 @@ cdef extern from "RDF.h" namespace "freud::density":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulate(const freud._locality.NeighborQuery*,
+                        unsigned int,
+                        const freud._locality.CompressedNeighborList*) except +
+        void accumulateFrames(const vector[freud._locality.Frame] &,
+                              freud._locality.QueryArgs) except +
         const freud.util.ManagedArray[float] &getRDF()
         const freud.util.ManagedArray[float] &getNr()
@@ -30,6 +30,11 @@ cdef extern from "BondOrder.h" namespace "freud::environment":
             unsigned int,
             const freud._locality.NeighborList*,
             freud._locality.QueryArgs) except +
+        void accumulateFrames(
+            const vector[freud._locality.Frame] &,
+            const vector[quat[float]*] &,
+            const vector[quat[float]*] &,
+            freud._locality.QueryArgs) except +
         const freud.util.ManagedArray[float] &getBondOrder()
         BondOrderMode getMode() const
 
@@ -34,6 +34,7 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         float r_guess
         float scale
         bool exclude_ii
+        bool symmetric_half
 
     cdef cppclass NeighborQuery:
         NeighborQuery() except +
@@ -55,7 +56,7 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         NeighborQueryIterator(NeighborQuery*, vec3[float]*, unsigned int)
         bool end()
         NeighborBond next()
-        NeighborList *toNeighborList()
+        NeighborList *toNeighborList(bool)
 
 cdef extern from "RawPoints.h" namespace "freud::locality":
 
@@ -76,12 +77,14 @@ cdef extern from "NeighborList.h" namespace "freud::locality":
         freud.util.ManagedArray[unsigned int] &getNeighbors()
         freud.util.ManagedArray[float] &getDistances()
         freud.util.ManagedArray[float] &getWeights()
+        freud.util.ManagedArray[vec3[float]] &getVectors()
         freud.util.ManagedArray[float] &getSegments()
         freud.util.ManagedArray[float] &getCounts()
 
         unsigned int getNumBonds() const
         unsigned int getNumPoints() const
         unsigned int getNumQueryPoints() const
+        bool hasVectors() const
         void setNumBonds(unsigned int, unsigned int, unsigned int)
         unsigned int filter(const bool*) except +
         unsigned int filter_r(float, float) except +
@@ -90,30 +93,99 @@ cdef extern from "NeighborList.h" namespace "freud::locality":
 
         void resize(unsigned int)
         void copy(const NeighborList &)
+        void mirror() except +
         void validate(unsigned int, unsigned int) except +
 
+cdef extern from "CompressedNeighborList.h" namespace "freud::locality":
+    cdef cppclass CompressedNeighborList:
+        CompressedNeighborList()
+        CompressedNeighborList(const NeighborList &, bool) except +
+        CompressedNeighborList(const NeighborQuery*, const vec3[float]*,
+                               unsigned int, QueryArgs, bool) except +
+        unsigned int getNumBonds() const
+        unsigned int getNumQueryPoints() const
+        unsigned int getNumPoints() const
+        bool getDeltaEncoded() const
+        bool hasWeights() const
+        unsigned int getSegment(unsigned int) const
+        unsigned int getCount(unsigned int) const
+        size_t getMemoryUsage() const
+        NeighborList * toNeighborList() except +
+
+cdef extern from "NeighborListCache.h" namespace "freud::locality":
+    cdef cppclass NeighborListCache:
+        NeighborListCache(size_t) except +
+        shared_ptr[NeighborList] get(const NeighborQuery*, const vec3[float]*,
+                                     unsigned int, QueryArgs) except +
+        void clear()
+        size_t getMaxMemory() const
+        void setMaxMemory(size_t)
+        size_t getMemoryUsage() const
+        unsigned int getNumEntries() const
+        unsigned int getNumHits() const
+        unsigned int getNumMisses() const
+
+cdef extern from "SpatialSort.h" namespace "freud::locality":
+    cdef cppclass SpatialSort:
+        SpatialSort(const freud._box.Box &,
+                    const vec3[float]*,
+                    unsigned int) except +
+        unsigned int getNPoints() const
+        const freud.util.ManagedArray[unsigned int] &getOrder() const
+        const freud.util.ManagedArray[unsigned int] &getInverseOrder() const
+
 cdef extern from "LinkCell.h" namespace "freud::locality":
     cdef cppclass LinkCell(NeighborQuery):
         LinkCell() except +
         LinkCell(const freud._box.Box &,
                  const vec3[float]*,
                  unsigned int,
-                 float) except +
+                 float,
+                 bool) except +
         float getCellWidth() const
+        bool getDeterministic() const
 
 cdef extern from "AABBQuery.h" namespace "freud::locality":
     cdef cppclass AABBQuery(NeighborQuery):
         AABBQuery() except +
         AABBQuery(const freud._box.Box,
                   const vec3[float]*,
-                  unsigned int) except +
+                  unsigned int,
+                  bool) except +
+        bool getLBVH() const
+        bool updatePoints(const vec3[float]*, unsigned int,
+                          float) except +
+
+cdef extern from "KDTree.h" namespace "freud::locality":
+    cdef cppclass KDTree(NeighborQuery):
+        KDTree() except +
+        KDTree(const freud._box.Box,
+               const vec3[float]*,
+               unsigned int) except +
+        unsigned int getNumNodes() const
+        unsigned int getDepth() const
 
 cdef extern from "BondHistogramCompute.h" namespace "freud::locality":
+    ctypedef enum AccumulationStrategy \
+            "freud::locality::BondHistogramCompute::AccumulationStrategy":
+        automatic "freud::locality::BondHistogramCompute::automatic"
+        local_copies "freud::locality::BondHistogramCompute::local_copies"
+        shared_atomic "freud::locality::BondHistogramCompute::shared_atomic"
+
+    cdef cppclass Frame "freud::locality::BondHistogramCompute::Frame":
+        freud._box.Box box
+        vec3[float] *points
+        unsigned int n_points
+        vec3[float] *query_points
+        unsigned int n_query_points
+
     cdef cppclass BondHistogramCompute:
         BondHistogramCompute()
 
         const freud._box.Box & getBox() const
         void reset()
+        AccumulationStrategy getAccumulationStrategy() const
+        void setAccumulationStrategy(AccumulationStrategy)
         const freud.util.ManagedArray[unsigned int] &getBinCounts()
         vector[vector[float]] getBinEdges() const
         vector[vector[float]] getBinCenters() const
@@ -139,3 +211,14 @@ cdef extern from "Voronoi.h" namespace "freud::locality":
         vector[vector[vec3[double]]] getPolytopes() const
         const freud.util.ManagedArray[double] &getVolumes() const
         shared_ptr[NeighborList] getNeighborList() const
+
+cdef extern from "VerletList.h" namespace "freud::locality":
+    cdef cppclass VerletList:
+        VerletList(float) except +
+        void compute(const NeighborQuery*, const vec3[float]*,
+                     unsigned int, QueryArgs) except +
+        float getSkin() const
+        float getEffectiveSkin() const
+        unsigned int getNumBuilds() const
+        bool getRebuilt() const
+        shared_ptr[NeighborList] getNeighborList() const
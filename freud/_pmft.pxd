@@ -27,6 +27,10 @@ cdef extern from "PMFTR12.h" namespace "freud::pmft":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateFrames(const vector[freud._locality.Frame] &,
+                              const vector[float*] &,
+                              const vector[float*] &,
+                              freud._locality.QueryArgs) except +
 
 cdef extern from "PMFTXYT.h" namespace "freud::pmft":
     cdef cppclass PMFTXYT(PMFT):
@@ -40,6 +44,10 @@ cdef extern from "PMFTXYT.h" namespace "freud::pmft":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateFrames(const vector[freud._locality.Frame] &,
+                              const vector[float*] &,
+                              const vector[float*] &,
+                              freud._locality.QueryArgs) except +
 
 cdef extern from "PMFTXY.h" namespace "freud::pmft":
     cdef cppclass PMFTXY(PMFT):
@@ -51,6 +59,9 @@ cdef extern from "PMFTXY.h" namespace "freud::pmft":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateFrames(const vector[freud._locality.Frame] &,
+                              const vector[float*] &,
+                              freud._locality.QueryArgs) except +
 
 cdef extern from "PMFTXYZ.h" namespace "freud::pmft":
     cdef cppclass PMFTXYZ(PMFT):
@@ -65,3 +76,8 @@ cdef extern from "PMFTXYZ.h" namespace "freud::pmft":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateFrames(const vector[freud._locality.Frame] &,
+                              const vector[quat[float]*] &,
+                              quat[float]*,
+                              unsigned int,
+                              freud._locality.QueryArgs) except +
@@ -12,6 +12,7 @@ import warnings
 import numpy as np
 
 from cython.operator cimport dereference
+from libcpp.vector cimport vector
 from freud.util cimport _Compute
 from freud.locality cimport _PairCompute, _SpatialHistogram1D
 from freud.util cimport vec3
@@ -19,6 +20,7 @@ from freud.util cimport vec3
 from collections.abc import Sequence
 
 cimport freud._density
+cimport freud._locality
 cimport freud.box, freud.locality
 cimport numpy as np
 cimport freud.util
@@ -114,20 +116,21 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
             unsigned int num_query_points
 
         nq, nlist, qargs, l_query_points, num_query_points = \
-            self._preprocess_arguments(system, query_points, neighbors)
+            self._preprocess_arguments(system, query_points, neighbors,
+                                       spatial_sort=True)
 
         # Save if any inputs have been complex so far.
         self.is_complex = self.is_complex or np.any(np.iscomplex(values)) or \
             np.any(np.iscomplex(query_values))
 
-        values = freud.util._convert_array(
-            values, shape=(nq.points.shape[0], ), dtype=np.complex128)
+        values = self._sort_points(freud.util._convert_array(
+            values, shape=(nq.points.shape[0], ), dtype=np.complex128))
         if query_values is None:
             query_values = values
         else:
-            query_values = freud.util._convert_array(
+            query_values = self._sort_query_points(freud.util._convert_array(
                 query_values, shape=(l_query_points.shape[0], ),
-                dtype=np.complex128)
+                dtype=np.complex128))
 
         cdef np.complex128_t[::1] l_values = values
         cdef np.complex128_t[::1] l_query_values = query_values
@@ -141,6 +144,81 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
             dereference(qargs.thisptr))
         return self
 
+    def compute_frames(self, systems, values, query_points=None,
+                       query_values=None, neighbors=None, reset=True):
+        R"""Calculates the correlation function of a sequence of frames and
+        adds to the current histogram.
+
+        This gives the same result as calling :meth:`compute` on each frame
+        with :code:`reset=False`, but finds the neighbors of the next frame
+        while the bonds of the current frame are binned. If a frame raises an
+        error, the frames before it remain accumulated.
+
+        Args:
+            systems (iterable):
+                The frames, each of which is any object that is a valid
+                argument to :class:`freud.locality.NeighborQuery.from_system`.
+                The neighbors of each frame are found with a data structure
+                selected for the frame.
+            values (iterable of (:math:`N_{points}`) :class:`numpy.ndarray`):
+                Values associated with the system points of each frame.
+            query_points (iterable of (:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points of each frame. Uses the points of each frame if
+                :code:`None` (Default value = :code:`None`).
+            query_values (iterable of (:math:`N_{query\_points}`) :class:`numpy.ndarray`, optional):
+                Query values of each frame. Uses :code:`values` if
+                :code:`None` (Default value = :code:`None`).
+            neighbors (dict, optional):
+                `Query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used to find the neighbors of every frame (Default value:
+                None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa E501
+        cdef vector[freud._locality.Frame] frames
+        cdef freud.locality._QueryArgs qargs
+        arrays, qargs = self._preprocess_frames(
+            systems, query_points, neighbors, &frames)
+
+        values = self._frame_data(values, 'values', frames.size())
+        if query_values is None:
+            query_values = values
+        else:
+            query_values = self._frame_data(
+                query_values, 'query values', frames.size())
+        is_complex = any(np.any(np.iscomplex(v)) for v in values) or \
+            any(np.any(np.iscomplex(v)) for v in query_values)
+
+        cdef vector[np.complex128_t*] c_values
+        cdef vector[np.complex128_t*] c_query_values
+        cdef np.complex128_t[::1] l_values
+        cdef size_t i
+        for i in range(frames.size()):
+            frame_values = freud.util._convert_array(
+                values[i], shape=(frames[i].n_points, ), dtype=np.complex128)
+            frame_query_values = freud.util._convert_array(
+                query_values[i], shape=(frames[i].n_query_points, ),
+                dtype=np.complex128)
+            arrays.append((frame_values, frame_query_values))
+            l_values = frame_values
+            c_values.push_back(<np.complex128_t*> &l_values[0])
+            l_values = frame_query_values
+            c_query_values.push_back(<np.complex128_t*> &l_values[0])
+
+        if reset:
+            self.is_complex = False
+            self._reset()
+        # Save if any inputs have been complex so far.
+        self.is_complex = self.is_complex or is_complex
+        if frames.size() > 0:
+            self._called_compute = True
+        self.thisptr.accumulateFrames(frames, c_values, c_query_values,
+                                      dereference(qargs.thisptr))
+        return self
+
     @_Compute._computed_property
     def correlation(self):
         """(:math:`N_{bins}`) :class:`numpy.ndarray`: Expected (average)
@@ -367,22 +445,33 @@ cdef class LocalDensity(_PairCompute):
                 Query points used to calculate the correlation function. Uses
                 the system's points if :code:`None` (Default
                 value = :code:`None`).
-            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
-                Either a :class:`NeighborList <freud.locality.NeighborList>` of
-                neighbor pairs to use in the calculation, or a dictionary of
-                `query arguments
+            neighbors (:class:`freud.locality.NeighborList`, :class:`freud.locality.CompressedNeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` or
+                :class:`CompressedNeighborList
+                <freud.locality.CompressedNeighborList>` of neighbor pairs to
+                use in the calculation, or a dictionary of `query arguments
                 <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
                 (Default value: None).
         """  # noqa E501
         cdef:
             freud.locality.NeighborQuery nq
             freud.locality.NeighborList nlist
+            freud.locality.CompressedNeighborList cnlist
             freud.locality._QueryArgs qargs
             const float[:, ::1] l_query_points
             unsigned int num_query_points
 
+        if isinstance(neighbors, freud.locality.CompressedNeighborList):
+            cnlist = neighbors
+            nq, num_query_points = self._preprocess_compressed_arguments(
+                system, query_points)
+            self.thisptr.compute(nq.get_ptr(), num_query_points,
+                                 cnlist.get_ptr())
+            return self
+
         nq, nlist, qargs, l_query_points, num_query_points = \
-            self._preprocess_arguments(system, query_points, neighbors)
+            self._preprocess_arguments(system, query_points, neighbors,
+                                       spatial_sort=True)
         self.thisptr.compute(
             nq.get_ptr(),
             <vec3[float]*> &l_query_points[0, 0],
@@ -401,17 +490,17 @@ cdef class LocalDensity(_PairCompute):
     def density(self):
         """(:math:`N_{points}`) :class:`numpy.ndarray`: Density of points per
         query point."""
-        return freud.util.make_managed_numpy_array(
+        return self._unsort_query_points(freud.util.make_managed_numpy_array(
             &self.thisptr.getDensity(),
-            freud.util.arr_type_t.FLOAT)
+            freud.util.arr_type_t.FLOAT))
 
     @_Compute._computed_property
     def num_neighbors(self):
         """(:math:`N_{points}`) :class:`numpy.ndarray`: Number of neighbor
         points for each query point."""
-        return freud.util.make_managed_numpy_array(
+        return self._unsort_query_points(freud.util.make_managed_numpy_array(
             &self.thisptr.getNumNeighbors(),
-            freud.util.arr_type_t.FLOAT)
+            freud.util.arr_type_t.FLOAT))
 
     def __repr__(self):
         return ("freud.density.{cls}(r_max={r_max}, "
@@ -494,10 +583,11 @@ cdef class RDF(_SpatialHistogram1D):
                 Query points used to calculate the RDF. Uses the system's
                 points if :code:`None` (Default value =
                 :code:`None`).
-            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
-                Either a :class:`NeighborList <freud.locality.NeighborList>` of
-                neighbor pairs to use in the calculation, or a dictionary of
-                `query arguments
+            neighbors (:class:`freud.locality.NeighborList`, :class:`freud.locality.CompressedNeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` or
+                :class:`CompressedNeighborList
+                <freud.locality.CompressedNeighborList>` of neighbor pairs to
+                use in the calculation, or a dictionary of `query arguments
                 <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
                 (Default value: None).
             reset (bool):
@@ -511,11 +601,22 @@ cdef class RDF(_SpatialHistogram1D):
         cdef:
             freud.locality.NeighborQuery nq
             freud.locality.NeighborList nlist
+            freud.locality.CompressedNeighborList cnlist
             freud.locality._QueryArgs qargs
             const float[:, ::1] l_query_points
             unsigned int num_query_points
+
+        if isinstance(neighbors, freud.locality.CompressedNeighborList):
+            cnlist = neighbors
+            nq, num_query_points = self._preprocess_compressed_arguments(
+                system, query_points)
+            self.thisptr.accumulate(nq.get_ptr(), num_query_points,
+                                    cnlist.get_ptr())
+            return self
+
         nq, nlist, qargs, l_query_points, num_query_points = \
-            self._preprocess_arguments(system, query_points, neighbors)
+            self._preprocess_arguments(system, query_points, neighbors,
+                                       spatial_sort=True)
 
         self.thisptr.accumulate(
             nq.get_ptr(),
@@ -524,6 +625,47 @@ cdef class RDF(_SpatialHistogram1D):
             dereference(qargs.thisptr))
         return self
 
+    def compute_frames(self, systems, query_points=None, neighbors=None,
+                       reset=True):
+        R"""Calculates the RDF of a sequence of frames and adds it to the
+        current RDF histogram.
+
+        This gives the same result as calling :meth:`compute` on each frame
+        with :code:`reset=False`, but finds the neighbors of the next frame
+        while the bonds of the current frame are binned. If a frame raises an
+        error, the frames before it remain accumulated.
+
+        Args:
+            systems (iterable):
+                The frames, each of which is any object that is a valid
+                argument to :class:`freud.locality.NeighborQuery.from_system`.
+                The neighbors of each frame are found with a data structure
+                selected for the frame.
+            query_points (iterable of (:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points of each frame. Uses the points of each frame if
+                :code:`None` (Default value = :code:`None`).
+            neighbors (dict, optional):
+                `Query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used to find the neighbors of every frame (Default value:
+                None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa E501
+        cdef vector[freud._locality.Frame] frames
+        cdef freud.locality._QueryArgs qargs
+        arrays, qargs = self._preprocess_frames(
+            systems, query_points, neighbors, &frames)
+
+        if reset:
+            self._reset()
+        if frames.size() > 0:
+            self._called_compute = True
+        self.thisptr.accumulateFrames(frames, dereference(qargs.thisptr))
+        return self
+
     @_Compute._computed_property
     def rdf(self):
         """(:math:`N_{bins}`,) :class:`numpy.ndarray`: Histogram of RDF
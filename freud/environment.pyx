@@ -21,6 +21,7 @@ from libcpp.map cimport map
 from cython.operator cimport dereference
 cimport freud.box
 cimport freud._environment
+cimport freud._locality
 cimport freud.locality
 cimport freud.util
 
@@ -175,16 +176,18 @@ cdef class BondOrder(_SpatialHistogram):
             unsigned int num_query_points
 
         nq, nlist, qargs, l_query_points, num_query_points = \
-            self._preprocess_arguments(system, query_points, neighbors)
+            self._preprocess_arguments(system, query_points, neighbors,
+                                       spatial_sort=True)
         if orientations is None:
             orientations = np.array([[1, 0, 0, 0]] * nq.points.shape[0])
         if query_orientations is None:
             query_orientations = orientations
 
-        orientations = freud.util._convert_array(
-            orientations, shape=(nq.points.shape[0], 4))
-        query_orientations = freud.util._convert_array(
-            query_orientations, shape=(num_query_points, 4))
+        orientations = self._sort_points(freud.util._convert_array(
+            orientations, shape=(nq.points.shape[0], 4)))
+        query_orientations = self._sort_query_points(
+            freud.util._convert_array(
+                query_orientations, shape=(num_query_points, 4)))
 
         cdef const float[:, ::1] l_orientations = orientations
         cdef const float[:, ::1] l_query_orientations = query_orientations
@@ -198,6 +201,84 @@ cdef class BondOrder(_SpatialHistogram):
             nlist.get_ptr(), dereference(qargs.thisptr))
         return self
 
+    def compute_frames(self, systems, orientations=None, query_points=None,
+                       query_orientations=None, neighbors=None, reset=True):
+        R"""Calculates the bond order diagram of a sequence of frames and adds
+        to the current histogram.
+
+        This gives the same result as calling :meth:`compute` on each frame
+        with :code:`reset=False`, but finds the neighbors of the next frame
+        while the bonds of the current frame are binned. If a frame raises an
+        error, the frames before it remain accumulated.
+
+        Args:
+            systems (iterable):
+                The frames, each of which is any object that is a valid
+                argument to :class:`freud.locality.NeighborQuery.from_system`.
+                The neighbors of each frame are found with a data structure
+                selected for the frame.
+            orientations (iterable of (:math:`N_{points}`, 4) :class:`numpy.ndarray`, optional):
+                Orientations of the points of each frame. Uses identity
+                quaternions if :code:`None` (Default value = :code:`None`).
+            query_points (iterable of (:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points of each frame. Uses the points of each frame if
+                :code:`None` (Default value = :code:`None`).
+            query_orientations (iterable of (:math:`N_{query\_points}`, 4) :class:`numpy.ndarray`, optional):
+                Query orientations of each frame. Uses :code:`orientations` if
+                :code:`None` (Default value = :code:`None`).
+            neighbors (dict):
+                `Query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used to find the neighbors of every frame.
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        cdef vector[freud._locality.Frame] frames
+        cdef freud.locality._QueryArgs qargs
+        arrays, qargs = self._preprocess_frames(
+            systems, query_points, neighbors, &frames)
+
+        cdef size_t i
+        if orientations is None:
+            orientations = []
+            for i in range(frames.size()):
+                orientations.append(
+                    np.array([[1, 0, 0, 0]] * frames[i].n_points))
+        else:
+            orientations = self._frame_data(
+                orientations, 'orientations', frames.size())
+        if query_orientations is None:
+            query_orientations = orientations
+        else:
+            query_orientations = self._frame_data(
+                query_orientations, 'query orientations', frames.size())
+
+        cdef vector[quat[float]*] c_orientations
+        cdef vector[quat[float]*] c_query_orientations
+        cdef const float[:, ::1] l_orientations
+        for i in range(frames.size()):
+            frame_orientations = freud.util._convert_array(
+                orientations[i], shape=(frames[i].n_points, 4))
+            frame_query_orientations = freud.util._convert_array(
+                query_orientations[i], shape=(frames[i].n_query_points, 4))
+            arrays.append((frame_orientations, frame_query_orientations))
+            l_orientations = frame_orientations
+            c_orientations.push_back(<quat[float]*> &l_orientations[0, 0])
+            l_orientations = frame_query_orientations
+            c_query_orientations.push_back(
+                <quat[float]*> &l_orientations[0, 0])
+
+        if reset:
+            self._reset()
+        if frames.size() > 0:
+            self._called_compute = True
+        self.thisptr.accumulateFrames(
+            frames, c_orientations, c_query_orientations,
+            dereference(qargs.thisptr))
+        return self
+
     @_Compute._computed_property
     def bond_order(self):
         """:math:`\\left(N_{\\phi}, N_{\\theta} \\right)` :class:`numpy.ndarray`: Bond order."""  # noqa: E501
@@ -3,6 +3,7 @@
 
 from libcpp cimport bool as cbool
 from libcpp.memory cimport shared_ptr
+from libcpp.vector cimport vector
 from freud.util cimport _Compute
 
 from cython.operator cimport dereference
@@ -37,36 +38,60 @@ cdef class NeighborQueryResult:
 
         return obj
 
+cdef class SpatialSort:
+    cdef freud._locality.SpatialSort * thisptr
+
 cdef class NeighborQuery:
     cdef freud._locality.NeighborQuery * nqptr
     cdef const float[:, ::1] points
+    cdef SpatialSort _spatial_sort
+    cdef NeighborQuery _original
     cdef freud._locality.NeighborQuery * get_ptr(self)
+    cdef _set_points(self, freud.box.Box b, points, spatial_sort)
 
 cdef class NeighborList:
     cdef freud._locality.NeighborList * thisptr
     cdef char _managed
+    cdef shared_ptr[freud._locality.NeighborList] _shared
 
     cdef freud._locality.NeighborList * get_ptr(self)
     cdef void copy_c(self, NeighborList other)
 
+cdef class CompressedNeighborList:
+    cdef freud._locality.CompressedNeighborList * thisptr
+
+    cdef freud._locality.CompressedNeighborList * get_ptr(self)
+
 cdef class LinkCell(NeighborQuery):
     cdef freud._locality.LinkCell * thisptr
 
 cdef class AABBQuery(NeighborQuery):
     cdef freud._locality.AABBQuery * thisptr
 
+cdef class KDTree(NeighborQuery):
+    cdef freud._locality.KDTree * thisptr
+
 cdef class _RawPoints(NeighborQuery):
     cdef freud._locality.RawPoints * thisptr
 
 cdef class _QueryArgs:
     cdef freud._locality.QueryArgs * thisptr
 
+cdef class NeighborListCache:
+    cdef freud._locality.NeighborListCache * thisptr
+    cdef NeighborList _get(self, NeighborQuery nq,
+                           const float[:, ::1] query_points,
+                           _QueryArgs qargs)
+
 cdef class _PairCompute(_Compute):
-    pass
+    cdef SpatialSort _point_sort
+    cdef SpatialSort _query_point_sort
 
 cdef class _SpatialHistogram(_PairCompute):
     cdef float r_max
     cdef freud._locality.BondHistogramCompute *histptr
+    cdef _preprocess_frames(self, systems, query_points, neighbors,
+                            vector[freud._locality.Frame] *frames)
 
 cdef class _SpatialHistogram1D(_SpatialHistogram):
     pass
@@ -78,3 +103,7 @@ cdef class Voronoi(_Compute):
     cdef freud._locality.Voronoi * thisptr
     cdef NeighborList _nlist
     cdef freud.box.Box _box
+
+cdef class VerletList(_PairCompute):
+    cdef freud._locality.VerletList * thisptr
+    cdef NeighborList _nlist
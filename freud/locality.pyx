@@ -29,6 +29,9 @@ cimport numpy as np
 
 logger = logging.getLogger(__name__)
 
+# Stack of the active NeighborListCache objects, innermost last.
+_active_neighbor_list_caches = []
+
 # numpy must be initialized. When using numpy from C or Cython you must
 # _always_ do that, or you will have segfaults
 np.import_array()
@@ -45,7 +48,7 @@ cdef class _QueryArgs:
 
     def __cinit__(self, mode=None, r_min=None, r_max=None, r_guess=None,
                   num_neighbors=None, exclude_ii=None,
-                  scale=None, **kwargs):
+                  scale=None, symmetric_half=None, **kwargs):
         if type(self) == _QueryArgs:
             self.thisptr = new freud._locality.QueryArgs()
             self.mode = mode
@@ -61,6 +64,8 @@ cdef class _QueryArgs:
                 self.exclude_ii = exclude_ii
             if scale is not None:
                 self.scale = scale
+            if symmetric_half is not None:
+                self.symmetric_half = symmetric_half
             if len(kwargs):
                 err_str = ", ".join(
                     "{} = {}".format(k, v) for k, v in kwargs.items())
@@ -157,15 +162,24 @@ cdef class _QueryArgs:
     def scale(self, value):
         self.thisptr.scale = value
 
+    @property
+    def symmetric_half(self):
+        return self.thisptr.symmetric_half
+
+    @symmetric_half.setter
+    def symmetric_half(self, value):
+        self.thisptr.symmetric_half = value
+
     def __repr__(self):
         return ("freud.locality.{cls}(mode={mode}, r_max={r_max}, "
                 "num_neighbors={num_neighbors}, exclude_ii={exclude_ii}, "
-                "scale={scale})").format(
+                "scale={scale}, symmetric_half={symmetric_half})").format(
                     cls=type(self).__name__,
-                    mode=self.mode, r_max=self.r_max,
+                    mode=repr(self.mode), r_max=self.r_max,
                     num_neighbors=self.num_neighbors,
                     exclude_ii=self.exclude_ii,
-                    scale=self.scale)
+                    scale=self.scale,
+                    symmetric_half=self.symmetric_half)
 
     def __str__(self):
         return repr(self)
@@ -206,9 +220,22 @@ cdef class NeighborQueryResult:
 
         raise StopIteration
 
-    def toNeighborList(self):
+    def toNeighborList(self, mirror=False, vectors=False):
         """Convert query result to a freud NeighborList.
 
+        Args:
+            mirror (bool, optional):
+                If True, the reverse of every bond is added to the
+                :class:`~NeighborList`. This is intended for results of
+                queries with :code:`symmetric_half=True`, converting the
+                list of unique pairs into the full (sorted)
+                :class:`~NeighborList` (Default value = False).
+            vectors (bool, optional):
+                If True, the vector of every bond is stored in the
+                :class:`~NeighborList` (see :attr:`NeighborList.vectors`),
+                so that computes using the list do not need to recompute
+                them (Default value = False).
+
         Returns:
             :class:`~NeighborList`: A :mod:`freud` :class:`~NeighborList`
             containing all neighbor pairs found by the query generating this
@@ -222,7 +249,9 @@ cdef class NeighborQueryResult:
                 dereference(self.query_args.thisptr))
 
         cdef freud._locality.NeighborList *cnlist = dereference(
-            iterator).toNeighborList()
+            iterator).toNeighborList(vectors)
+        if mirror:
+            cnlist.mirror()
         cdef NeighborList nl = _nlist_from_cnlist(cnlist)
         # Explicitly manage a manually created nlist so that it will be
         # deleted when the Python object is.
@@ -238,8 +267,8 @@ cdef class NeighborQuery:
     .. warning::
 
         This class should not be instantiated directly. The subclasses
-        :class:`~AABBQuery` and :class:`~LinkCell` provide the
-        intended interfaces.
+        :class:`~AABBQuery`, :class:`~LinkCell`, and :class:`~KDTree` provide
+        the intended interfaces.
 
     The :class:`~.NeighborQuery` class represents the abstract interface for
     neighbor finding. The class contains a set of points and a simulation box,
@@ -252,6 +281,15 @@ cdef class NeighborQuery:
     NeighborQuery implement these methods based on the nature of the underlying
     data structure.
 
+    If the points were spatially sorted when the structure was built (see
+    :attr:`spatial_sort`), the structure stores them along a space-filling
+    curve, and computes given this object visit the points in that order.
+    The reordering is not visible to users: :attr:`points`, the results of
+    :meth:`query`, and the per-point inputs and outputs of computes are all
+    in the original order of the points. Computes that do not support the
+    sorted order, or that are given a :class:`~.NeighborList`, use the points
+    in their original order instead.
+
     Args:
         box (:class:`freud.box.Box`):
             Simulation box.
@@ -281,6 +319,7 @@ cdef class NeighborQuery:
 
         * :class:`~.locality.AABBQuery`
         * :class:`~.locality.LinkCell`
+        * :class:`~.locality.KDTree`
         * A sequence of :code:`(box, points)` where :code:`box` is a
           :class:`~.box.Box` and :code:`points` is a :class:`numpy.ndarray`.
         * Objects with attributes :code:`box` and :code:`points`.
@@ -371,9 +410,19 @@ cdef class NeighborQuery:
 
     @property
     def points(self):
-        """:class:`np.ndarray`: The array of points in this data structure."""
+        """:class:`np.ndarray`: The array of points in this data structure, in
+        their original order."""
+        if self._spatial_sort is not None:
+            return np.asarray(self._original.points)
         return np.asarray(self.points)
 
+    @property
+    def spatial_sort(self):
+        """:class:`~.SpatialSort`: The order along a space-filling curve in
+        which this data structure stores its points if they were spatially
+        sorted when this object was constructed, otherwise :code:`None`."""
+        return self._spatial_sort
+
     def query(self, query_points, query_args):
         R"""Query for nearest neighbors of the provided point.
 
@@ -393,12 +442,38 @@ cdef class NeighborQuery:
             np.atleast_2d(query_points), shape=(None, 3))
 
         cdef _QueryArgs args = _QueryArgs.from_dict(query_args)
-        return NeighborQueryResult.init(self, query_points, args)
+        cdef NeighborQuery nq = self._original_order()
+        # A symmetric_half query must use the points of this object, so equal
+        # query points given in a different array are replaced by them.
+        if args.symmetric_half and np.array_equal(query_points, nq.points):
+            query_points = nq.points
+        return NeighborQueryResult.init(nq, query_points, args)
 
     cdef freud._locality.NeighborQuery * get_ptr(self):
         R"""Returns a pointer to the raw C++ object we are wrapping."""
         return self.nqptr
 
+    cdef _set_points(self, freud.box.Box b, points, spatial_sort):
+        R"""Store the points, or a copy of them reordered along a
+        space-filling curve if requested."""
+        points = freud.util._convert_array(points, shape=(None, 3))
+        if spatial_sort:
+            self._spatial_sort = SpatialSort(b, points)
+            self._original = _RawPoints(b, points)
+            self.points = self._spatial_sort.sort(points)
+        else:
+            self.points = points
+
+    def _original_order(self):
+        R"""Return a :class:`~.NeighborQuery` of the points in their original
+        order.
+
+        This is this object unless its points are spatially sorted, in which
+        case it is a :class:`~._RawPoints` of the original points. Its
+        neighbors are found with a structure of its own, built on first use.
+        """
+        return self if self._spatial_sort is None else self._original
+
     def plot(self, ax=None, title=None, *args, **kwargs):
         """Plot system box and points.
 
@@ -598,6 +673,19 @@ cdef class NeighborList:
             &self.thisptr.getDistances(),
             freud.util.arr_type_t.FLOAT)
 
+    @property
+    def vectors(self):
+        """(:math:`N_{bonds}`, 3) :class:`np.ndarray`: The vector of each
+        bond, pointing from the query point to the point and wrapped into the
+        box, or :code:`None` if the vectors are not stored (see
+        :meth:`NeighborQueryResult.toNeighborList`). Stored vectors are kept
+        when bonds are filtered."""
+        if not self.thisptr.hasVectors():
+            return None
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getVectors(),
+            freud.util.arr_type_t.FLOAT, 3)
+
     @property
     def segments(self):
         """(:math:`N_{query\\_points}`) :class:`np.ndarray`: A segment array
@@ -681,19 +769,306 @@ cdef NeighborList _nlist_from_cnlist(freud._locality.NeighborList *c_nlist):
     return result
 
 
+cdef NeighborList _nlist_from_shared_cnlist(
+        shared_ptr[freud._locality.NeighborList] c_nlist):
+    """Create a Python NeighborList object that shares ownership of an
+    existing C++ NeighborList object, keeping it alive for as long as the
+    Python object exists."""
+    cdef NeighborList result
+    result = NeighborList(_null=True)
+    result._shared = c_nlist
+    result.thisptr = c_nlist.get()
+    return result
+
+
+cdef class CompressedNeighborList:
+    R"""Class storing the bonds between two sets of points compactly.
+
+    A :class:`~.CompressedNeighborList` holds the same bonds as a
+    :class:`~.NeighborList` in much less memory, which makes it possible to
+    keep the neighbors of very large systems. The bonds of each query point
+    are stored contiguously, the point indices are optionally delta-encoded
+    as variable-length integers, and the weights are only stored if any of
+    them differs from 1. In exchange, the bonds can only be read one query
+    point at a time, so no per-bond arrays are exposed. Use
+    :meth:`to_neighbor_list` to obtain a :class:`~.NeighborList` with the same
+    bonds.
+
+    The :class:`freud.density.RDF` and :class:`freud.density.LocalDensity`
+    classes accept a :class:`~.CompressedNeighborList` as their
+    :code:`neighbors` argument.
+
+    Example::
+
+        aq = freud.locality.AABBQuery(box, points)
+        cnlist = freud.locality.CompressedNeighborList.from_query(
+            aq, dict(r_max=3))
+        rdf = freud.density.RDF(bins=100, r_max=3)
+        rdf.compute(aq, neighbors=cnlist)
+    """
+
+    @classmethod
+    def from_neighbor_list(cls, NeighborList nlist, delta_encode=True):
+        R"""Compress the bonds of a :class:`~.NeighborList`.
+
+        Args:
+            nlist (:class:`~.NeighborList`):
+                The neighbor list to compress.
+            delta_encode (bool, optional):
+                Whether to delta-encode the point indices (Default value =
+                :code:`True`).
+        """
+        cdef CompressedNeighborList result = cls()
+        del result.thisptr
+        result.thisptr = new freud._locality.CompressedNeighborList(
+            dereference(nlist.get_ptr()), delta_encode)
+        return result
+
+    @classmethod
+    def from_query(cls, system, query_args, query_points=None,
+                   delta_encode=True):
+        R"""Find the bonds of a query and store them compressed.
+
+        The bonds are compressed as they are found, so the uncompressed bonds
+        of all query points are never held in memory at once.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            query_args (dict):
+                Query arguments to use. The :code:`exclude_ii` query argument
+                defaults to :code:`True` if :code:`query_points` is
+                :code:`None` and :code:`False` otherwise.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points to find neighbors of. Uses the system's points if
+                :code:`None` (Default value = :code:`None`).
+            delta_encode (bool, optional):
+                Whether to delta-encode the point indices (Default value =
+                :code:`True`).
+        """  # noqa: E501
+        cdef NeighborQuery nq = \
+            NeighborQuery.from_system(system)._original_order()
+        query_args = query_args.copy()
+        query_args.setdefault('exclude_ii', query_points is None)
+        cdef _QueryArgs qargs = _QueryArgs.from_dict(query_args)
+        if query_points is None:
+            query_points = nq.points
+        else:
+            query_points = freud.util._convert_array(
+                query_points, shape=(None, 3))
+        cdef const float[:, ::1] l_query_points = query_points
+        cdef CompressedNeighborList result = cls()
+        del result.thisptr
+        result.thisptr = new freud._locality.CompressedNeighborList(
+            nq.get_ptr(), <vec3[float]*> &l_query_points[0, 0],
+            l_query_points.shape[0], dereference(qargs.thisptr),
+            delta_encode)
+        return result
+
+    def __cinit__(self):
+        self.thisptr = new freud._locality.CompressedNeighborList()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    cdef freud._locality.CompressedNeighborList * get_ptr(self):
+        R"""Returns a pointer to the raw C++ object we are wrapping."""
+        return self.thisptr
+
+    def to_neighbor_list(self):
+        R"""Decompress the bonds into a new :class:`~.NeighborList`.
+
+        Returns:
+            :class:`~.NeighborList`: A neighbor list with the same bonds.
+        """
+        cdef shared_ptr[freud._locality.NeighborList] cnlist
+        cnlist.reset(self.thisptr.toNeighborList())
+        return _nlist_from_shared_cnlist(cnlist)
+
+    @property
+    def num_bonds(self):
+        """int: The number of bonds stored in this list."""
+        return self.thisptr.getNumBonds()
+
+    @property
+    def num_query_points(self):
+        """int: The number of query points this list was built with."""
+        return self.thisptr.getNumQueryPoints()
+
+    @property
+    def num_points(self):
+        """int: The number of points this list was built with."""
+        return self.thisptr.getNumPoints()
+
+    @property
+    def delta_encoded(self):
+        """bool: Whether the point indices are delta-encoded."""
+        return self.thisptr.getDeltaEncoded()
+
+    @property
+    def has_weights(self):
+        """bool: Whether weights are stored (:code:`False` if all weights
+        are 1)."""
+        return self.thisptr.hasWeights()
+
+    @property
+    def memory_usage(self):
+        """int: Number of bytes used to store the bonds."""
+        return self.thisptr.getMemoryUsage()
+
+    def __len__(self):
+        R"""Returns the number of bonds stored in this object."""
+        return self.thisptr.getNumBonds()
+
+
+cdef class NeighborListCache:
+    R"""Shares neighbor lists between computes that perform the same query.
+
+    When several computes are run on the same system with the same query
+    arguments, each of them normally finds the same neighbors. While a
+    :class:`~.NeighborListCache` is active, computes that are given query
+    arguments (rather than a :class:`~.NeighborList`) take the
+    :class:`~.NeighborList` of their query from the cache, so the neighbors of
+    each distinct query are only found once. A cache is activated by using it
+    as a context manager.
+
+    Lists are keyed on the :class:`~.NeighborQuery` object, the query points,
+    and the query arguments, so computes only share lists if they are given
+    the same :class:`~.NeighborQuery` object rather than a tuple of a box and
+    points. Updating the points of a :class:`~.NeighborQuery` (e.g. with
+    :meth:`AABBQuery.update_points`) invalidates its cached lists. If the
+    cached lists use more than :code:`max_memory` bytes, the least recently
+    used lists are evicted.
+
+    .. note::
+
+        The cached lists are shared by all computes that use them, so they
+        must not be modified (e.g. with :meth:`NeighborList.filter`).
+
+    Example::
+
+        aq = freud.locality.AABBQuery(box, points)
+        query_args = dict(r_max=1.5)
+        with freud.locality.NeighborListCache():
+            # The neighbors are only found once.
+            ql = freud.order.Steinhardt(6).compute(aq, neighbors=query_args)
+            cl = freud.cluster.Cluster().compute(aq, neighbors=query_args)
+
+    Args:
+        max_memory (int, optional):
+            Maximum number of bytes of neighbor lists to keep (Default value
+            = :code:`2**30`).
+    """
+
+    def __cinit__(self, max_memory=2**30):
+        self.thisptr = new freud._locality.NeighborListCache(max_memory)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def __enter__(self):
+        _active_neighbor_list_caches.append(self)
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        _active_neighbor_list_caches.remove(self)
+
+    cdef NeighborList _get(self, NeighborQuery nq,
+                           const float[:, ::1] query_points,
+                           _QueryArgs qargs):
+        return _nlist_from_shared_cnlist(self.thisptr.get(
+            nq.get_ptr(), <vec3[float]*> &query_points[0, 0],
+            query_points.shape[0], dereference(qargs.thisptr)))
+
+    def get(self, system, query_args, query_points=None):
+        R"""Get the :class:`~.NeighborList` of a query, finding the
+        neighbors only if it is not cached.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            query_args (dict):
+                Query arguments to use. The :code:`exclude_ii` query argument
+                defaults to :code:`True` if :code:`query_points` is
+                :code:`None` and :code:`False` otherwise.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points to find neighbors of. Uses the system's points if
+                :code:`None` (Default value = :code:`None`).
+
+        Returns:
+            :class:`~.NeighborList`: The neighbor list of the query.
+        """  # noqa: E501
+        cdef NeighborQuery nq = \
+            NeighborQuery.from_system(system)._original_order()
+        query_args = query_args.copy()
+        query_args.setdefault('exclude_ii', query_points is None)
+        cdef _QueryArgs qargs = _QueryArgs.from_dict(query_args)
+        if query_points is None:
+            query_points = nq.points
+        else:
+            query_points = freud.util._convert_array(
+                query_points, shape=(None, 3))
+        return self._get(nq, query_points, qargs)
+
+    def clear(self):
+        R"""Remove all neighbor lists from the cache."""
+        self.thisptr.clear()
+
+    @property
+    def max_memory(self):
+        """int: Maximum number of bytes of neighbor lists to keep. Setting it
+        evicts the least recently used lists if necessary."""
+        return self.thisptr.getMaxMemory()
+
+    @max_memory.setter
+    def max_memory(self, max_memory):
+        self.thisptr.setMaxMemory(max_memory)
+
+    @property
+    def memory_usage(self):
+        """int: Number of bytes used by the cached neighbor lists."""
+        return self.thisptr.getMemoryUsage()
+
+    @property
+    def num_entries(self):
+        """int: Number of cached neighbor lists."""
+        return self.thisptr.getNumEntries()
+
+    @property
+    def num_hits(self):
+        """int: Number of requests answered from the cache."""
+        return self.thisptr.getNumHits()
+
+    @property
+    def num_misses(self):
+        """int: Number of requests that required finding neighbors."""
+        return self.thisptr.getNumMisses()
+
+    def __repr__(self):
+        return "freud.locality.{cls}(max_memory={max_memory})".format(
+            cls=type(self).__name__, max_memory=self.max_memory)
+
+    def __str__(self):
+        return repr(self)
+
+
 def _make_default_nq(neighbor_query):
     R"""Helper function to return a NeighborQuery object.
 
     Currently the resolution for NeighborQuery objects is such that if Python
     users pass in a NumPy array of points and a box, we always make a
     _RawPoints object. On the C++ side, the _RawPoints object internally
-    constructs an AABBQuery object to find neighbors if needed. On the Python
-    side, making the _RawPoints object is just so that compute functions on the
-    C++ side don't require overloads to work.
+    selects and constructs a NeighborQuery object suited to the system and
+    query arguments to find neighbors if needed. On the Python side, making
+    the _RawPoints object is just so that compute functions on the C++ side
+    don't require overloads to work.
 
     Supported types for :code:`neighbor_query` include:
     - :class:`~.locality.AABBQuery`
     - :class:`~.locality.LinkCell`
+    - :class:`~.locality.KDTree`
     - A tuple of :code:`(box, points)` where :code:`box` is a
       :class:`~.box.Box` and :code:`points` is a :class:`numpy.ndarray`.
 
@@ -746,14 +1121,122 @@ def _make_default_nlist(system, neighbors, query_points=None):
     else:
         query_args = neighbors.copy()
         query_args.setdefault('exclude_ii', query_points is None)
-        nq = _make_default_nq(system)
+        nq = _make_default_nq(system)._original_order()
         qp = query_points if query_points is not None else nq.points
         return nq.query(qp, query_args).toNeighborList()
 
 
+cdef class SpatialSort:
+    R"""Orders points along a Morton (Z-order) space-filling curve.
+
+    Simulation engines usually store particles in an order unrelated to
+    their positions, so loops over neighbors read the coordinates and
+    per-particle data of neighbors from scattered memory. Reordering the
+    points so that points close in space are close in memory makes these
+    reads much more cache friendly, which speeds up most computes on large
+    systems.
+
+    The points are sorted by the Morton code of their wrapped fractional
+    coordinates. Computes can then be run on the sorted points, with any
+    per-point arrays sorted in the same way with :meth:`sort`, and per-point
+    results can be returned to the original order with :meth:`unsort`.
+
+    Constructing a :class:`~.NeighborQuery` with :code:`spatial_sort=True`
+    does this automatically: the points are stored in the sorted order, and
+    computes given the :class:`~.NeighborQuery` sort their per-point inputs
+    and unsort their per-point outputs, so that users only ever see the
+    original order.
+
+    Example::
+
+        aq = freud.locality.AABBQuery(box, points, spatial_sort=True)
+        ql = freud.order.Steinhardt(6).compute(
+            aq, neighbors=dict(num_neighbors=12))
+        # ql.particle_order is in the order of points.
+
+    Args:
+        box (:class:`freud.box.Box`):
+            Simulation box.
+        points ((:math:`N_{points}`, 3) :class:`numpy.ndarray`):
+            The points to order.
+    """
+
+    def __cinit__(self, box, points):
+        cdef freud.box.Box b = freud.util._convert_box(box)
+        cdef const float[:, ::1] l_points
+        points = freud.util._convert_array(points, shape=(None, 3))
+        l_points = points
+        self.thisptr = new freud._locality.SpatialSort(
+            dereference(b.thisptr),
+            <vec3[float]*> &l_points[0, 0],
+            l_points.shape[0])
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def order(self):
+        """(:math:`N_{points}`) :class:`numpy.ndarray`: The index of the
+        original point at each position of the sorted order."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getOrder(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @property
+    def inverse_order(self):
+        """(:math:`N_{points}`) :class:`numpy.ndarray`: The position in
+        the sorted order of each original point."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getInverseOrder(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    def _check_length(self, values):
+        values = np.asarray(values)
+        if values.shape[0] != self.thisptr.getNPoints():
+            raise ValueError(
+                "The array has {} values, but {} points were ordered.".format(
+                    values.shape[0], self.thisptr.getNPoints()))
+        return values
+
+    def sort(self, values):
+        R"""Reorder an array of per-point values into the sorted order.
+
+        Args:
+            values ((:math:`N_{points}`, ...) :class:`numpy.ndarray`):
+                Values of each point, in the original order.
+
+        Returns:
+            (:math:`N_{points}`, ...) :class:`numpy.ndarray`: The values in
+            the sorted order.
+        """
+        return self._check_length(values)[self.order]
+
+    def unsort(self, values):
+        R"""Return an array of per-point values to the original order.
+
+        Args:
+            values ((:math:`N_{points}`, ...) :class:`numpy.ndarray`):
+                Values of each point, in the sorted order.
+
+        Returns:
+            (:math:`N_{points}`, ...) :class:`numpy.ndarray`: The values in
+            the original order.
+        """
+        return self._check_length(values)[self.inverse_order]
+
+    def __repr__(self):
+        return "freud.locality.{cls}(num_points={n})".format(
+            cls=type(self).__name__, n=self.thisptr.getNPoints())
+
+
 cdef class _RawPoints(NeighborQuery):
     R"""Class containing :class:`~.box.Box` and points with no spatial data
-    structures for accelerating neighbor queries."""
+    structures of its own for accelerating neighbor queries.
+
+    When queried, a :class:`~.LinkCell` or :class:`~.KDTree` is selected
+    based on the box, the density and homogeneity of the points, and the
+    query arguments, and is built on first use and reused by later queries
+    with the same query mode and :code:`r_max`."""
 
     def __cinit__(self, box, points):
         cdef const float[:, ::1] l_points
@@ -777,26 +1260,90 @@ cdef class AABBQuery(NeighborQuery):
     R"""Use an AABB tree to find neighbors.
 
     Also available as ``freud.AABBQuery``.
+
+    Args:
+        box (:class:`freud.box.Box`):
+            Simulation box.
+        points (:class:`np.ndarray`):
+            The points to build the tree from.
+        lbvh (bool, optional):
+            If True, the tree is built as a linear bounding volume hierarchy
+            by sorting the points along a Morton (Z-order) curve. This is
+            done in parallel and is much faster to build for large numbers of
+            points, although the resulting tree may be slightly slower to
+            query. The neighbors found are the same either way (Default
+            value = False).
+        spatial_sort (bool, optional):
+            If True, the points are stored reordered along a space-filling
+            curve (see :class:`~.SpatialSort` and
+            :attr:`NeighborQuery.spatial_sort`), so that computes visit them
+            in a cache-friendly order. The reordering is internal: points,
+            query results, and the per-point inputs and outputs of computes
+            remain in the original order of the points (Default value =
+            False).
     """
 
-    def __cinit__(self, box, points):
+    def __cinit__(self, box, points, lbvh=False, spatial_sort=False):
         cdef const float[:, ::1] l_points
         cdef freud.box.Box b
         if type(self) is AABBQuery:
             # Assume valid set of arguments is passed
             b = freud.util._convert_box(box)
-            self.points = freud.util._convert_array(
-                points, shape=(None, 3)).copy()
+            self._set_points(b, points, spatial_sort)
             l_points = self.points
             self.thisptr = self.nqptr = new freud._locality.AABBQuery(
                 dereference(b.thisptr),
                 <vec3[float]*> &l_points[0, 0],
-                self.points.shape[0])
+                self.points.shape[0], lbvh)
 
     def __dealloc__(self):
         if type(self) is AABBQuery:
             del self.thisptr
 
+    def update_points(self, points, rebuild_threshold=1.5):
+        R"""Update the positions of the points, e.g. for a new frame of a
+        trajectory.
+
+        Rather than building a new tree, the bounding boxes of the existing
+        tree are refit to the new positions, which is much faster when the
+        points have only moved slightly. If the points have moved so much that
+        the refit tree would be inefficient to query, a new tree is built
+        instead. The box and the number of points cannot change. If the
+        points were reordered along a space-filling curve when this object
+        was constructed, the new points are reordered in the same way.
+
+        Args:
+            points ((:math:`N_{points}`, 3) :class:`numpy.ndarray`):
+                The new point positions.
+            rebuild_threshold (float, optional):
+                A new tree is built if the total surface area of the refit
+                tree's bounding boxes exceeds this multiple of the surface
+                area of the tree when it was last built (Default value =
+                1.5).
+
+        Returns:
+            :class:`~.AABBQuery`: This object, with updated points.
+        """
+        points = freud.util._convert_array(points, shape=(None, 3)).copy()
+        if points.shape[0] != self.points.shape[0]:
+            raise ValueError('The number of points cannot change when '
+                             'updating an AABBQuery.')
+        if self._spatial_sort is not None:
+            self._original = _RawPoints(self.box, points)
+            points = self._spatial_sort.sort(points)
+        cdef const float[:, ::1] l_points = points
+        self.thisptr.updatePoints(
+            <vec3[float]*> &l_points[0, 0], l_points.shape[0],
+            rebuild_threshold)
+        self.points = points
+        return self
+
+    @property
+    def lbvh(self):
+        """bool: Whether the tree is built as a linear bounding volume
+        hierarchy."""
+        return self.thisptr.getLBVH()
+
 
 cdef class LinkCell(NeighborQuery):
     R"""Supports efficiently finding all points in a set within a certain
@@ -813,18 +1360,33 @@ cdef class LinkCell(NeighborQuery):
             Width of cells. If not provided, `~.LinkCell` will estimate a cell
             width based on the number of points and the box size assuming
             constant density of points throughout the box.
+        deterministic (bool, optional):
+            If True, the points in each cell are stored in order of their
+            indices, so that neighbors are always found in the same order.
+            If False, the order of points within a cell depends on the
+            scheduling of the parallel cell list construction, which is
+            slightly faster. The neighbors found are the same either way
+            (Default value = True).
+        spatial_sort (bool, optional):
+            If True, the points are stored reordered along a space-filling
+            curve (see :class:`~.SpatialSort` and
+            :attr:`NeighborQuery.spatial_sort`), so that computes visit them
+            in a cache-friendly order. The reordering is internal: points,
+            query results, and the per-point inputs and outputs of computes
+            remain in the original order of the points (Default value =
+            False).
     """
 
-    def __cinit__(self, box, points, cell_width=0):
+    def __cinit__(self, box, points, cell_width=0, deterministic=True,
+                  spatial_sort=False):
         cdef freud.box.Box b = freud.util._convert_box(box)
         cdef const float[:, ::1] l_points
-        self.points = freud.util._convert_array(
-            points, shape=(None, 3)).copy()
+        self._set_points(b, points, spatial_sort)
         l_points = self.points
         self.thisptr = self.nqptr = new freud._locality.LinkCell(
             dereference(b.thisptr),
             <vec3[float]*> &l_points[0, 0],
-            self.points.shape[0], cell_width)
+            self.points.shape[0], cell_width, deterministic)
 
     def __dealloc__(self):
         del self.thisptr
@@ -834,6 +1396,62 @@ cdef class LinkCell(NeighborQuery):
         """float: Cell width."""
         return self.thisptr.getCellWidth()
 
+    @property
+    def deterministic(self):
+        """bool: Whether points in each cell are stored in index order."""
+        return self.thisptr.getDeterministic()
+
+
+cdef class KDTree(NeighborQuery):
+    R"""Use a k-d tree to find neighbors.
+
+    Also available as ``freud.KDTree``.
+
+    The tree is balanced and stored implicitly as arrays, and is built in
+    parallel by recursively splitting the points at the median of the
+    fractional coordinate along which they are most spread out. Since the
+    tree adapts to the distribution of the points, it is well suited to
+    strongly inhomogeneous systems, such as interfaces, gels, and clusters,
+    and it supports triclinic periodic boxes.
+
+    Args:
+        box (:class:`freud.box.Box`):
+            Simulation box.
+        points (:class:`np.ndarray`):
+            The points to build the tree from.
+        spatial_sort (bool, optional):
+            If True, the points are stored reordered along a space-filling
+            curve (see :class:`~.SpatialSort` and
+            :attr:`NeighborQuery.spatial_sort`), so that computes visit them
+            in a cache-friendly order. The reordering is internal: points,
+            query results, and the per-point inputs and outputs of computes
+            remain in the original order of the points (Default value =
+            False).
+    """
+
+    def __cinit__(self, box, points, spatial_sort=False):
+        cdef freud.box.Box b = freud.util._convert_box(box)
+        cdef const float[:, ::1] l_points
+        self._set_points(b, points, spatial_sort)
+        l_points = self.points
+        self.thisptr = self.nqptr = new freud._locality.KDTree(
+            dereference(b.thisptr),
+            <vec3[float]*> &l_points[0, 0],
+            self.points.shape[0])
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def num_nodes(self):
+        """int: The number of nodes in the tree."""
+        return self.thisptr.getNumNodes()
+
+    @property
+    def depth(self):
+        """int: The depth of the leaves of the tree."""
+        return self.thisptr.getDepth()
+
 
 cdef class _PairCompute(_Compute):
     R"""Parent class for all compute classes in freud that depend on finding
@@ -844,10 +1462,18 @@ cdef class _PairCompute(_Compute):
     particular, this class contains a helper function that calls the necessary
     functions to create NeighborQuery and NeighborList classes as needed, as
     well as dealing with boxes and query arguments.
+
+    Computes that support spatially sorted points (see
+    :attr:`NeighborQuery.spatial_sort`) request them from
+    :meth:`_preprocess_arguments`, sort their per-point inputs with
+    :meth:`_sort_points` and :meth:`_sort_query_points`, and return their
+    per-point outputs to the original order with
+    :meth:`_unsort_query_points`.
     """
 
     def _preprocess_arguments(self, system, query_points=None,
-                              neighbors=None):
+                              neighbors=None, use_cache=True,
+                              spatial_sort=False):
         """Process standard compute arguments into freud's internal types by
         calling all the required internal functions.
 
@@ -868,6 +1494,20 @@ cdef class _PairCompute(_Compute):
             neighbors (:class:`freud.locality.NeighborList` or :class:`dict`, optional):
                 :class:`~.locality.NeighborList` or dictionary of query
                 arguments to use to find bonds (Default value = :code:`None`).
+            use_cache (bool, optional):
+                If True and a :class:`~.locality.NeighborListCache` is
+                active, query arguments are replaced by the cached
+                :class:`~.locality.NeighborList` of the query (Default value
+                = :code:`True`).
+            spatial_sort (bool, optional):
+                If True, the caller handles spatially sorted points: if the
+                system stores its points spatially sorted and neighbors are
+                found by a query, the returned
+                :class:`~.locality.NeighborQuery` and default query points are
+                in the sorted order. Otherwise, and whenever a
+                :class:`~.locality.NeighborList` is given (since its indices
+                refer to the original order), the points are used in their
+                original order (Default value = :code:`False`).
         """  # noqa E501
         cdef NeighborQuery nq = NeighborQuery.from_system(system)
 
@@ -878,6 +1518,12 @@ cdef class _PairCompute(_Compute):
 
         nlist, qargs = self._resolve_neighbors(neighbors, query_points)
 
+        if not spatial_sort or nlist.get_ptr() != NULL:
+            nq = nq._original_order()
+        self._point_sort = nq.spatial_sort
+        self._query_point_sort = nq.spatial_sort if query_points is None \
+            else None
+
         if query_points is None:
             query_points = nq.points
         else:
@@ -885,8 +1531,65 @@ cdef class _PairCompute(_Compute):
                 query_points, shape=(None, 3))
         cdef const float[:, ::1] l_query_points = query_points
         cdef unsigned int num_query_points = l_query_points.shape[0]
+
+        # Take the neighbors from the innermost active cache, if any.
+        cdef NeighborListCache cache
+        if (use_cache and nlist.get_ptr() == NULL and
+                _active_neighbor_list_caches):
+            cache = _active_neighbor_list_caches[-1]
+            nlist = cache._get(nq, l_query_points, qargs)
         return (nq, nlist, qargs, l_query_points, num_query_points)
 
+    def _preprocess_compressed_arguments(self, system, query_points=None):
+        """Process the compute arguments of computes that are given their
+        bonds as a :class:`~.CompressedNeighborList`.
+
+        Args:
+            system (:class:`freud.locality.NeighborQuery` or tuple):
+                If a tuple, must be of the form (box_like, array_like), i.e. it
+                must be an object that can be converted into a
+                :class:`freud.locality.NeighborQuery`.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points of the bonds. Uses :code:`points` if :code:`None`
+                (Default value = :code:`None`).
+
+        Returns:
+            tuple: The :class:`~.NeighborQuery` and the number of query
+            points, which the list is validated against.
+        """  # noqa E501
+        cdef NeighborQuery nq = \
+            NeighborQuery.from_system(system)._original_order()
+        self._point_sort = None
+        self._query_point_sort = None
+        if query_points is None:
+            query_points = nq.points
+        else:
+            query_points = freud.util._convert_array(
+                query_points, shape=(None, 3))
+        return nq, query_points.shape[0]
+
+    def _sort_points(self, values):
+        """Reorder per-point input values into the order of the points
+        returned by the last call of :meth:`_preprocess_arguments`."""
+        if self._point_sort is None:
+            return values
+        return self._point_sort.sort(values)
+
+    def _sort_query_points(self, values):
+        """Reorder per-query-point input values into the order of the query
+        points returned by the last call of :meth:`_preprocess_arguments`."""
+        if self._query_point_sort is None:
+            return values
+        return self._query_point_sort.sort(values)
+
+    def _unsort_query_points(self, values):
+        """Return per-query-point output values computed in the order of the
+        query points returned by the last call of
+        :meth:`_preprocess_arguments` to the original order."""
+        if self._query_point_sort is None:
+            return values
+        return self._query_point_sort.unsort(values)
+
     def _resolve_neighbors(self, neighbors, query_points=None):
         if type(neighbors) == NeighborList:
             nlist = neighbors
@@ -971,10 +1674,128 @@ cdef class _SpatialHistogram(_PairCompute):
         histogram"""
         return list(self.histptr.getAxisSizes())
 
+    @property
+    def accumulation_strategy(self):
+        """str: How the histogram is accumulated in parallel. With
+        :code:`'local_copies'`, each thread counts into its own copy of the
+        histogram, which takes memory proportional to the number of threads.
+        With :code:`'shared_atomic'`, all threads count into one histogram
+        with atomic increments. With :code:`'automatic'` (the default), the
+        shared histogram is used if the copies would exceed 256 MiB. The
+        strategy may be changed between accumulations. It applies to every
+        histogram of the compute, including the sums of products of
+        :class:`~freud.density.CorrelationFunction`."""
+        cdef freud._locality.AccumulationStrategy strategy = \
+            self.histptr.getAccumulationStrategy()
+        if strategy == freud._locality.AccumulationStrategy.local_copies:
+            return 'local_copies'
+        elif strategy == freud._locality.AccumulationStrategy.shared_atomic:
+            return 'shared_atomic'
+        else:
+            return 'automatic'
+
+    @accumulation_strategy.setter
+    def accumulation_strategy(self, value):
+        if value == 'automatic':
+            self.histptr.setAccumulationStrategy(
+                freud._locality.AccumulationStrategy.automatic)
+        elif value == 'local_copies':
+            self.histptr.setAccumulationStrategy(
+                freud._locality.AccumulationStrategy.local_copies)
+        elif value == 'shared_atomic':
+            self.histptr.setAccumulationStrategy(
+                freud._locality.AccumulationStrategy.shared_atomic)
+        else:
+            raise ValueError(
+                "Unknown accumulation strategy {}.".format(value))
+
     def _reset(self):
         # Resets the values of RDF in memory.
         self.histptr.reset()
 
+    cdef _preprocess_frames(self, systems, query_points, neighbors,
+                            vector[freud._locality.Frame] *frames):
+        R"""Process the arguments of a multi-frame accumulation.
+
+        Args:
+            systems (iterable):
+                The frames, each of which is any object that is a valid
+                argument to :class:`freud.locality.NeighborQuery.from_system`.
+            query_points (iterable):
+                Query points of each frame, or :code:`None` to use the points
+                of each frame. The query points must be given for all frames
+                or for none of them.
+            neighbors (dict):
+                Query arguments used to find the neighbors of every frame, or
+                :code:`None` to use :attr:`default_query_args`.
+            frames (:code:`vector[Frame] *`):
+                The frames are appended to this vector.
+
+        Returns:
+            tuple (list, :class:`~._QueryArgs`):
+                The objects holding the arrays that the frames point to, which
+                must be kept alive while the frames are used, and the query
+                arguments.
+        """
+        if not (neighbors is None or type(neighbors) == dict):
+            raise ValueError('The neighbors of a multi-frame accumulation '
+                             'must be given as a dict of query arguments.')
+
+        systems = list(systems)
+        if query_points is not None:
+            query_points = list(query_points)
+            if len(query_points) != len(systems):
+                raise ValueError('The number of arrays of query points must '
+                                 'match the number of frames.')
+            # The query arguments, including whether to exclude the bonds of
+            # points with themselves, are shared by all frames.
+            num_none = sum(qp is None for qp in query_points)
+            if num_none == len(query_points):
+                query_points = None
+            elif num_none > 0:
+                raise ValueError('The query points must be given for all '
+                                 'frames or for none of them.')
+        cdef NeighborList nlist
+        cdef _QueryArgs qargs
+        nlist, qargs = self._resolve_neighbors(neighbors, query_points)
+        if query_points is None:
+            query_points = [None] * len(systems)
+
+        cdef NeighborQuery nq
+        cdef freud.box.Box b
+        cdef const float[:, ::1] l_points
+        cdef const float[:, ::1] l_query_points
+        cdef freud._locality.Frame frame
+        arrays = []
+        for system, frame_query_points in zip(systems, query_points):
+            nq = NeighborQuery.from_system(system)._original_order()
+            b = nq.box
+            l_points = nq.points
+            if frame_query_points is None:
+                l_query_points = l_points
+            else:
+                frame_query_points = freud.util._convert_array(
+                    frame_query_points, shape=(None, 3))
+                l_query_points = frame_query_points
+            arrays.append((nq, frame_query_points))
+
+            frame.box = dereference(b.thisptr)
+            frame.points = <vec3[float]*> &l_points[0, 0]
+            frame.n_points = l_points.shape[0]
+            frame.query_points = <vec3[float]*> &l_query_points[0, 0]
+            frame.n_query_points = l_query_points.shape[0]
+            frames.push_back(frame)
+        return arrays, qargs
+
+    def _frame_data(self, data, name, num_frames):
+        R"""Return a list of per-frame arrays of a multi-frame accumulation,
+        checking that there is one array for every frame."""
+        data = list(data)
+        if len(data) != num_frames:
+            raise ValueError('The number of arrays of {} must match the '
+                             'number of frames.'.format(name))
+        return data
+
 
 cdef class _SpatialHistogram1D(_SpatialHistogram):
     R"""Subclasses _SpatialHistogram to provide a simplified API for
@@ -1048,7 +1869,7 @@ cdef class PeriodicBuffer(_Compute):
                 two images triples the box side lengths, and so on.
                 (Default value = :code:`False`).
         """
-        cdef NeighborQuery nq = _make_default_nq(system)
+        cdef NeighborQuery nq = _make_default_nq(system)._original_order()
         cdef vec3[float] buffer_vec
         if np.ndim(buffer) == 0:
             # catches more cases than np.isscalar
@@ -1118,7 +1939,8 @@ cdef class Voronoi(_Compute):
                 Any object that is a valid argument to
                 :class:`freud.locality.NeighborQuery.from_system`.
         """
-        cdef NeighborQuery nq = NeighborQuery.from_system(system)
+        cdef NeighborQuery nq = \
+            NeighborQuery.from_system(system)._original_order()
         self.thisptr.compute(nq.get_ptr())
         self._box = nq.box
         return self
@@ -1213,3 +2035,115 @@ cdef class Voronoi(_Compute):
             return freud.plot._ax_to_bytes(self.plot())
         except (AttributeError, ImportError):
             return None
+
+
+cdef class VerletList(_PairCompute):
+    R"""Reuses a ball query :class:`~.NeighborList` across the frames of a
+    trajectory.
+
+    Finding neighbors from scratch for every frame of a trajectory is wasteful
+    when points only move slightly between frames. This class finds all pairs
+    within a distance :code:`r_max + skin` (the candidate bonds) and stores
+    the positions of the points at that time. On subsequent calls to
+    :meth:`~.compute`, the candidate bonds are only found again if a point has
+    moved more than :code:`skin / 2` since then (for a set of points queried
+    against itself), if the box has changed, or if the query arguments have
+    changed. Otherwise, the distances of the candidate bonds are recomputed and
+    only the bonds within :code:`r_max` are kept.
+
+    Ball queries require :code:`r_max` to be less than half the box, so if
+    :code:`r_max + skin` does not fit in the box, a smaller skin is used (see
+    :attr:`~.effective_skin`) and candidate bonds are found more often.
+
+    The resulting :attr:`~.nlist` can be passed as the :code:`neighbors`
+    argument of any compute.
+
+    Args:
+        skin (float):
+            Extra distance beyond :code:`r_max` within which candidate bonds
+            are found. Larger values require finding candidate bonds less
+            often, at the cost of more candidate bonds to check each frame.
+    """
+
+    def __cinit__(self, float skin):
+        self.thisptr = new freud._locality.VerletList(skin)
+        self._nlist = NeighborList()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system, query_args, query_points=None):
+        R"""Find the bonds of a ball query, reusing the candidate bonds from
+        previous calls if possible.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            query_args (dict):
+                Query arguments of a ball query. The :code:`exclude_ii` query
+                argument defaults to :code:`True` if :code:`query_points` is
+                :code:`None` and :code:`False` otherwise.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points to find neighbors of. Uses the system's points if
+                :code:`None` (Default value = :code:`None`).
+        """  # noqa E501
+        if type(query_args) != dict:
+            raise ValueError('The query_args must be a dictionary of query '
+                             'arguments.')
+
+        cdef:
+            NeighborQuery nq
+            NeighborList nlist
+            _QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, query_points, query_args,
+                                       use_cache=False)
+
+        self.thisptr.compute(
+            nq.get_ptr(), <vec3[float]*> &l_query_points[0, 0],
+            num_query_points, dereference(qargs.thisptr))
+        return self
+
+    @property
+    def skin(self):
+        """float: Extra distance beyond :code:`r_max` within which candidate
+        bonds are found."""
+        return self.thisptr.getSkin()
+
+    @_Compute._computed_property
+    def effective_skin(self):
+        """float: Skin used for the current candidate bonds, which is smaller
+        than :attr:`~.skin` if :code:`r_max + skin` does not fit in the
+        box."""
+        return self.thisptr.getEffectiveSkin()
+
+    @property
+    def num_builds(self):
+        """unsigned int: Number of times the candidate bonds have been
+        found."""
+        return self.thisptr.getNumBuilds()
+
+    @_Compute._computed_property
+    def rebuilt(self):
+        """bool: Whether the last call to :meth:`~.compute` found new
+        candidate bonds."""
+        return self.thisptr.getRebuilt()
+
+    @_Compute._computed_property
+    def nlist(self):
+        """:class:`~.locality.NeighborList`: The bonds found by the last call
+        to :meth:`~.compute`. The same object is updated in place by
+        subsequent calls to :meth:`~.compute`."""
+        self._nlist = _nlist_from_cnlist(
+            self.thisptr.getNeighborList().get())
+        return self._nlist
+
+    def __repr__(self):
+        return "freud.locality.{cls}(skin={skin})".format(
+            cls=type(self).__name__, skin=self.skin)
+
+    def __str__(self):
+        return repr(self)
@@ -299,7 +299,8 @@ cdef class Hexatic(_PairCompute):
             unsigned int num_query_points
 
         nq, nlist, qargs, l_query_points, num_query_points = \
-            self._preprocess_arguments(system, neighbors=neighbors)
+            self._preprocess_arguments(system, neighbors=neighbors,
+                                       spatial_sort=True)
         self.thisptr.compute(nlist.get_ptr(),
                              nq.get_ptr(), dereference(qargs.thisptr))
         return self
@@ -314,9 +315,9 @@ cdef class Hexatic(_PairCompute):
     def particle_order(self):
         """:math:`\\left(N_{particles} \\right)` :class:`numpy.ndarray`: Order
         parameter."""
-        return freud.util.make_managed_numpy_array(
+        return self._unsort_query_points(freud.util.make_managed_numpy_array(
             &self.thisptr.getOrder(),
-            freud.util.arr_type_t.COMPLEX_FLOAT)
+            freud.util.arr_type_t.COMPLEX_FLOAT))
 
     @property
     def k(self):
@@ -369,7 +370,8 @@ cdef class Translational(_PairCompute):
             unsigned int num_query_points
 
         nq, nlist, qargs, l_query_points, num_query_points = \
-            self._preprocess_arguments(system, neighbors=neighbors)
+            self._preprocess_arguments(system, neighbors=neighbors,
+                                       spatial_sort=True)
 
         self.thisptr.compute(nlist.get_ptr(),
                              nq.get_ptr(), dereference(qargs.thisptr))
@@ -385,9 +387,9 @@ cdef class Translational(_PairCompute):
     def particle_order(self):
         """:math:`\\left(N_{particles} \\right)` :class:`numpy.ndarray`: Order
         parameter."""
-        return freud.util.make_managed_numpy_array(
+        return self._unsort_query_points(freud.util.make_managed_numpy_array(
             &self.thisptr.getOrder(),
-            freud.util.arr_type_t.COMPLEX_FLOAT)
+            freud.util.arr_type_t.COMPLEX_FLOAT))
 
     @property
     def k(self):
@@ -501,9 +503,9 @@ cdef class Steinhardt(_PairCompute):
         """:math:`\\left(N_{particles}\\right)` :class:`numpy.ndarray`: Variant
         of the Steinhardt order parameter for each particle (filled with
         :code:`nan` for particles with no neighbors)."""
-        return freud.util.make_managed_numpy_array(
+        return self._unsort_query_points(freud.util.make_managed_numpy_array(
             &self.thisptr.getParticleOrder(),
-            freud.util.arr_type_t.FLOAT)
+            freud.util.arr_type_t.FLOAT))
 
     @_Compute._computed_property
     def ql(self):
@@ -511,9 +513,9 @@ cdef class Steinhardt(_PairCompute):
         :math:`q_l` Steinhardt order parameter for each particle (filled with
         :code:`nan` for particles with no neighbors). This is always available,
         no matter which options are selected."""
-        return freud.util.make_managed_numpy_array(
+        return self._unsort_query_points(freud.util.make_managed_numpy_array(
             &self.thisptr.getQl(),
-            freud.util.arr_type_t.FLOAT)
+            freud.util.arr_type_t.FLOAT))
 
     def compute(self, system, neighbors=None):
         R"""Compute the order parameter.
@@ -537,7 +539,8 @@ cdef class Steinhardt(_PairCompute):
             unsigned int num_query_points
 
         nq, nlist, qargs, l_query_points, num_query_points = \
-            self._preprocess_arguments(system, neighbors=neighbors)
+            self._preprocess_arguments(system, neighbors=neighbors,
+                                       spatial_sort=True)
 
         self.thisptr.compute(nlist.get_ptr(),
                              nq.get_ptr(),
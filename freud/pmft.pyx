@@ -47,7 +47,9 @@ from freud.util cimport _Compute
 from freud.locality cimport _SpatialHistogram
 from freud.util cimport vec3, quat
 from cython.operator cimport dereference
+from libcpp.vector cimport vector
 
+cimport freud._locality
 cimport freud._pmft
 cimport freud.locality
 cimport freud.box
@@ -208,7 +210,7 @@ cdef class PMFTR12(_PMFT):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(
-                system, query_points, neighbors)
+                system, query_points, neighbors, spatial_sort=True)
 
         orientations = _gen_angle_array(
             orientations, shape=(nq.points.shape[0], ))
@@ -217,6 +219,8 @@ cdef class PMFTR12(_PMFT):
         else:
             query_orientations = _gen_angle_array(
                 query_orientations, shape=(l_query_points.shape[0], ))
+        orientations = self._sort_points(orientations)
+        query_orientations = self._sort_query_points(query_orientations)
         cdef const float[::1] l_orientations = orientations
         cdef const float[::1] l_query_orientations = query_orientations
 
@@ -228,6 +232,76 @@ cdef class PMFTR12(_PMFT):
                                    dereference(qargs.thisptr))
         return self
 
+    def compute_frames(self, systems, orientations, query_points=None,
+                       query_orientations=None, neighbors=None, reset=True):
+        R"""Calculates the PMFT of a sequence of frames.
+
+        This gives the same result as calling :meth:`compute` on each frame
+        with :code:`reset=False`, but finds the neighbors of the next frame
+        while the bonds of the current frame are binned. If a frame raises an
+        error, the frames before it remain accumulated.
+
+        Args:
+            systems (iterable):
+                The frames, each of which is any object that is a valid
+                argument to :class:`freud.locality.NeighborQuery.from_system`.
+                The neighbors of each frame are found with a data structure
+                selected for the frame.
+            orientations (iterable of (:math:`N_{points}`, 4) or (:math:`N_{points}`,) :class:`numpy.ndarray`):
+                Orientations of the points of each frame (see
+                :meth:`compute`).
+            query_points (iterable of (:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points of each frame. Uses the points of each frame if
+                :code:`None` (Default value = :code:`None`).
+            query_orientations (iterable of (:math:`N_{query\_points}`, 4) or (:math:`N_{query\_points}`,) :class:`numpy.ndarray`, optional):
+                Query orientations of each frame. Uses :code:`orientations` if
+                :code:`None` (Default value = :code:`None`).
+            neighbors (dict, optional):
+                `Query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used to find the neighbors of every frame (Default value:
+                None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        cdef vector[freud._locality.Frame] frames
+        cdef freud.locality._QueryArgs qargs
+        arrays, qargs = self._preprocess_frames(
+            systems, query_points, neighbors, &frames)
+
+        orientations = self._frame_data(
+            orientations, 'orientations', frames.size())
+        if query_orientations is None:
+            query_orientations = orientations
+        else:
+            query_orientations = self._frame_data(
+                query_orientations, 'query orientations', frames.size())
+        cdef vector[float*] c_orientations
+        cdef vector[float*] c_query_orientations
+        cdef const float[::1] l_orientations
+        cdef size_t i
+        for i in range(frames.size()):
+            frame_orientations = _gen_angle_array(
+                orientations[i], shape=(frames[i].n_points, ))
+            frame_query_orientations = _gen_angle_array(
+                query_orientations[i], shape=(frames[i].n_query_points, ))
+            arrays.append((frame_orientations, frame_query_orientations))
+            l_orientations = frame_orientations
+            c_orientations.push_back(<float*> &l_orientations[0])
+            l_orientations = frame_query_orientations
+            c_query_orientations.push_back(<float*> &l_orientations[0])
+
+        if reset:
+            self._reset()
+        if frames.size() > 0:
+            self._called_compute = True
+        self.pmftr12ptr.accumulateFrames(
+            frames, c_orientations, c_query_orientations,
+            dereference(qargs.thisptr))
+        return self
+
     def __repr__(self):
         bounds = self.bounds
         return ("freud.pmft.{cls}(r_max={r_max}, bins=({bins}))").format(
@@ -317,7 +391,7 @@ cdef class PMFTXYT(_PMFT):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(
-                system, query_points, neighbors)
+                system, query_points, neighbors, spatial_sort=True)
 
         orientations = _gen_angle_array(
             orientations, shape=(nq.points.shape[0], ))
@@ -326,6 +400,8 @@ cdef class PMFTXYT(_PMFT):
         else:
             query_orientations = _gen_angle_array(
                 query_orientations, shape=(l_query_points.shape[0], ))
+        orientations = self._sort_points(orientations)
+        query_orientations = self._sort_query_points(query_orientations)
         cdef const float[::1] l_orientations = orientations
         cdef const float[::1] l_query_orientations = query_orientations
 
@@ -337,6 +413,76 @@ cdef class PMFTXYT(_PMFT):
                                    dereference(qargs.thisptr))
         return self
 
+    def compute_frames(self, systems, orientations, query_points=None,
+                       query_orientations=None, neighbors=None, reset=True):
+        R"""Calculates the PMFT of a sequence of frames.
+
+        This gives the same result as calling :meth:`compute` on each frame
+        with :code:`reset=False`, but finds the neighbors of the next frame
+        while the bonds of the current frame are binned. If a frame raises an
+        error, the frames before it remain accumulated.
+
+        Args:
+            systems (iterable):
+                The frames, each of which is any object that is a valid
+                argument to :class:`freud.locality.NeighborQuery.from_system`.
+                The neighbors of each frame are found with a data structure
+                selected for the frame.
+            orientations (iterable of (:math:`N_{points}`, 4) or (:math:`N_{points}`,) :class:`numpy.ndarray`):
+                Orientations of the points of each frame (see
+                :meth:`compute`).
+            query_points (iterable of (:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points of each frame. Uses the points of each frame if
+                :code:`None` (Default value = :code:`None`).
+            query_orientations (iterable of (:math:`N_{query\_points}`, 4) or (:math:`N_{query\_points}`,) :class:`numpy.ndarray`, optional):
+                Query orientations of each frame. Uses :code:`orientations` if
+                :code:`None` (Default value = :code:`None`).
+            neighbors (dict, optional):
+                `Query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used to find the neighbors of every frame (Default value:
+                None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        cdef vector[freud._locality.Frame] frames
+        cdef freud.locality._QueryArgs qargs
+        arrays, qargs = self._preprocess_frames(
+            systems, query_points, neighbors, &frames)
+
+        orientations = self._frame_data(
+            orientations, 'orientations', frames.size())
+        if query_orientations is None:
+            query_orientations = orientations
+        else:
+            query_orientations = self._frame_data(
+                query_orientations, 'query orientations', frames.size())
+        cdef vector[float*] c_orientations
+        cdef vector[float*] c_query_orientations
+        cdef const float[::1] l_orientations
+        cdef size_t i
+        for i in range(frames.size()):
+            frame_orientations = _gen_angle_array(
+                orientations[i], shape=(frames[i].n_points, ))
+            frame_query_orientations = _gen_angle_array(
+                query_orientations[i], shape=(frames[i].n_query_points, ))
+            arrays.append((frame_orientations, frame_query_orientations))
+            l_orientations = frame_orientations
+            c_orientations.push_back(<float*> &l_orientations[0])
+            l_orientations = frame_query_orientations
+            c_query_orientations.push_back(<float*> &l_orientations[0])
+
+        if reset:
+            self._reset()
+        if frames.size() > 0:
+            self._called_compute = True
+        self.pmftxytptr.accumulateFrames(
+            frames, c_orientations, c_query_orientations,
+            dereference(qargs.thisptr))
+        return self
+
     def __repr__(self):
         bounds = self.bounds
         return ("freud.pmft.{cls}(x_max={x_max}, y_max={y_max}, "
@@ -435,10 +581,10 @@ cdef class PMFTXY(_PMFT):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(
-                system, query_points, neighbors)
+                system, query_points, neighbors, spatial_sort=True)
 
-        query_orientations = _gen_angle_array(
-            query_orientations, shape=(num_query_points, ))
+        query_orientations = self._sort_query_points(_gen_angle_array(
+            query_orientations, shape=(num_query_points, )))
         cdef const float[::1] l_query_orientations = query_orientations
 
         self.pmftxyptr.accumulate(nq.get_ptr(),
@@ -448,6 +594,61 @@ cdef class PMFTXY(_PMFT):
                                   dereference(qargs.thisptr))
         return self
 
+    def compute_frames(self, systems, query_orientations, query_points=None,
+                       neighbors=None, reset=True):
+        R"""Calculates the PMFT of a sequence of frames.
+
+        This gives the same result as calling :meth:`compute` on each frame
+        with :code:`reset=False`, but finds the neighbors of the next frame
+        while the bonds of the current frame are binned. If a frame raises an
+        error, the frames before it remain accumulated.
+
+        Args:
+            systems (iterable):
+                The frames, each of which is any object that is a valid
+                argument to :class:`freud.locality.NeighborQuery.from_system`.
+                The neighbors of each frame are found with a data structure
+                selected for the frame.
+            query_orientations (iterable of (:math:`N_{query\_points}`, 4) or (:math:`N_{query\_points}`,) :class:`numpy.ndarray`):
+                Query orientations of each frame (see :meth:`compute`).
+            query_points (iterable of (:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points of each frame. Uses the points of each frame if
+                :code:`None` (Default value = :code:`None`).
+            neighbors (dict, optional):
+                `Query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used to find the neighbors of every frame (Default value:
+                None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        cdef vector[freud._locality.Frame] frames
+        cdef freud.locality._QueryArgs qargs
+        arrays, qargs = self._preprocess_frames(
+            systems, query_points, neighbors, &frames)
+
+        query_orientations = self._frame_data(
+            query_orientations, 'query orientations', frames.size())
+        cdef vector[float*] c_query_orientations
+        cdef const float[::1] l_query_orientations
+        cdef size_t i
+        for i in range(frames.size()):
+            query_orientations[i] = _gen_angle_array(
+                query_orientations[i], shape=(frames[i].n_query_points, ))
+            l_query_orientations = query_orientations[i]
+            c_query_orientations.push_back(
+                <float*> &l_query_orientations[0])
+
+        if reset:
+            self._reset()
+        if frames.size() > 0:
+            self._called_compute = True
+        self.pmftxyptr.accumulateFrames(frames, c_query_orientations,
+                                        dereference(qargs.thisptr))
+        return self
+
     @_Compute._computed_property
     def bin_counts(self):
         """:class:`numpy.ndarray`: The bin counts in the histogram."""
@@ -602,11 +803,11 @@ cdef class PMFTXYZ(_PMFT):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(
-                system, query_points, neighbors)
+                system, query_points, neighbors, spatial_sort=True)
         l_query_points = l_query_points - self.shiftvec.reshape(1, 3)
 
-        query_orientations = freud.util._convert_array(
-            np.atleast_1d(query_orientations), shape=(num_query_points, 4))
+        query_orientations = self._sort_query_points(freud.util._convert_array(
+            np.atleast_1d(query_orientations), shape=(num_query_points, 4)))
 
         cdef const float[:, ::1] l_query_orientations = query_orientations
 
@@ -629,6 +830,90 @@ cdef class PMFTXYZ(_PMFT):
             dereference(qargs.thisptr))
         return self
 
+    def compute_frames(self, systems, query_orientations, query_points=None,
+                       equiv_orientations=None, neighbors=None, reset=True):
+        R"""Calculates the PMFT of a sequence of frames.
+
+        This gives the same result as calling :meth:`compute` on each frame
+        with :code:`reset=False`, but finds the neighbors of the next frame
+        while the bonds of the current frame are binned. If a frame raises an
+        error, the frames before it remain accumulated.
+
+        Args:
+            systems (iterable):
+                The frames, each of which is any object that is a valid
+                argument to :class:`freud.locality.NeighborQuery.from_system`.
+                The neighbors of each frame are found with a data structure
+                selected for the frame.
+            query_orientations (iterable of (:math:`N_{query\_points}`, 4) :class:`numpy.ndarray`):
+                Query orientations of each frame (see :meth:`compute`).
+            query_points (iterable of (:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points of each frame. Uses the points of each frame if
+                :code:`None` (Default value = :code:`None`).
+            equiv_orientations ((:math:`N_{faces}`, 4) :class:`numpy.ndarray`, optional):
+                Orientations to be treated as equivalent in every frame (see
+                :meth:`compute`) (Default value = :code:`None`).
+            neighbors (dict, optional):
+                `Query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used to find the neighbors of every frame (Default value:
+                None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa: E501
+        cdef vector[freud._locality.Frame] frames
+        cdef freud.locality._QueryArgs qargs
+        arrays, qargs = self._preprocess_frames(
+            systems, query_points, neighbors, &frames)
+
+        query_orientations = self._frame_data(
+            query_orientations, 'query orientations', frames.size())
+        cdef vector[quat[float]*] c_query_orientations
+        cdef const float[:, ::1] l_query_orientations
+        cdef const float[:, ::1] l_query_points
+        cdef freud.locality.NeighborQuery nq
+        cdef size_t i
+        for i in range(frames.size()):
+            # As in compute, the bonds are measured from the shifted query
+            # points, which must outlive the accumulation.
+            nq, frame_query_points = arrays[i]
+            if frame_query_points is None:
+                frame_query_points = nq.points
+            frame_query_points = np.ascontiguousarray(
+                np.asarray(frame_query_points) - self.shiftvec.reshape(1, 3),
+                dtype=np.float32)
+            query_orientations[i] = freud.util._convert_array(
+                np.atleast_1d(query_orientations[i]),
+                shape=(frames[i].n_query_points, 4))
+            arrays[i] = (nq, frame_query_points)
+            l_query_points = frame_query_points
+            frames[i].query_points = <vec3[float]*> &l_query_points[0, 0]
+            l_query_orientations = query_orientations[i]
+            c_query_orientations.push_back(
+                <quat[float]*> &l_query_orientations[0, 0])
+
+        if equiv_orientations is None:
+            equiv_orientations = np.array([[1, 0, 0, 0]], dtype=np.float32)
+        else:
+            equiv_orientations = freud.util._convert_array(
+                equiv_orientations, shape=(None, 4))
+
+        cdef const float[:, ::1] l_equiv_orientations = equiv_orientations
+        cdef unsigned int num_equiv_orientations = \
+            l_equiv_orientations.shape[0]
+
+        if reset:
+            self._reset()
+        if frames.size() > 0:
+            self._called_compute = True
+        self.pmftxyzptr.accumulateFrames(
+            frames, c_query_orientations,
+            <quat[float]*> &l_equiv_orientations[0, 0],
+            num_equiv_orientations, dereference(qargs.thisptr))
+        return self
+
     def __repr__(self):
         bounds = self.bounds
         return ("freud.pmft.{cls}(x_max={x_max}, y_max={y_max}, "
@@ -72,6 +72,7 @@ thread_str = "--NTHREAD"
 tbb_root_str = "--TBB-ROOT"
 tbb_include_str = "--TBB-INCLUDE"
 tbb_link_str = "--TBB-LINK"
+simd_str = "--SIMD"
 
 parser = argparse.ArgumentParser(
     description="These are the additional arguments provided by freud "
@@ -156,6 +157,19 @@ parser.add_argument(
          "typically be `$TBB_ROOT/lib`, but this option exists for cases "
          "where that is not true."
 )
+parser.add_argument(
+    simd_str,
+    dest="simd",
+    choices=["none", "avx2", "avx512", "native"],
+    default="none",
+    help="The SIMD instruction set to compile the vectorized kernels for. "
+         "By default, only the portable scalar code paths are compiled. "
+         "`avx2` and `avx512` enable the AVX2 and AVX-512 kernels (e.g. for "
+         "AABBQuery ball queries and RDF binning), and `native` compiles for "
+         "the instruction sets of the building machine. The resulting "
+         "modules only run on processors that support the chosen "
+         "instructions."
+)
 
 # Parse known args then rewrite sys.argv for setuptools.setup to use
 args, extras = parser.parse_known_args()
@@ -342,6 +356,14 @@ library_dirs = [tbb_link] if tbb_link else []
 
 compile_args = link_args = ["-std=c++11"]
 
+simd_args = dict(
+    none=[],
+    avx2=["-mavx2"],
+    avx512=["-mavx512f"],
+    native=["-march=native"],
+)
+compile_args = compile_args + simd_args[args.simd]
+
 ext_args = dict(
     language="c++",
     extra_compile_args=compile_args,
@@ -368,7 +390,11 @@ sources_in_all = [
     os.path.join("cpp", "locality", "NeighborPerPointIterator.cc"),
     os.path.join("cpp", "locality", "NeighborQuery.cc"),
     os.path.join("cpp", "locality", "AABBQuery.cc"),
+    os.path.join("cpp", "locality", "KDTree.cc"),
+    os.path.join("cpp", "locality", "LinkCell.cc"),
+    os.path.join("cpp", "locality", "RawPoints.cc"),
     os.path.join("cpp", "locality", "NeighborList.cc"),
+    os.path.join("cpp", "locality", "CompressedNeighborList.cc"),
     os.path.join("cpp", "locality", "NeighborComputeFunctional.cc"),
 ]
 
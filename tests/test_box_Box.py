@@ -112,6 +112,47 @@ class TestBox(unittest.TestCase):
         testpoints = np.array(testpoints)
         npt.assert_allclose(box.wrap(testpoints)[0, 0], -2, rtol=1e-6)
 
+    def test_wrap_policies(self):
+        # Boxes without tilt factors are wrapped with specialized arithmetic,
+        # which must give the same vectors as the fractional coordinates
+        # used for any box.
+        boxes = [freud.box.Box(7.3, 4.1, 9.7),
+                 freud.box.Box(7.3, 4.1, is2D=True),
+                 freud.box.Box(7.3, 4.1, 9.7, 0.3, -0.2, 0.5),
+                 freud.box.Box(7.3, 4.1, 0, 0.4, is2D=True)]
+        np.random.seed(0)
+        for box in boxes:
+            L = box.L if not box.is2D else np.array([box.Lx, box.Ly, 1])
+            images = np.arange(-3, 4)[:, np.newaxis]
+            vecs = np.concatenate([
+                # Random vectors spanning several images in each direction.
+                np.random.uniform(-5, 5, (10000, 3))*L,
+                # Vectors on the faces of the box and its images.
+                (images + 0.5)*L, (images - 0.5)*L, images*L]).astype(
+                    np.float32)
+
+            fractional = box.make_fractional(vecs)
+            expected = box.make_absolute(fractional - np.floor(fractional))
+            wrapped = box.wrap(vecs)
+            npt.assert_allclose(wrapped, expected, rtol=0, atol=1e-5)
+            for i in np.random.randint(len(vecs), size=100):
+                npt.assert_allclose(box.wrap(vecs[i]), wrapped[i],
+                                    rtol=0, atol=1e-5)
+            if box.is2D:
+                npt.assert_array_equal(wrapped[:, 2], 0)
+
+            # The bond vectors of neighbor lists are wrapped in the same way.
+            points = box.wrap(np.random.uniform(-0.5, 0.5, (500, 3))*L)
+            for nq in [freud.locality.AABBQuery(box, points),
+                       freud.locality.LinkCell(box, points, 1.5)]:
+                nlist = nq.query(points, dict(r_max=1.5)).toNeighborList(
+                    vectors=True)
+                npt.assert_allclose(
+                    nlist.vectors,
+                    box.wrap(points[nlist.point_indices] -
+                             points[nlist.query_point_indices]),
+                    rtol=0, atol=1e-5)
+
     def test_unwrap(self):
         box = freud.box.Box(2, 2, 2, 1, 0, 0)
 
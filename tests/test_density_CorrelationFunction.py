@@ -203,6 +203,73 @@ class TestCorrelationFunction(unittest.TestCase):
         npt.assert_allclose(f1, f2)
         npt.assert_array_equal(c1, c2)
 
+    def test_compute_frames(self):
+        bins, r_max = (20, 3.0)
+        N = 500
+        frames = [freud.data.make_random_system(10 + i, N, seed=i)
+                  for i in range(3)]
+        _, query_points = freud.data.make_random_system(10, N//2, seed=3)
+        np.random.seed(0)
+        values = [np.exp(1j*np.random.rand(N)*2*np.pi) for _ in frames]
+        query_values = [np.exp(1j*np.random.rand(N//2)*2*np.pi)
+                        for _ in frames]
+
+        for vals, qvals in [(values, None), (np.real(values), None)]:
+            cf = freud.density.CorrelationFunction(bins, r_max)
+            for system, frame_values in zip(frames, vals):
+                cf.compute(system, frame_values, reset=False)
+            cf_frames = freud.density.CorrelationFunction(
+                bins, r_max).compute_frames(frames, vals)
+            npt.assert_array_equal(cf_frames.bin_counts, cf.bin_counts)
+            npt.assert_allclose(cf_frames.correlation, cf.correlation,
+                                rtol=1e-5, atol=1e-7)
+            self.assertEqual(np.iscomplexobj(cf_frames.correlation),
+                             np.iscomplexobj(cf.correlation))
+
+        cf = freud.density.CorrelationFunction(bins, r_max)
+        for i, system in enumerate(frames):
+            cf.compute(system, values[i], query_points, query_values[i],
+                       reset=False)
+        cf_frames = freud.density.CorrelationFunction(
+            bins, r_max).compute_frames(
+                frames, values, [query_points]*len(frames), query_values)
+        npt.assert_array_equal(cf_frames.bin_counts, cf.bin_counts)
+        npt.assert_allclose(cf_frames.correlation, cf.correlation,
+                            rtol=1e-5, atol=1e-7)
+
+        with self.assertRaises(ValueError):
+            cf_frames.compute_frames(frames, values[:1])
+
+    def test_accumulation_strategy(self):
+        bins, r_max = (20, 3.0)
+        N = 1000
+        box, points = freud.data.make_random_system(10, N, seed=0)
+        np.random.seed(0)
+        angles = np.random.rand(N)*2*np.pi
+
+        # The sums of products of both real and complex values are
+        # accumulated in the shared histogram.
+        for values in [np.cos(angles), np.exp(1j*angles)]:
+            expected = freud.density.CorrelationFunction(bins, r_max)
+            expected.accumulation_strategy = 'local_copies'
+            expected.compute((box, points), values)
+
+            cf = freud.density.CorrelationFunction(bins, r_max)
+            cf.accumulation_strategy = 'shared_atomic'
+            cf.compute((box, points), values)
+            npt.assert_array_equal(cf.bin_counts, expected.bin_counts)
+            npt.assert_allclose(cf.correlation, expected.correlation,
+                                rtol=1e-6, atol=1e-9)
+
+            # Sums accumulated with either strategy are combined.
+            cf.accumulation_strategy = 'local_copies'
+            cf.compute((box, points), values, reset=False)
+            cf.accumulation_strategy = 'shared_atomic'
+            cf.compute((box, points), values, reset=False)
+            npt.assert_array_equal(cf.bin_counts, 3*expected.bin_counts)
+            npt.assert_allclose(cf.correlation, expected.correlation,
+                                rtol=1e-6, atol=1e-9)
+
     def test_repr(self):
         cf = freud.density.CorrelationFunction(1000, 40)
         self.assertEqual(str(cf), str(eval(repr(cf))))
@@ -97,6 +97,167 @@ class TestRDF(unittest.TestCase):
                 npt.assert_allclose(rdf.n_r, np.cumsum(avg_counts),
                                     rtol=tolerance)
 
+    def test_accumulate_polling(self):
+        r_max = 3.0
+        bins = 30
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        rdf = freud.density.RDF(bins, r_max)
+
+        # Arrays read between accumulations keep their values, while the
+        # counts keep accumulating.
+        rdf.compute((box, points), reset=False)
+        bin_counts = rdf.bin_counts
+        single_rdf = np.copy(rdf.rdf)
+        first_bin_counts = np.copy(bin_counts)
+        for num_frames in range(2, 5):
+            rdf.compute((box, points), reset=False)
+            npt.assert_array_equal(rdf.bin_counts,
+                                   num_frames*first_bin_counts)
+            npt.assert_allclose(rdf.rdf, single_rdf, rtol=1e-5)
+        npt.assert_array_equal(bin_counts, first_bin_counts)
+
+        rdf.compute((box, points))
+        npt.assert_array_equal(rdf.bin_counts, first_bin_counts)
+
+    def test_batch_binning(self):
+        # The distances of blocks of bonds are binned together and counted in
+        # interleaved sub-histograms, which must give the same counts as
+        # binning each distance on its own.
+        bins, r_max, r_min = (5, 1.0, 0.1)
+        r_min_32, r_max_32 = np.float32(r_min), np.float32(r_max)
+        dr_inv = np.float32(1) / ((r_max_32 - r_min_32) / np.float32(bins))
+        below_r_max = np.nextafter(r_max_32, np.float32(0))
+        # The largest distance below r_max rounds to the end of the range,
+        # so it must be clamped to the last bin.
+        self.assertGreaterEqual(int((below_r_max - r_min_32)*dr_inv), bins)
+
+        # NaN and infinite distances are out of range like in bin, also in
+        # builds with the AVX2 kernel (see the --SIMD option of setup.py).
+        edge_distances = np.array(
+            [r_min, np.nextafter(r_min_32, np.float32(0)), below_r_max,
+             r_max, -r_min, -0.5, 0, 0.5, 2*r_max, 0.3, np.nan, np.inf,
+             -np.inf], dtype=np.float32)
+        np.random.seed(0)
+        distances = np.concatenate([
+            np.tile(edge_distances, 50),
+            # Long runs of bonds in the same bin.
+            np.full(1000, 0.5, dtype=np.float32),
+            np.full(999, below_r_max, dtype=np.float32),
+            np.random.uniform(-0.5, 1.5, 5000).astype(np.float32)])
+        num_points = 100
+        query_point_indices = np.sort(
+            np.random.randint(num_points, size=len(distances)))
+        point_indices = np.random.randint(num_points, size=len(distances))
+        nlist = freud.locality.NeighborList.from_arrays(
+            num_points, num_points, query_point_indices, point_indices,
+            distances)
+
+        with np.errstate(invalid='ignore'):
+            in_range = (distances >= r_min_32) & (distances < r_max_32)
+        expected_bins = np.minimum(
+            ((distances[in_range] - r_min_32)*dr_inv).astype(np.int64),
+            bins - 1)
+        expected = np.bincount(expected_bins, minlength=bins)
+        self.assertGreaterEqual(expected[-1], 50 + 999)
+
+        box, points = freud.data.make_random_system(10, num_points, seed=1)
+        rdf = freud.density.RDF(bins, r_max, r_min)
+        for num_frames in range(1, 4):
+            rdf.compute((box, points), neighbors=nlist, reset=False)
+            npt.assert_array_equal(rdf.bin_counts, num_frames*expected)
+        rdf.compute((box, points), neighbors=nlist)
+        npt.assert_array_equal(rdf.bin_counts, expected)
+
+    def test_compute_frames(self):
+        bins, r_max = (30, 3.0)
+        frames = [freud.data.make_random_system(10 + i, 500, seed=i)
+                  for i in range(4)]
+        _, query_points = freud.data.make_random_system(10, 100, seed=10)
+
+        def compare(rdf, expected):
+            npt.assert_array_equal(rdf.bin_counts, expected.bin_counts)
+            npt.assert_allclose(rdf.rdf, expected.rdf, rtol=1e-6)
+            npt.assert_allclose(rdf.n_r, expected.n_r, rtol=1e-6)
+
+        for qp in [None, query_points]:
+            frame_query_points = None if qp is None else [qp]*len(frames)
+            for neighbors in [None, dict(num_neighbors=6)]:
+                rdf = freud.density.RDF(bins, r_max)
+                for system in frames:
+                    rdf.compute(system, qp, neighbors, reset=False)
+                compare(freud.density.RDF(bins, r_max).compute_frames(
+                    frames, frame_query_points, neighbors), rdf)
+
+                # A single frame.
+                compare(freud.density.RDF(bins, r_max).compute_frames(
+                    frames[:1], frame_query_points, neighbors),
+                    freud.density.RDF(bins, r_max).compute(
+                        frames[0], qp, neighbors))
+
+        # Frames are added to the previous frames unless reset.
+        rdf = freud.density.RDF(bins, r_max).compute(frames[0])
+        rdf.compute_frames(frames[1:], reset=False)
+        compare(rdf, freud.density.RDF(bins, r_max).compute_frames(frames))
+        # An empty sequence of frames accumulates nothing.
+        rdf.compute_frames([], reset=False)
+        compare(rdf, freud.density.RDF(bins, r_max).compute_frames(frames))
+        with self.assertRaises(AttributeError):
+            freud.density.RDF(bins, r_max).compute_frames([]).bin_counts
+
+        with self.assertRaises(ValueError):
+            rdf.compute_frames(frames, [query_points])
+        nlist = freud.locality.AABBQuery(*frames[0]).query(
+            frames[0][1], dict(r_max=r_max)).toNeighborList()
+        with self.assertRaises(ValueError):
+            rdf.compute_frames(frames[:1], neighbors=nlist)
+        # The query points must be given for all frames or for none.
+        with self.assertRaises(ValueError):
+            rdf.compute_frames(frames[:2], [None, query_points])
+
+    def test_compute_frames_error(self):
+        bins, r_max = (30, 3.0)
+        frames = [freud.data.make_random_system(10, 500, seed=i)
+                  for i in range(4)]
+        # Finding the neighbors of frame k + 1 fails because its box is too
+        # small for r_max, which must leave frames 0..k accumulated.
+        k = 2
+        bad_frames = frames[:k + 1] + [
+            freud.data.make_random_system(2*r_max - 1, 50, seed=k + 1)]
+        rdf = freud.density.RDF(bins, r_max)
+        with self.assertRaises(RuntimeError):
+            rdf.compute_frames(bad_frames + frames[k + 1:])
+
+        expected = freud.density.RDF(bins, r_max)
+        for system in frames[:k + 1]:
+            expected.compute(system, reset=False)
+        npt.assert_array_equal(rdf.bin_counts, expected.bin_counts)
+
+    def test_accumulation_strategy(self):
+        bins, r_max = (40, 3.0)
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        _, query_points = freud.data.make_random_system(10, 200, seed=1)
+        nlist = freud.locality.AABBQuery(box, points).query(
+            query_points, dict(r_max=r_max)).toNeighborList()
+
+        # Both the symmetric half query of the points with themselves and
+        # the other query points are counted in the shared histogram.
+        for qp, neighbors in [(None, None), (query_points, None),
+                              (query_points, nlist)]:
+            expected = freud.density.RDF(bins, r_max)
+            expected.accumulation_strategy = 'local_copies'
+            expected.compute((box, points), qp, neighbors)
+            self.assertGreater(np.sum(expected.bin_counts), 0)
+
+            rdf = freud.density.RDF(bins, r_max)
+            rdf.accumulation_strategy = 'shared_atomic'
+            rdf.compute((box, points), qp, neighbors)
+            npt.assert_array_equal(rdf.bin_counts, expected.bin_counts)
+            npt.assert_allclose(rdf.rdf, expected.rdf, rtol=1e-6)
+
+            rdf.accumulation_strategy = 'local_copies'
+            rdf.compute((box, points), qp, neighbors, reset=False)
+            npt.assert_array_equal(rdf.bin_counts, 2*expected.bin_counts)
+
     def test_repr(self):
         rdf = freud.density.RDF(r_max=10, bins=100, r_min=0.5)
         self.assertEqual(str(rdf), str(eval(repr(rdf))))
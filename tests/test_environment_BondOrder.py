@@ -1,4 +1,5 @@
 import numpy as np
+import numpy.testing as npt
 import freud
 import rowan
 import unittest
@@ -94,6 +95,38 @@ class TestBondOrder(unittest.TestCase):
             bo.compute(nq, random_quats, neighbors=neighbors)
             self.assertGreater(np.sum(bo.bond_order > 0), 30)
 
+    def test_compute_frames(self):
+        L, N = (10, 200)
+        frames = [freud.data.make_random_system(L + i, N, seed=i)
+                  for i in range(3)]
+        _, query_points = freud.data.make_random_system(L, N//2, seed=3)
+        orientations = [rowan.random.rand(N) for _ in frames]
+        query_orientations = [rowan.random.rand(N//2) for _ in frames]
+        neighbors = dict(num_neighbors=6)
+
+        for mode in ['bod', 'lbod', 'obcd', 'oocd']:
+            for ors, qp, qo in [(None, None, None),
+                                (orientations, None, None),
+                                (orientations, query_points,
+                                 query_orientations)]:
+                frame_query_points = None if qp is None else \
+                    [qp]*len(frames)
+                bo = freud.environment.BondOrder((10, 12), mode)
+                for i, system in enumerate(frames):
+                    bo.compute(system, None if ors is None else ors[i], qp,
+                               None if qo is None else qo[i], neighbors,
+                               reset=False)
+                bo_frames = freud.environment.BondOrder(
+                    (10, 12), mode).compute_frames(
+                        frames, ors, frame_query_points, qo, neighbors)
+                npt.assert_array_equal(bo_frames.bin_counts, bo.bin_counts)
+                npt.assert_allclose(bo_frames.bond_order, bo.bond_order,
+                                    rtol=1e-6)
+
+        with self.assertRaises(ValueError):
+            bo_frames.compute_frames(frames, orientations[:1],
+                                     neighbors=neighbors)
+
     def test_repr(self):
         bo = freud.environment.BondOrder((6, 6))
         self.assertEqual(str(bo), str(eval(repr(bo))))
@@ -0,0 +1,134 @@
+import numpy as np
+import numpy.testing as npt
+import freud
+import unittest
+
+
+class TestCompressedNeighborList(unittest.TestCase):
+    def assert_nlist_equal(self, nlist1, nlist2):
+        npt.assert_array_equal(nlist1[:], nlist2[:])
+        npt.assert_array_equal(nlist1.distances, nlist2.distances)
+        npt.assert_array_equal(nlist1.weights, nlist2.weights)
+        self.assertEqual(nlist1.num_query_points, nlist2.num_query_points)
+        self.assertEqual(nlist1.num_points, nlist2.num_points)
+
+    def test_from_neighbor_list(self):
+        L, N, r_max = (10, 1000, 1.5)
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        aq = freud.locality.AABBQuery(box, points)
+        nlist = aq.query(
+            points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+
+        for delta_encode in [True, False]:
+            cnlist = freud.locality.CompressedNeighborList.from_neighbor_list(
+                nlist, delta_encode)
+            self.assertEqual(cnlist.delta_encoded, delta_encode)
+            self.assertEqual(cnlist.num_bonds, len(nlist))
+            self.assertEqual(len(cnlist), len(nlist))
+            self.assertEqual(cnlist.num_query_points, N)
+            self.assertEqual(cnlist.num_points, N)
+            self.assertFalse(cnlist.has_weights)
+            self.assert_nlist_equal(cnlist.to_neighbor_list(), nlist)
+
+    def test_from_query(self):
+        L, N, r_max = (10, 1000, 1.5)
+        box, points = freud.data.make_random_system(L, N, seed=1)
+        _, query_points = freud.data.make_random_system(L, N // 3, seed=2)
+        aq = freud.locality.AABBQuery(box, points)
+
+        for delta_encode in [True, False]:
+            cnlist = freud.locality.CompressedNeighborList.from_query(
+                aq, dict(r_max=r_max), delta_encode=delta_encode)
+            self.assert_nlist_equal(cnlist.to_neighbor_list(), aq.query(
+                points, dict(r_max=r_max, exclude_ii=True)).toNeighborList())
+
+            cnlist = freud.locality.CompressedNeighborList.from_query(
+                aq, dict(num_neighbors=6), query_points, delta_encode)
+            self.assertEqual(cnlist.num_query_points, N // 3)
+            self.assertEqual(cnlist.num_bonds, 6*(N // 3))
+            self.assert_nlist_equal(cnlist.to_neighbor_list(), aq.query(
+                query_points, dict(num_neighbors=6)).toNeighborList())
+
+    def test_delta_encoding_memory(self):
+        L, N, r_max = (10, 1000, 1.5)
+        box, points = freud.data.make_random_system(L, N, seed=3)
+        cnlists = [freud.locality.CompressedNeighborList.from_query(
+            (box, points), dict(r_max=r_max), delta_encode=delta_encode)
+            for delta_encode in [True, False]]
+        self.assertLess(cnlists[0].memory_usage, cnlists[1].memory_usage)
+
+    def test_weights(self):
+        query_point_indices = np.array([0, 0, 1, 2, 2, 2])
+        point_indices = np.array([1, 2, 0, 0, 1, 3])
+        distances = np.array([1, 2, 1, 2, 1.5, 0.5])
+        weights = np.array([1, 0.5, 2, 1, 3, 1])
+        nlist = freud.locality.NeighborList.from_arrays(
+            4, 4, query_point_indices, point_indices, distances, weights)
+
+        for delta_encode in [True, False]:
+            cnlist = freud.locality.CompressedNeighborList.from_neighbor_list(
+                nlist, delta_encode)
+            self.assertTrue(cnlist.has_weights)
+            self.assert_nlist_equal(cnlist.to_neighbor_list(), nlist)
+
+    def test_unsorted_point_indices(self):
+        # Point indices that decrease within the bonds of a query point are
+        # stored as negative deltas, and the order of the bonds is kept.
+        query_point_indices = np.array([0, 0, 0, 0, 2, 2, 3])
+        point_indices = np.array([5, 2, 1000000, 0, 7, 3, 4000000000])
+        distances = np.arange(len(point_indices), dtype=np.float32)
+        nlist = freud.locality.NeighborList.from_arrays(
+            4, 4000000001, query_point_indices, point_indices, distances)
+
+        for delta_encode in [True, False]:
+            cnlist = freud.locality.CompressedNeighborList.from_neighbor_list(
+                nlist, delta_encode)
+            self.assert_nlist_equal(cnlist.to_neighbor_list(), nlist)
+
+    def test_computes(self):
+        L, N, r_max = (10, 2000, 2.0)
+        box, points = freud.data.make_random_system(L, N, seed=4)
+        _, query_points = freud.data.make_random_system(L, N // 4, seed=5)
+        aq = freud.locality.AABBQuery(box, points)
+
+        for qp in [None, query_points]:
+            nlist = aq.query(points if qp is None else qp, dict(
+                r_max=r_max, exclude_ii=qp is None)).toNeighborList()
+            for delta_encode in [True, False]:
+                cnlist = \
+                    freud.locality.CompressedNeighborList.from_neighbor_list(
+                        nlist, delta_encode)
+
+                # The RDF loops over blocks of the bonds.
+                rdf = freud.density.RDF(50, r_max).compute(
+                    aq, qp, neighbors=nlist)
+                compressed_rdf = freud.density.RDF(50, r_max).compute(
+                    aq, qp, neighbors=cnlist)
+                npt.assert_array_equal(compressed_rdf.bin_counts,
+                                       rdf.bin_counts)
+                npt.assert_allclose(compressed_rdf.rdf, rdf.rdf, rtol=1e-6)
+
+                # The local density loops over the bonds of each point.
+                ld = freud.density.LocalDensity(r_max, 1).compute(
+                    aq, qp, neighbors=nlist)
+                compressed_ld = freud.density.LocalDensity(r_max, 1).compute(
+                    aq, qp, neighbors=cnlist)
+                npt.assert_array_equal(compressed_ld.num_neighbors,
+                                       ld.num_neighbors)
+                npt.assert_array_equal(compressed_ld.density, ld.density)
+
+    def test_invalid_sizes(self):
+        L, N, r_max = (10, 100, 1.5)
+        box, points = freud.data.make_random_system(L, N, seed=6)
+        cnlist = freud.locality.CompressedNeighborList.from_query(
+            (box, points), dict(r_max=r_max))
+        with self.assertRaises(RuntimeError):
+            freud.density.RDF(10, r_max).compute(
+                (box, points[:N // 2]), neighbors=cnlist)
+        with self.assertRaises(RuntimeError):
+            freud.density.LocalDensity(r_max, 1).compute(
+                (box, points), points[:N // 2], neighbors=cnlist)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -228,6 +228,32 @@ class TestNeighborList(unittest.TestCase):
         npt.assert_equal(nlist.segments, nlist2.segments)
         npt.assert_equal(nlist.neighbor_counts, nlist2.neighbor_counts)
 
+    def test_vectors(self):
+        self.assertIsNone(self.nlist.vectors)
+        points = self.nq.points
+        nlist = self.nq.query(points, self.query_args).toNeighborList(
+            vectors=True)
+        npt.assert_equal(nlist[:], self.nlist[:])
+        vectors = self.nq.box.wrap(
+            points[nlist.point_indices] - points[nlist.query_point_indices])
+        npt.assert_allclose(nlist.vectors, vectors, atol=1e-6)
+        npt.assert_allclose(np.linalg.norm(nlist.vectors, axis=-1),
+                            nlist.distances, rtol=1e-5)
+
+        # Vectors are kept when copying and filtering.
+        npt.assert_equal(nlist.copy().vectors, nlist.vectors)
+        filt = nlist.distances < 2
+        nlist.filter(filt)
+        npt.assert_allclose(nlist.vectors, vectors[filt], atol=1e-6)
+
+        # Computes give the same results with stored vectors.
+        hex_order = freud.order.Hexatic(k=6)
+        psi = hex_order.compute(self.nq, neighbors=self.nlist).particle_order
+        npt.assert_allclose(
+            hex_order.compute(self.nq, neighbors=self.nq.query(
+                points, self.query_args).toNeighborList(
+                    vectors=True)).particle_order, psi, atol=1e-6)
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,108 @@
+import numpy as np
+import numpy.testing as npt
+import freud
+import unittest
+
+
+class TestNeighborListCache(unittest.TestCase):
+    def assert_nlist_equal(self, nlist1, nlist2):
+        npt.assert_array_equal(nlist1[:], nlist2[:])
+        npt.assert_allclose(nlist1.distances, nlist2.distances, rtol=1e-5)
+
+    def test_get(self):
+        L, N, r_max = (10, 500, 1.5)
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        _, query_points = freud.data.make_random_system(L, N // 5, seed=1)
+        aq = freud.locality.AABBQuery(box, points)
+
+        cache = freud.locality.NeighborListCache()
+        nlist = cache.get(aq, dict(r_max=r_max))
+        self.assert_nlist_equal(nlist, aq.query(
+            points, dict(r_max=r_max, exclude_ii=True)).toNeighborList())
+        self.assertEqual(cache.num_misses, 1)
+
+        # Equivalent query arguments share a list.
+        cache.get(aq, dict(mode='ball', r_max=r_max))
+        self.assertEqual(cache.num_hits, 1)
+        self.assertEqual(cache.num_entries, 1)
+
+        # Copies of the same query points share a list.
+        nlist = cache.get(aq, dict(r_max=r_max), query_points)
+        cache.get(aq, dict(r_max=r_max), query_points.copy())
+        self.assertEqual(cache.num_hits, 2)
+        self.assert_nlist_equal(nlist, aq.query(
+            query_points, dict(r_max=r_max)).toNeighborList())
+
+        cache.get(aq, dict(num_neighbors=4))
+        self.assertEqual(cache.num_entries, 3)
+        cache.clear()
+        self.assertEqual(cache.num_entries, 0)
+        self.assertEqual(cache.memory_usage, 0)
+
+    def test_computes(self):
+        L, N, r_max = (10, 1000, 1.5)
+        box, points = freud.data.make_random_system(L, N, seed=2)
+        aq = freud.locality.AABBQuery(box, points)
+        query_args = dict(r_max=r_max)
+
+        ql = freud.order.Steinhardt(6).compute(aq, neighbors=query_args)
+        cl = freud.cluster.Cluster().compute(aq, neighbors=query_args)
+        with freud.locality.NeighborListCache() as cache:
+            cached_ql = freud.order.Steinhardt(6).compute(
+                aq, neighbors=query_args)
+            cached_cl = freud.cluster.Cluster().compute(
+                aq, neighbors=query_args)
+        self.assertEqual(cache.num_misses, 1)
+        self.assertEqual(cache.num_hits, 1)
+        npt.assert_allclose(cached_ql.particle_order, ql.particle_order,
+                            rtol=1e-5)
+        self.assertEqual(cached_cl.num_clusters, cl.num_clusters)
+
+        # The cache is only used while it is active.
+        freud.order.Steinhardt(6).compute(aq, neighbors=query_args)
+        self.assertEqual(cache.num_hits + cache.num_misses, 2)
+
+    def test_update_points(self):
+        L, N, r_max = (10, 500, 1.5)
+        box, points = freud.data.make_random_system(L, N, seed=3)
+        aq = freud.locality.AABBQuery(box, points)
+
+        cache = freud.locality.NeighborListCache()
+        cache.get(aq, dict(r_max=r_max))
+        points = box.wrap(points + 0.1).astype(np.float32)
+        aq.update_points(points)
+        nlist = cache.get(aq, dict(r_max=r_max))
+        self.assertEqual(cache.num_misses, 2)
+        self.assert_nlist_equal(nlist, aq.query(
+            points, dict(r_max=r_max, exclude_ii=True)).toNeighborList())
+
+    def test_eviction(self):
+        L, N = (10, 500)
+        box, points = freud.data.make_random_system(L, N, seed=4)
+        aq = freud.locality.AABBQuery(box, points)
+
+        cache = freud.locality.NeighborListCache()
+        nlist = cache.get(aq, dict(r_max=1.5))
+        num_bonds = len(nlist)
+        size = cache.memory_usage
+        cache.max_memory = size
+        self.assertEqual(cache.num_entries, 1)
+
+        # A list larger than the cache is not cached.
+        cache.get(aq, dict(r_max=1.6))
+        self.assertEqual(cache.num_entries, 1)
+
+        # A list that does not fit evicts the least recently used list.
+        cache.get(aq, dict(r_max=1.4))
+        self.assertEqual(cache.num_entries, 1)
+        cache.get(aq, dict(r_max=1.5))
+        self.assertEqual(cache.num_misses, 4)
+        self.assertLessEqual(cache.memory_usage, cache.max_memory)
+
+        # Lists remain valid after they are evicted.
+        cache.clear()
+        self.assertEqual(len(nlist), num_bonds)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -305,6 +305,62 @@ class NeighborQueryTest(object):
 
         self.assertEqual(ij1, ij2)
 
+    def test_symmetric_half(self):
+        L, r_max, N = (10, 2.01, 1024)
+
+        box, points = freud.data.make_random_system(L, N)
+        nq = self.build_query_object(box, points, r_max)
+        for exclude_ii in [False, True]:
+            query_args = dict(mode='ball', r_max=r_max, exclude_ii=exclude_ii)
+            nlist = nq.query(points, query_args).toNeighborList()
+
+            query_args['symmetric_half'] = True
+            half = nq.query(points, query_args)
+            ij_iter = {(x[0], x[1]) for x in half}
+            half_nlist = half.toNeighborList()
+            ij_half = set(zip(half_nlist.query_point_indices,
+                              half_nlist.point_indices))
+            self.assertEqual(ij_iter, ij_half)
+            self.assertTrue(all(i <= j for i, j in ij_half))
+            self.assertEqual(
+                ij_half, {(i, j) for i, j in nlist[:] if i <= j})
+
+            full_nlist = half.toNeighborList(mirror=True)
+            npt.assert_array_equal(full_nlist[:], nlist[:])
+            npt.assert_allclose(full_nlist.distances, nlist.distances,
+                                rtol=1e-5)
+
+        # Only ball queries of the points against themselves are supported
+        with self.assertRaises(RuntimeError):
+            list(nq.query(points, dict(num_neighbors=4,
+                                       symmetric_half=True)))
+        with self.assertRaises(RuntimeError):
+            list(nq.query(points[:N//2], dict(r_max=r_max,
+                                              symmetric_half=True)))
+        # Different query points are rejected even if there are as many of
+        # them as there are points.
+        _, other_points = freud.data.make_random_system(L, N, seed=1)
+        with self.assertRaises(RuntimeError):
+            list(nq.query(other_points, dict(r_max=r_max,
+                                             symmetric_half=True)))
+        with self.assertRaises(RuntimeError):
+            nq.query(other_points, dict(
+                r_max=r_max, symmetric_half=True)).toNeighborList()
+        # Equal query points in another array are the points themselves.
+        half = nq.query(points.astype(np.float64),
+                        dict(r_max=r_max, symmetric_half=True))
+        npt.assert_array_equal(
+            half.toNeighborList()[:],
+            nq.query(points, dict(r_max=r_max,
+                                  symmetric_half=True)).toNeighborList()[:])
+
+        # The argument survives a round trip through the repr
+        qargs = freud.locality._QueryArgs(mode='ball', r_max=r_max,
+                                          symmetric_half=True)
+        qargs = eval(repr(qargs))
+        self.assertTrue(qargs.symmetric_half)
+        self.assertEqual(qargs.mode, 'ball')
+
     def test_exhaustive_search(self):
         L, r_max, N = (10, 1.999, 32)
 
@@ -387,6 +443,37 @@ class NeighborQueryTest(object):
                     seed, i))
                 raise
 
+    def test_exhaustive_search_nearest(self):
+        """Ensure that nearest neighbor queries find the minimum image
+        distances, even when neighbors are beyond half of the box."""
+        L, N, k = (6, 40, 30)
+        box = freud.box.Box.cube(L)
+        np.random.seed(0)
+        # A dense cluster and a sparse background give very different
+        # neighbor distances.
+        points = np.concatenate([
+            np.random.normal(scale=0.3, size=(N//2, 3)),
+            np.random.uniform(-L/2, L/2, size=(N//2, 3))])
+        points = box.wrap(points).astype(np.float32)
+
+        all_vectors = points[np.newaxis, :, :] - points[:, np.newaxis, :]
+        all_vectors = box.wrap(
+            all_vectors.reshape((-1, 3))).reshape(all_vectors.shape)
+        all_distances = np.linalg.norm(all_vectors, axis=-1)
+
+        nq = self.build_query_object(box, points, 1)
+        for r_min in [0, 1]:
+            nlist = nq.query(
+                points, dict(num_neighbors=k, exclude_ii=True,
+                             r_min=r_min)).toNeighborList()
+            self.assertEqual(len(set(zip(*nlist[:].T))), len(nlist))
+            for i in range(N):
+                distances = np.delete(all_distances[i], i)
+                expected = np.sort(distances[distances >= r_min])[:k]
+                npt.assert_allclose(
+                    nlist.distances[nlist.query_point_indices == i],
+                    expected, rtol=1e-5)
+
     def test_attributes(self):
         """Ensure that mixing old and new APIs throws an error"""
         L = 10
@@ -583,6 +670,107 @@ class TestNeighborQueryAABB(NeighborQueryTest, unittest.TestCase):
                 else:
                     original_nlist = nlist
 
+    def test_update_points(self):
+        """Ensure that refit or rebuilt trees find the same neighbors as new
+        trees."""
+        np.random.seed(0)
+        N = 1000
+        L = 10
+        r_max = 1.5
+        box, points = freud.data.make_random_system(L, N)
+        aq = freud.locality.AABBQuery(box, points)
+
+        # Small displacements refit the tree, while large displacements
+        # rebuild it.
+        for displacement in [0.01, 0.05, 0.5, L]:
+            points = box.wrap(points + np.random.uniform(
+                -displacement, displacement, size=points.shape))
+            aq.update_points(points)
+            npt.assert_allclose(aq.points, points)
+            for query_args in [dict(r_max=r_max, exclude_ii=True),
+                               dict(num_neighbors=6, exclude_ii=True)]:
+                nlist1 = aq.query(points, query_args).toNeighborList()
+                nlist2 = freud.locality.AABBQuery(box, points).query(
+                    points, query_args).toNeighborList()
+                self.assertTrue(nlist_equal(nlist1, nlist2))
+
+        with self.assertRaises(ValueError):
+            aq.update_points(points[:N//2])
+
+    def test_leaf_kernel(self):
+        """Ensure that the leaf distance kernels match the scalar distances.
+
+        Builds with ``--SIMD`` check whole leaves at once with vectorized
+        kernels, so this compares them against the scalar LinkCell path and
+        against distances computed by numpy, including neighbors exactly at
+        r_min and r_max."""
+        # Integer lattice positions have exact squared distances, so the
+        # neighbors on the cutoffs are found deterministically.
+        L = 8
+        box = freud.box.Box.cube(L)
+        points = np.array(list(itertools.product(range(L), repeat=3)),
+                          dtype=np.float32)
+        points = box.wrap(points + 0.5 - L/2)
+        all_vectors = box.wrap(
+            (points[np.newaxis, :, :] - points[:, np.newaxis, :]).reshape(
+                (-1, 3))).reshape((len(points), len(points), 3))
+        all_rsqs = np.sum(all_vectors**2, axis=-1)
+
+        aq = freud.locality.AABBQuery(box, points)
+        lc = freud.locality.LinkCell(box, points, 1)
+        for r_min, r_max in [(0, 1), (0, 2), (1, 2), (np.sqrt(2), 3)]:
+            query_args = dict(r_min=r_min, r_max=r_max, exclude_ii=True)
+            nlist = aq.query(points, query_args).toNeighborList()
+            self.assertTrue(nlist_equal(
+                nlist, lc.query(points, query_args).toNeighborList()))
+
+            rsqs = all_rsqs[nlist.query_point_indices,
+                            nlist.point_indices]
+            npt.assert_allclose(nlist.distances**2, rsqs, rtol=1e-6)
+            self.assertEqual(len(nlist), np.sum(np.logical_and(
+                all_rsqs >= np.float32(r_min)**2,
+                all_rsqs < np.float32(r_max)**2) & (all_rsqs > 0)))
+
+        # Random positions fill the leaves with particles at arbitrary
+        # distances.
+        box, points = freud.data.make_random_system(10, 2000, seed=0)
+        query_points = box.wrap(np.random.RandomState(1).uniform(
+            -5, 5, size=(500, 3)).astype(np.float32))
+        aq = freud.locality.AABBQuery(box, points)
+        lc = freud.locality.LinkCell(box, points, 1.5)
+        query_args = dict(r_min=0.5, r_max=1.5)
+        nlist1 = aq.query(query_points, query_args).toNeighborList()
+        nlist2 = lc.query(query_points, query_args).toNeighborList()
+        self.assertTrue(nlist_equal(nlist1, nlist2))
+        order1 = np.lexsort((nlist1.point_indices,
+                             nlist1.query_point_indices))
+        order2 = np.lexsort((nlist2.point_indices,
+                             nlist2.query_point_indices))
+        npt.assert_allclose(nlist1.distances[order1],
+                            nlist2.distances[order2], rtol=1e-5)
+
+
+class TestNeighborQueryAABBLBVH(NeighborQueryTest, unittest.TestCase):
+    @classmethod
+    def build_query_object(cls, box, ref_points, r_max=None):
+        return freud.locality.AABBQuery(box, ref_points, lbvh=True)
+
+    def test_lbvh(self):
+        """Ensure that LBVH and default trees find the same neighbors."""
+        N = 5000
+        L = 10
+        r_max = 1.2
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        aq1 = freud.locality.AABBQuery(box, points)
+        aq2 = freud.locality.AABBQuery(box, points, lbvh=True)
+        self.assertFalse(aq1.lbvh)
+        self.assertTrue(aq2.lbvh)
+        for query_args in [dict(r_max=r_max, exclude_ii=True),
+                           dict(num_neighbors=6, exclude_ii=True)]:
+            nlist1 = aq1.query(points, query_args).toNeighborList()
+            nlist2 = aq2.query(points, query_args).toNeighborList()
+            npt.assert_array_equal(nlist1[:], nlist2[:])
+
 
 class TestNeighborQueryLinkCell(NeighborQueryTest, unittest.TestCase):
     @classmethod
@@ -616,6 +804,118 @@ class TestNeighborQueryLinkCell(NeighborQueryTest, unittest.TestCase):
                                        exclude_ii=True)).toNeighborList()
         self.assertTrue(nlist_equal(nlist1, nlist2))
 
+    def test_nondeterministic(self):
+        """Check that nondeterministic cell ordering finds the same
+        neighbors."""
+        N = 2000
+        L = 10
+        r_max = 1
+        box, points = freud.data.make_random_system(L, N)
+        lc1 = freud.locality.LinkCell(box, points, 1.0)
+        lc2 = freud.locality.LinkCell(box, points, 1.0, deterministic=False)
+        self.assertTrue(lc1.deterministic)
+        self.assertFalse(lc2.deterministic)
+        nlist1 = lc1.query(points, dict(r_max=r_max,
+                                        exclude_ii=True)).toNeighborList()
+        nlist2 = lc2.query(points, dict(r_max=r_max,
+                                        exclude_ii=True)).toNeighborList()
+        self.assertTrue(nlist_equal(nlist1, nlist2))
+
+    def test_many_r_max(self):
+        """Check that queries with many different r_max values, which share
+        cached cell stencils, find the correct neighbors."""
+        N = 500
+        L = 10
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        lc = freud.locality.LinkCell(box, points, 1.0)
+        aq = freud.locality.AABBQuery(box, points)
+        for r_max in np.linspace(0.1, 4.9, 25):
+            for query_args in [dict(r_max=r_max, exclude_ii=True),
+                               dict(num_neighbors=4, r_max=r_max,
+                                    exclude_ii=True)]:
+                nlist1 = lc.query(points, query_args).toNeighborList()
+                nlist2 = aq.query(points, query_args).toNeighborList()
+                self.assertTrue(nlist_equal(nlist1, nlist2))
+
+
+class TestNeighborQueryKDTree(NeighborQueryTest, unittest.TestCase):
+    @classmethod
+    def build_query_object(cls, box, ref_points, r_max=None):
+        return freud.locality.KDTree(box, ref_points)
+
+    def test_throws(self):
+        """Test that specifying too large an r_max value throws an error"""
+        L = 5
+
+        box = freud.box.Box.square(L)
+        points = [[0, 0, 0], [1, 1, 0], [1, -1, 0]]
+        kd = freud.locality.KDTree(box, points)
+        with self.assertRaises(RuntimeError):
+            list(kd.query(points, dict(r_max=L)))
+
+    def test_tree_size(self):
+        """Check the number of nodes and depth of the tree."""
+        L = 10
+        for N, depth in [(1, 0), (16, 0), (17, 1), (1000, 6)]:
+            box, points = freud.data.make_random_system(L, N, seed=0)
+            kd = freud.locality.KDTree(box, points)
+            self.assertEqual(kd.depth, depth)
+            self.assertEqual(kd.num_nodes, 2**(depth + 1) - 1)
+
+    def test_inhomogeneous_triclinic(self):
+        """Ensure that KDTree and AABBQuery find the same neighbors in an
+        inhomogeneous system in a triclinic box."""
+        np.random.seed(0)
+        N = 4000
+        box = freud.box.Box(12, 10, 14, 0.4, -0.2, 0.3)
+        # Half of the points form a dense slab, the other half a dilute gas.
+        fractions = np.random.rand(N, 3)
+        fractions[:N//2, 2] = 0.45 + 0.1 * fractions[:N//2, 2]
+        points = box.make_absolute(fractions)
+        # Points outside of the box are wrapped by the tree.
+        points[::7] += box.to_matrix()[:, 0]
+        wrapped_points = box.wrap(points)
+        kd = freud.locality.KDTree(box, points)
+        aq = freud.locality.AABBQuery(box, wrapped_points)
+        for query_args in [dict(r_max=1.2, exclude_ii=True),
+                           dict(r_max=2.0, r_min=0.5),
+                           dict(num_neighbors=8, exclude_ii=True),
+                           dict(num_neighbors=8, r_min=0.5)]:
+            nlist1 = kd.query(points, query_args).toNeighborList()
+            nlist2 = aq.query(wrapped_points, query_args).toNeighborList()
+            npt.assert_array_equal(nlist1[:], nlist2[:])
+            npt.assert_allclose(nlist1.distances, nlist2.distances,
+                                rtol=1e-5)
+
+
+class TestNeighborQueryRawPoints(NeighborQueryTest, unittest.TestCase):
+    @classmethod
+    def build_query_object(cls, box, ref_points, r_max=None):
+        return freud.locality._RawPoints(box, ref_points)
+
+    def test_backend_selection(self):
+        """Ensure that automatically selected backends find the same neighbors
+        as AABBQuery in homogeneous and inhomogeneous systems."""
+        np.random.seed(0)
+        N = 4000
+        L = 16
+        box = freud.box.Box.cube(L)
+        uniform = np.random.uniform(-L/2, L/2, size=(N, 3))
+        slab = uniform * [1, 1, 0.1]
+        for points in [uniform, slab]:
+            raw = freud.locality._RawPoints(box, points)
+            aq = freud.locality.AABBQuery(box, points)
+            # Small cutoffs in homogeneous systems are answered by a LinkCell,
+            # everything else by a KDTree.
+            for query_args in [dict(r_max=0.6, exclude_ii=True),
+                               dict(r_max=2.0, exclude_ii=True),
+                               dict(r_max=0.6, exclude_ii=True,
+                                    symmetric_half=True),
+                               dict(num_neighbors=6, exclude_ii=True)]:
+                nlist1 = raw.query(points, query_args).toNeighborList()
+                nlist2 = aq.query(points, query_args).toNeighborList()
+                npt.assert_array_equal(nlist1[:], nlist2[:])
+
 
 class TestMultipleMethods(unittest.TestCase):
     """Check that different methods of making a NeighborList give the same
@@ -0,0 +1,120 @@
+import numpy as np
+import numpy.testing as npt
+import freud
+import unittest
+
+
+class TestSpatialSort(unittest.TestCase):
+    def test_order(self):
+        L, N = (10, 1000)
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        sorter = freud.locality.SpatialSort(box, points)
+        npt.assert_equal(np.sort(sorter.order), np.arange(N))
+        npt.assert_equal(sorter.order[sorter.inverse_order], np.arange(N))
+
+        # Consecutive sorted points are much closer than random ones.
+        def mean_step(p):
+            return np.mean(np.linalg.norm(
+                box.wrap(p[1:] - p[:-1]), axis=-1))
+        sorted_points = sorter.sort(points)
+        self.assertLess(mean_step(sorted_points), mean_step(points) / 4)
+
+        npt.assert_equal(sorter.unsort(sorted_points), points)
+        npt.assert_equal(sorter.unsort(sorter.sort(np.arange(N))),
+                         np.arange(N))
+        with self.assertRaises(ValueError):
+            sorter.sort(points[:-1])
+
+    def test_neighbor_query(self):
+        L, N = (10, 1000)
+        box, points = freud.data.make_random_system(L, N, seed=1)
+        query_args = dict(num_neighbors=6, exclude_ii=True)
+        ql = freud.order.Steinhardt(6).compute(
+            (box, points), neighbors=query_args).particle_order
+
+        for nq_class in (freud.locality.AABBQuery,
+                         freud.locality.LinkCell,
+                         freud.locality.KDTree):
+            nq = nq_class(box, points)
+            self.assertIsNone(nq.spatial_sort)
+            nq = nq_class(box, points, spatial_sort=True)
+            self.assertIsNotNone(nq.spatial_sort)
+
+            # The reordering is internal: the points, query results and
+            # per-point outputs are in the original order.
+            npt.assert_equal(nq.points, points)
+            npt.assert_equal(
+                nq.query(points, query_args).toNeighborList()[:],
+                freud.locality.AABBQuery(box, points).query(
+                    points, query_args).toNeighborList()[:])
+            sorted_ql = freud.order.Steinhardt(6).compute(
+                nq, neighbors=query_args).particle_order
+            npt.assert_allclose(sorted_ql, ql, rtol=1e-5, atol=1e-6)
+
+    def test_computes(self):
+        L, N, r_max = (10, 1000, 2.0)
+        box, points = freud.data.make_random_system(L, N, is2D=True, seed=3)
+        _, query_points = freud.data.make_random_system(
+            L, N // 4, is2D=True, seed=4)
+        np.random.seed(5)
+        orientations = np.random.rand(N) * 2 * np.pi
+        query_orientations = np.random.rand(N // 4) * 2 * np.pi
+        sorted_aq = freud.locality.AABBQuery(box, points, spatial_sort=True)
+
+        def compare(compute, attrs, *args, **kwargs):
+            results = [compute().compute(system, *args, **kwargs)
+                       for system in ((box, points), sorted_aq)]
+            for attr in attrs:
+                npt.assert_allclose(getattr(results[1], attr),
+                                    getattr(results[0], attr),
+                                    rtol=1e-5, atol=1e-5)
+
+        # Computes that visit the points in the sorted order.
+        for qp in [None, query_points]:
+            compare(lambda: freud.density.LocalDensity(r_max, 1),
+                    ['density', 'num_neighbors'], qp)
+            compare(lambda: freud.density.RDF(20, r_max), ['bin_counts'], qp)
+            qo = query_orientations if qp is not None else None
+            compare(lambda: freud.pmft.PMFTXY(r_max, r_max, 20),
+                    ['bin_counts'], orientations if qp is None else qo, qp)
+            compare(lambda: freud.pmft.PMFTR12(r_max, 10),
+                    ['bin_counts'], orientations, qp, qo)
+        compare(lambda: freud.order.Hexatic(6), ['particle_order'])
+
+        # Computes that use the points in their original order.
+        compare(lambda: freud.cluster.Cluster(), ['cluster_idx'],
+                neighbors=dict(r_max=1.0))
+        compare(lambda: freud.order.SolidLiquid(6, 0.7, 6),
+                ['cluster_idx', 'ql_ij'], neighbors=dict(r_max=r_max))
+
+    def test_neighbor_list(self):
+        # Computes given a NeighborList use the original order, in which its
+        # indices are defined.
+        L, N = (10, 1000)
+        box, points = freud.data.make_random_system(L, N, seed=6)
+        query_args = dict(num_neighbors=6, exclude_ii=True)
+        aq = freud.locality.AABBQuery(box, points)
+        sorted_aq = freud.locality.AABBQuery(box, points, spatial_sort=True)
+        nlist = aq.query(points, query_args).toNeighborList()
+        ql = freud.order.Steinhardt(6).compute(
+            aq, neighbors=nlist).particle_order
+        sorted_ql = freud.order.Steinhardt(6).compute(
+            sorted_aq, neighbors=nlist).particle_order
+        npt.assert_allclose(sorted_ql, ql, rtol=1e-5, atol=1e-6)
+
+    def test_update_points(self):
+        L, N = (10, 500)
+        box, points = freud.data.make_random_system(L, N, seed=2)
+        aq = freud.locality.AABBQuery(box, points, spatial_sort=True)
+        new_points = box.wrap(points + 0.05).astype(np.float32)
+        aq.update_points(new_points)
+        npt.assert_equal(aq.points, new_points)
+        ld = freud.density.LocalDensity(1.5, 1)
+        npt.assert_equal(
+            ld.compute(aq).num_neighbors,
+            freud.density.LocalDensity(1.5, 1).compute(
+                (box, new_points)).num_neighbors)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,138 @@
+import numpy as np
+import numpy.testing as npt
+import freud
+import unittest
+
+
+class TestVerletList(unittest.TestCase):
+    def assert_nlist_equal(self, nlist1, nlist2):
+        npt.assert_array_equal(nlist1[:], nlist2[:])
+        npt.assert_allclose(nlist1.distances, nlist2.distances, rtol=1e-5)
+
+    def test_trajectory(self):
+        L, N, r_max, skin = (10, 1000, 1.5, 0.4)
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        np.random.seed(0)
+
+        vl = freud.locality.VerletList(skin)
+        query_args = dict(r_max=r_max)
+        for frame in range(20):
+            points = box.wrap(
+                points + np.random.uniform(-0.03, 0.03, size=points.shape))
+            points = points.astype(np.float32)
+            vl.compute((box, points), query_args)
+            if frame == 0:
+                self.assertTrue(vl.rebuilt)
+
+            aq = freud.locality.AABBQuery(box, points)
+            nlist = aq.query(
+                points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+            self.assert_nlist_equal(vl.nlist, nlist)
+
+        # Points diffuse slowly, so the candidate bonds only need to be
+        # rebuilt every few frames.
+        self.assertGreater(vl.num_builds, 1)
+        self.assertLess(vl.num_builds, 20)
+
+    def test_query_points(self):
+        L, N, r_max, skin = (10, 500, 1.5, 0.4)
+        box, points = freud.data.make_random_system(L, N, seed=1)
+        _, query_points = freud.data.make_random_system(L, N // 5, seed=2)
+        np.random.seed(1)
+
+        vl = freud.locality.VerletList(skin)
+        query_args = dict(r_max=r_max, r_min=0.5)
+        for frame in range(5):
+            points = box.wrap(
+                points + np.random.uniform(-0.05, 0.05, size=points.shape))
+            points = points.astype(np.float32)
+            vl.compute((box, points), query_args, query_points)
+
+            aq = freud.locality.AABBQuery(box, points)
+            nlist = aq.query(
+                query_points, dict(r_max=r_max, r_min=0.5)).toNeighborList()
+            self.assert_nlist_equal(vl.nlist, nlist)
+
+    def test_rebuild_on_change(self):
+        L, N, r_max, skin = (10, 500, 1.5, 0.4)
+        box, points = freud.data.make_random_system(L, N, seed=3)
+
+        vl = freud.locality.VerletList(skin)
+        vl.compute((box, points), dict(r_max=r_max))
+        self.assertEqual(vl.num_builds, 1)
+        vl.compute((box, points), dict(r_max=r_max))
+        self.assertFalse(vl.rebuilt)
+        self.assertEqual(vl.num_builds, 1)
+
+        # Changing the query arguments requires a rebuild
+        vl.compute((box, points), dict(r_max=r_max + 0.1))
+        self.assertTrue(vl.rebuilt)
+
+        # Changing the box requires a rebuild
+        box2 = freud.box.Box.cube(L + 0.1)
+        vl.compute((box2, points), dict(r_max=r_max + 0.1))
+        self.assertTrue(vl.rebuilt)
+        self.assertEqual(vl.num_builds, 3)
+
+    def test_neighbors_argument(self):
+        L, N, r_max, skin = (10, 1000, 2, 0.3)
+        box, points = freud.data.make_random_system(L, N, seed=4)
+
+        vl = freud.locality.VerletList(skin)
+        vl.compute((box, points), dict(r_max=r_max))
+
+        rdf1 = freud.density.RDF(20, r_max)
+        rdf1.compute((box, points), neighbors=vl.nlist)
+        rdf2 = freud.density.RDF(20, r_max)
+        rdf2.compute((box, points), neighbors=dict(r_max=r_max))
+        npt.assert_allclose(rdf1.rdf, rdf2.rdf, rtol=1e-5)
+
+    def test_box_limit(self):
+        """Ensure that the skin is reduced when r_max + skin does not fit in
+        the box."""
+        L, N, r_max, skin = (4, 200, 1.9, 0.4)
+        box, points = freud.data.make_random_system(L, N, seed=5)
+        np.random.seed(5)
+
+        vl = freud.locality.VerletList(skin)
+        for frame in range(5):
+            points = box.wrap(
+                points + np.random.uniform(-0.01, 0.01, size=points.shape))
+            points = points.astype(np.float32)
+            vl.compute((box, points), dict(r_max=r_max))
+
+            aq = freud.locality.AABBQuery(box, points)
+            nlist = aq.query(
+                points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+            self.assert_nlist_equal(vl.nlist, nlist)
+            self.assertEqual(vl.skin, np.float32(skin))
+            self.assertGreater(vl.effective_skin, 0)
+            self.assertLess(vl.effective_skin, L/2 - r_max)
+
+        # The full skin is used when it fits in the box.
+        vl.compute((box, points), dict(r_max=1))
+        self.assertAlmostEqual(vl.effective_skin, skin, places=6)
+
+        # An r_max that is too large for the box is still an error.
+        with self.assertRaises(RuntimeError):
+            vl.compute(freud.locality.AABBQuery(box, points),
+                       dict(r_max=L/2))
+
+    def test_invalid(self):
+        L, N = (10, 100)
+        box, points = freud.data.make_random_system(L, N)
+        with self.assertRaises(ValueError):
+            freud.locality.VerletList(-1)
+        vl = freud.locality.VerletList(0.3)
+        with self.assertRaises(RuntimeError):
+            vl.compute((box, points), dict(num_neighbors=4))
+        with self.assertRaises(ValueError):
+            vl.compute((box, points), vl)
+
+    def test_repr(self):
+        vl = freud.locality.VerletList(0.5)
+        self.assertEqual(str(vl), str(eval(repr(vl))))
+
+
+if __name__ == '__main__':
+    unittest.main()
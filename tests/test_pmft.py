@@ -182,6 +182,31 @@ class TestPMFTR12(unittest.TestCase):
             self.assertEqual(len(np.unique(pmft.pmft)), 3)
 
 
+    def test_compute_frames(self):
+        L, N = (10, 500)
+        frames = [freud.data.make_random_system(L + i, N, is2D=True, seed=i)
+                  for i in range(3)]
+        _, query_points = freud.data.make_random_system(
+            L, N//2, is2D=True, seed=3)
+        np.random.seed(0)
+        angles = [np.random.rand(N)*2*np.pi for _ in frames]
+        query_angles = [np.random.rand(N//2)*2*np.pi for _ in frames]
+
+        for qp, qa in [(None, None), (query_points, query_angles)]:
+            frame_query_points = None if qp is None else [qp]*len(frames)
+            pmft = freud.pmft.PMFTR12(2.5, (10, 8, 8))
+            for i, system in enumerate(frames):
+                pmft.compute(system, angles[i], qp,
+                             None if qa is None else qa[i], reset=False)
+            pmft_frames = freud.pmft.PMFTR12(2.5, (10, 8, 8))
+            pmft_frames.compute_frames(frames, angles, frame_query_points, qa)
+            npt.assert_array_equal(pmft_frames.bin_counts, pmft.bin_counts)
+            npt.assert_allclose(pmft_frames.pmft, pmft.pmft, rtol=1e-6)
+
+        with self.assertRaises(ValueError):
+            pmft_frames.compute_frames(frames, angles[:1])
+
+
 class TestPMFTXYT(unittest.TestCase):
     def test_box(self):
         L = 16.0
@@ -369,6 +394,31 @@ class TestPMFTXYT(unittest.TestCase):
             self.assertEqual(len(np.unique(pmft.pmft)), 2)
 
 
+    def test_compute_frames(self):
+        L, N = (10, 500)
+        frames = [freud.data.make_random_system(L + i, N, is2D=True, seed=i)
+                  for i in range(3)]
+        _, query_points = freud.data.make_random_system(
+            L, N//2, is2D=True, seed=3)
+        np.random.seed(0)
+        angles = [np.random.rand(N)*2*np.pi for _ in frames]
+        query_angles = [np.random.rand(N//2)*2*np.pi for _ in frames]
+
+        for qp, qa in [(None, None), (query_points, query_angles)]:
+            frame_query_points = None if qp is None else [qp]*len(frames)
+            pmft = freud.pmft.PMFTXYT(2.5, 2.5, (20, 20, 8))
+            for i, system in enumerate(frames):
+                pmft.compute(system, angles[i], qp,
+                             None if qa is None else qa[i], reset=False)
+            pmft_frames = freud.pmft.PMFTXYT(2.5, 2.5, (20, 20, 8))
+            pmft_frames.compute_frames(frames, angles, frame_query_points, qa)
+            npt.assert_array_equal(pmft_frames.bin_counts, pmft.bin_counts)
+            npt.assert_allclose(pmft_frames.pmft, pmft.pmft, rtol=1e-6)
+
+        with self.assertRaises(ValueError):
+            pmft_frames.compute_frames(frames, angles[:1])
+
+
 class TestPMFTXY(unittest.TestCase):
     def test_box(self):
         L = 16.0
@@ -545,6 +595,77 @@ class TestPMFTXY(unittest.TestCase):
             self.assertEqual(np.count_nonzero(np.isinf(pmft.pmft) == 0), 12)
             self.assertEqual(len(np.unique(pmft.pmft)), 2)
 
+    def test_compute_frames(self):
+        L, N = (10, 500)
+        frames = [freud.data.make_random_system(L + i, N, is2D=True, seed=i)
+                  for i in range(3)]
+        np.random.seed(0)
+        angles = [np.random.rand(N)*2*np.pi for _ in frames]
+
+        pmft = freud.pmft.PMFTXY(2.5, 2.5, (30, 40))
+        for system, query_angles in zip(frames, angles):
+            pmft.compute(system, query_angles, reset=False)
+        pmft_frames = freud.pmft.PMFTXY(2.5, 2.5, (30, 40)).compute_frames(
+            frames, angles)
+        npt.assert_array_equal(pmft_frames.bin_counts, pmft.bin_counts)
+        npt.assert_allclose(pmft_frames.pmft, pmft.pmft, rtol=1e-6)
+
+        single_pmft = freud.pmft.PMFTXY(2.5, 2.5, (30, 40)).compute(
+            frames[0], angles[0])
+        pmft_frames.compute_frames(frames[:1], angles[:1])
+        npt.assert_array_equal(pmft_frames.bin_counts, single_pmft.bin_counts)
+
+        # A frame with a 3D box raises an error after the frames before it
+        # have been accumulated.
+        box_3d, points_3d = freud.data.make_random_system(L, N, seed=3)
+        with self.assertRaises(ValueError):
+            pmft_frames.compute_frames(
+                [frames[0], (box_3d, points_3d), frames[1]], angles)
+        npt.assert_array_equal(pmft_frames.bin_counts, single_pmft.bin_counts)
+
+        with self.assertRaises(ValueError):
+            pmft_frames.compute_frames(frames, angles[:1])
+
+    def test_accumulation_strategy(self):
+        L, N = (10, 1000)
+        box, points = freud.data.make_random_system(L, N, is2D=True, seed=0)
+        np.random.seed(0)
+        angles = np.random.rand(N)*2*np.pi
+
+        def make_pmft(strategy):
+            pmft = freud.pmft.PMFTXY(2.5, 2.5, (40, 50))
+            pmft.accumulation_strategy = strategy
+            self.assertEqual(pmft.accumulation_strategy, strategy)
+            return pmft
+
+        pmft = make_pmft('local_copies')
+        pmft.compute((box, points), angles)
+        local_bin_counts = pmft.bin_counts
+        self.assertGreater(np.sum(local_bin_counts), 0)
+
+        for strategy in ['shared_atomic', 'automatic']:
+            pmft = make_pmft(strategy)
+            pmft.compute((box, points), angles)
+            npt.assert_array_equal(pmft.bin_counts, local_bin_counts)
+
+        # The counts of frames accumulated with different strategies are
+        # combined.
+        pmft = make_pmft('shared_atomic')
+        pmft.compute((box, points), angles, reset=False)
+        pmft.accumulation_strategy = 'local_copies'
+        pmft.compute((box, points), angles, reset=False)
+        npt.assert_array_equal(pmft.bin_counts, 2*local_bin_counts)
+        pmft.accumulation_strategy = 'shared_atomic'
+        pmft.compute((box, points), angles, reset=False)
+        npt.assert_array_equal(pmft.bin_counts, 3*local_bin_counts)
+        npt.assert_allclose(pmft.pmft, make_pmft('local_copies').compute(
+            (box, points), angles).pmft, rtol=1e-5)
+        pmft.compute((box, points), angles)
+        npt.assert_array_equal(pmft.bin_counts, local_bin_counts)
+
+        with self.assertRaises(ValueError):
+            pmft.accumulation_strategy = 'tiled'
+
     def test_query_args_nn(self):
         """Test that using nn based query args works."""
         L = 8
@@ -948,6 +1069,35 @@ class TestPMFTXYZ(unittest.TestCase):
                                     (nbins_x, nbins_y, nbins_z))
         self.assertEqual(str(myPMFT), str(eval(repr(myPMFT))))
 
+    def test_compute_frames(self):
+        L, N = (10, 500)
+        frames = [freud.data.make_random_system(L + i, N, seed=i)
+                  for i in range(3)]
+        _, query_points = freud.data.make_random_system(L, N//2, seed=3)
+        orientations = [rowan.random.rand(N) for _ in frames]
+        query_orientations = [rowan.random.rand(N//2) for _ in frames]
+        equiv_orientations = np.array([[1, 0, 0, 0], [0, 0, 0, 1]])
+        args = (1.5, 2, 2.5, (10, 12, 14))
+
+        for qp, qo in [(None, orientations),
+                       (query_points, query_orientations)]:
+            frame_query_points = None if qp is None else [qp]*len(frames)
+            # The shift must be applied to the query points of every frame.
+            for shiftvec in [[0, 0, 0], [0.5, -0.25, 0.1]]:
+                pmft = freud.pmft.PMFTXYZ(*args, shiftvec=shiftvec)
+                for system, frame_qo in zip(frames, qo):
+                    pmft.compute(system, frame_qo, qp, equiv_orientations,
+                                 reset=False)
+                pmft_frames = freud.pmft.PMFTXYZ(
+                    *args, shiftvec=shiftvec).compute_frames(
+                        frames, qo, frame_query_points, equiv_orientations)
+                npt.assert_array_equal(
+                    pmft_frames.bin_counts, pmft.bin_counts)
+                npt.assert_allclose(pmft_frames.pmft, pmft.pmft, rtol=1e-6)
+
+        with self.assertRaises(ValueError):
+            pmft_frames.compute_frames(frames, orientations[:1])
+
     def test_query_args_nn(self):
         """Test that using nn based query args works."""
         L = 8